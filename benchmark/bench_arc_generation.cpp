@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/generate.h"
+#include "trailblaze/math/angle.h"
+
+namespace {
+
+using trailblaze::span;
+using trailblaze::state_r2;
+
+struct ellipse {
+  double a{3.0};
+  double b{1.5};
+
+  state_r2 operator()(double t) const {
+    return {a * std::cos(t), b * std::sin(t)};
+  }
+};
+
+struct batch_ellipse : ellipse {
+  using ellipse::operator();
+
+  void operator()(span<const double> parameters, span<state_r2> out) const {
+    // sample_parametric_curve_r2 passes at most parametric_batch_size parameters.
+    std::array<double, trailblaze::gen::parametric_batch_size> sines{};
+    std::array<double, trailblaze::gen::parametric_batch_size> cosines{};
+    trailblaze::sincos(parameters, span<double>(sines.data(), parameters.size()),
+                       span<double>(cosines.data(), parameters.size()));
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+      out[i] = {a * cosines[i], b * sines[i]};
+    }
+  }
+};
+
+} // namespace
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t arc_count = 20000;
+  constexpr std::size_t samples_per_arc = 64;
+  constexpr std::size_t operations = arc_count * samples_per_arc;
+
+  std::cout << "Circle arcs, " << arc_count << " arcs x " << samples_per_arc << " samples\n";
+
+  const auto arc_angle = [](std::size_t arc) { return 0.001 * static_cast<double>(arc); };
+  const double exact_time = bench::best_of([&] {
+    double sum = 0.0;
+    for (std::size_t arc = 0; arc < arc_count; ++arc) {
+      const auto samples = gen::generate_circle_arc_r2({0.0, 0.0}, 2.0, arc_angle(arc), 1.2,
+                                                       sampling::by_count{samples_per_arc});
+      sum += samples.back().x;
+    }
+    bench::consume(sum);
+  });
+  bench::report("generate_circle_arc_r2, exact", exact_time, operations);
+
+  for (const std::size_t anchor_interval : {std::size_t(8), std::size_t(32)}) {
+    double max_error = 0.0;
+    const double recurrence_time = bench::best_of([&] {
+      double sum = 0.0;
+      for (std::size_t arc = 0; arc < arc_count; ++arc) {
+        const auto samples = gen::generate_circle_arc_r2(
+            {0.0, 0.0}, 2.0, arc_angle(arc), 1.2, sampling::by_count{samples_per_arc},
+            gen::trig_mode::recurrence, anchor_interval);
+        sum += samples.back().x;
+      }
+      bench::consume(sum);
+    });
+    for (std::size_t arc = 0; arc < arc_count; arc += 97) {
+      const auto exact = gen::generate_circle_arc_r2({0.0, 0.0}, 2.0, arc_angle(arc), 1.2,
+                                                     sampling::by_count{samples_per_arc});
+      const auto fast = gen::generate_circle_arc_r2({0.0, 0.0}, 2.0, arc_angle(arc), 1.2,
+                                                    sampling::by_count{samples_per_arc},
+                                                    gen::trig_mode::recurrence, anchor_interval);
+      for (std::size_t i = 0; i < exact.size(); ++i) {
+        max_error =
+            std::max(max_error, std::hypot(fast[i].x - exact[i].x, fast[i].y - exact[i].y));
+      }
+    }
+    bench::report("generate_circle_arc_r2, recurrence k=" + std::to_string(anchor_interval),
+                  recurrence_time, operations);
+    std::cout << "  max position error vs exact (radius 2): " << std::scientific << max_error
+              << std::fixed << '\n';
+  }
+
+  constexpr std::size_t curve_samples = 1000000;
+  const interval<double> range{0.0, 100.0};
+  const double scalar_time = bench::best_of([&] {
+    const auto samples =
+        gen::sample_parametric_curve_r2(ellipse{}, range, 100.0, sampling::by_count{curve_samples});
+    bench::consume(samples.back().x);
+  });
+  bench::report("sample_parametric_curve_r2, scalar curve", scalar_time, curve_samples);
+  const double batch_time = bench::best_of([&] {
+    const auto samples = gen::sample_parametric_curve_r2(batch_ellipse{}, range, 100.0,
+                                                         sampling::by_count{curve_samples});
+    bench::consume(samples.back().x);
+  });
+  bench::report("sample_parametric_curve_r2, batch sincos", batch_time, curve_samples);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/generate/batch.h"
+
+namespace {
+
+using trailblaze::state_r2;
+
+/// Cubic Bezier curve from the origin (heading along x) to an end pose.
+struct cubic_bezier {
+  state_r2 p1;
+  state_r2 p2;
+  state_r2 p3;
+
+  state_r2 operator()(double t) const {
+    const double u = 1.0 - t;
+    const double b1 = 3.0 * u * u * t;
+    const double b2 = 3.0 * u * t * t;
+    const double b3 = t * t * t;
+    return {b1 * p1.x + b2 * p2.x + b3 * p3.x, b1 * p1.y + b2 * p2.y + b3 * p3.y};
+  }
+};
+
+} // namespace
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t candidate_count = 20000;
+  constexpr std::size_t samples_per_candidate = 32;
+
+  // Endpoints on a fan of goal poses in front of the robot.
+  std::vector<gen::parametric_candidate<cubic_bezier>> candidates;
+  candidates.reserve(candidate_count);
+  for (std::size_t i = 0; i < candidate_count; ++i) {
+    const double angle = -1.0 + 2.0 * static_cast<double>(i) / candidate_count;
+    const double reach = 2.0 + static_cast<double>(i % 5);
+    const state_r2 end{reach * std::cos(angle), reach * std::sin(angle)};
+    const state_r2 p2{end.x - std::cos(2.0 * angle), end.y - std::sin(2.0 * angle)};
+    candidates.push_back({cubic_bezier{{1.0, 0.0}, p2, end},
+                          interval<double>{0.0, 1.0},
+                          sampling::by_count{samples_per_candidate}});
+  }
+  const span<const gen::parametric_candidate<cubic_bezier>> params(candidates);
+
+  std::cout << "Candidate generation, " << candidate_count << " cubic Bezier candidates x "
+            << samples_per_candidate << " samples, ops are candidates\n";
+
+  const double naive_time = bench::best_of([&] {
+    std::vector<std::vector<state_r2>> paths;
+    for (const auto& candidate : candidates) {
+      paths.push_back(gen::sample_parametric_curve_r2(candidate.curve, candidate.range, 1.0,
+                                                      candidate.sampling));
+    }
+    bench::consume(paths.back().back().x);
+  });
+  bench::report("naive loop, one vector per candidate", naive_time, candidate_count);
+
+  ragged_buffer<state_r2> out;
+  const double serial_time = bench::best_of([&] {
+    gen::generate_batch(gen::parametric_generator{}, params, out);
+    bench::consume(out.data().back().x);
+  });
+  bench::report("generate_batch, serial", serial_time, candidate_count);
+
+  thread_pool pool;
+  const double parallel_time = bench::best_of([&] {
+    gen::generate_batch(pool, gen::parametric_generator{}, params, out);
+    bench::consume(out.data().back().x);
+  });
+  bench::report("generate_batch, " + std::to_string(pool.size()) + " threads", parallel_time,
+                candidate_count);
+  return 0;
+}
@@ -0,0 +1,54 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace trailblaze::bench {
+
+/** Consumes a value so that the computation producing it is not optimized away.
+ *  @param value Any value that depends on the benchmarked computation.
+ */
+inline void consume(double value) {
+  static volatile double sink = 0.0;
+  sink = sink + value;
+}
+
+/** Runs a benchmark body several times and measures the fastest run.
+ *  @param body Callable without arguments that performs one full run.
+ *  @param repetitions The number of runs.
+ *  @returns the wall time of the fastest run, in seconds.
+ */
+template <typename Body>
+double best_of(Body&& body, int repetitions = 5) {
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < repetitions; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto stop = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(stop - start).count());
+  }
+  return best;
+}
+
+/** Prints one result line.
+ *  @param name Name of the benchmark case.
+ *  @param seconds Time for one run, see @ref best_of.
+ *  @param operations The number of operations in one run.
+ */
+inline void report(const std::string& name, double seconds, std::size_t operations) {
+  const double ops = static_cast<double>(operations);
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << seconds * 1e3 << " ms" << std::setw(10)
+            << seconds * 1e9 / ops << " ns/op" << std::setw(12) << ops / seconds * 1e-6
+            << " Mop/s\n";
+}
+
+} // namespace trailblaze::bench
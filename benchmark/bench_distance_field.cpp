@@ -0,0 +1,78 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/thread_pool.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t size = 4096;
+  constexpr std::size_t cell_count = size * size;
+
+  // Random boxes of obstacles.
+  env::bit_occupancy_grid grid(size, size, 0.05);
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 32);
+  std::uniform_int_distribution<std::int64_t> extent(1, 31);
+  for (int box = 0; box < 4000; ++box) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        grid.set({x, y}, true);
+      }
+    }
+  }
+
+  std::cout << "Distance transform, " << size << "x" << size << " grid, ops are cells\n";
+  const double serial_time = bench::best_of(
+      [&] {
+        const env::distance_field field(grid);
+        bench::consume(field.distance({17, 17}));
+      },
+      3);
+  bench::report("distance_field, serial", serial_time, cell_count);
+
+  thread_pool pool;
+  const double parallel_time = bench::best_of(
+      [&] {
+        const env::distance_field field(grid, pool);
+        bench::consume(field.distance({17, 17}));
+      },
+      3);
+  bench::report("distance_field, " + std::to_string(pool.size()) + " threads", parallel_time,
+                cell_count);
+
+  const env::distance_field field(grid, pool);
+  constexpr std::size_t state_count = 1000000;
+  std::uniform_real_distribution<double> position(0.0, size * 0.05);
+  std::vector<state_r2> states(state_count);
+  double x = 100.0;
+  double y = 100.0;
+  for (auto& state : states) {
+    // A random walk, like the states of many short paths.
+    x = std::fmod(x + 0.03 + 0.01 * std::sin(y), size * 0.05);
+    y = std::fmod(y + 0.02 + 0.01 * std::cos(x), size * 0.05);
+    state = {x, y};
+  }
+  std::vector<double> clearances(state_count);
+  const double lookup_time = bench::best_of([&] {
+    field.clearance(span<const state_r2>(states), span<double>(clearances));
+    bench::consume(clearances.back());
+  });
+  bench::report("bilinear clearance, span of states", lookup_time, state_count);
+  return 0;
+}
@@ -0,0 +1,91 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/environment/dynamic_distance_field.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::int64_t size = 2048;
+  constexpr std::int64_t box = 6;
+  constexpr int ticks = 100;
+
+  // Static random boxes.
+  env::bit_occupancy_grid grid(size, size, 0.05);
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 32);
+  std::uniform_int_distribution<std::int64_t> extent(1, 31);
+  for (int i = 0; i < 1000; ++i) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        grid.set({x, y}, true);
+      }
+    }
+  }
+
+  // A box shaped obstacle that moves one cell per tick.
+  const auto box_cells = [&](std::int64_t offset) {
+    std::vector<env::cell_index> cells;
+    for (std::int64_t y = 0; y < box; ++y) {
+      for (std::int64_t x = 0; x < box; ++x) {
+        const env::cell_index cell{1000 + offset + x, 1000 + y};
+        if (!grid.value(cell)) {
+          cells.push_back(cell);
+        }
+      }
+    }
+    return cells;
+  };
+
+  std::cout << std::fixed << std::setprecision(3) << "Moving " << box << "x" << box
+            << " obstacle on a " << size << "x" << size << " grid\n";
+
+  env::dynamic_distance_field dynamic(grid);
+  std::size_t processed = 0;
+  const double incremental_time = bench::best_of(
+      [&] {
+        for (int tick = 0; tick < ticks; ++tick) {
+          const auto previous = box_cells(tick);
+          const auto next = box_cells(tick + 1);
+          processed += dynamic.update(span<const env::cell_index>(next),
+                                      span<const env::cell_index>(previous));
+        }
+        // Back to the start for the next repetition.
+        dynamic.update(span<const env::cell_index>(box_cells(0)),
+                       span<const env::cell_index>(box_cells(ticks)));
+      },
+      3);
+  std::cout << "dynamic_distance_field::update      " << incremental_time * 1e3 / ticks
+            << " ms per tick, " << processed / (3 * ticks) << " processed cells per tick\n";
+
+  const double full_time = bench::best_of(
+      [&] {
+        for (int tick = 0; tick < 5; ++tick) {
+          for (const auto& cell : box_cells(tick)) {
+            grid.set(cell, false);
+          }
+          for (const auto& cell : box_cells(tick + 1)) {
+            grid.set(cell, true);
+          }
+          const env::distance_field field(grid);
+          bench::consume(field.distance({1000, 1000}));
+        }
+      },
+      1);
+  std::cout << "distance_field, full recompute      " << full_time * 1e3 / 5 << " ms per tick\n";
+  return 0;
+}
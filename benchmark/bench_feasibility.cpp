@@ -0,0 +1,136 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/kinematics/feasibility.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace {
+
+/// Straightforward check of the curvature limit, one state at a time.
+std::size_t first_too_curved(const std::vector<trailblaze::state_r2>& states,
+                             double max_curvature) {
+  for (std::size_t i = 1; i + 1 < states.size(); ++i) {
+    const auto& a = states[i - 1];
+    const auto& b = states[i];
+    const auto& c = states[i + 1];
+    const double heading_in = std::atan2(b.y - a.y, b.x - a.x);
+    const double heading_out = std::atan2(c.y - b.y, c.x - b.x);
+    const double turn = std::remainder(heading_out - heading_in, 2.0 * M_PI);
+    const double length =
+        0.5 * (std::hypot(b.x - a.x, b.y - a.y) + std::hypot(c.x - b.x, c.y - b.y));
+    if (std::abs(turn) / length > max_curvature) {
+      return i;
+    }
+  }
+  return states.size();
+}
+
+} // namespace
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t state_count = 4000000;
+  constexpr double step = 0.05;
+
+  // A feasible slalom of arcs with radii between 10 and 20 m, so every state is checked.
+  std::vector<state_r2> states(state_count);
+  std::vector<state_se2> poses(state_count);
+  std::vector<double> x(state_count);
+  std::vector<double> y(state_count);
+  std::vector<double> yaw(state_count);
+  state_se2 pose;
+  for (std::size_t i = 0; i < state_count; ++i) {
+    const double curvature = 0.075 * std::sin(static_cast<double>(i) * 1e-4) +
+                             (static_cast<double>(i / 50000 % 2) - 0.5) * 0.05;
+    poses[i] = pose;
+    states[i] = {pose.x, pose.y};
+    x[i] = pose.x;
+    y[i] = pose.y;
+    yaw[i] = pose.yaw;
+    pose.x += step * std::cos(pose.yaw + 0.5 * step * curvature);
+    pose.y += step * std::sin(pose.yaw + 0.5 * step * curvature);
+    pose.yaw += step * curvature;
+  }
+  kinematic_model model = ackermann_model(2.5, 0.6, 2.0);
+  std::cout << state_count << " states, " << (state_count * 2 * sizeof(double)) / (1 << 20)
+            << " MiB of x and y\n";
+
+  double sum = 0.0;
+  // Reference: reading the coordinates once.
+  const double read_time = bench::best_of(
+      [&] {
+        double total = 0.0;
+        for (std::size_t i = 0; i < state_count; ++i) {
+          total = std::max(total, x[i] + y[i]);
+        }
+        sum += total;
+      },
+      3);
+  bench::report("read x/y arrays", read_time, state_count);
+
+  const double naive_time = bench::best_of(
+      [&] { sum += static_cast<double>(first_too_curved(states, model.max_curvature)); }, 3);
+  bench::report("scalar curvature loop (atan2)", naive_time, state_count);
+
+  const double aos_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(
+            check_feasibility(span<const state_r2>(states), model).index);
+      },
+      3);
+  bench::report("check_feasibility, state_r2", aos_time, state_count);
+
+  const double soa_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(
+            check_feasibility(span<const double>(x), span<const double>(y), model).index);
+      },
+      3);
+  bench::report("check_feasibility, x/y arrays", soa_time, state_count);
+
+  kinematic_model curvature_only = model;
+  curvature_only.max_curvature_rate = std::numeric_limits<double>::infinity();
+  const double curvature_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(
+            check_feasibility(span<const double>(x), span<const double>(y), curvature_only)
+                .index);
+      },
+      3);
+  bench::report("check_feasibility, x/y arrays, curvature only", curvature_time, state_count);
+
+  const double se2_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(
+            check_feasibility(span<const state_se2>(poses), model).index);
+      },
+      3);
+  bench::report("check_feasibility, state_se2 with heading", se2_time, state_count);
+
+  // An early violation ends the check.
+  kinematic_model strict = model;
+  strict.max_curvature = 0.01;
+  const double early_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(
+            check_feasibility(span<const double>(x), span<const double>(y), strict).index);
+      },
+      3);
+  bench::report("check_feasibility, early violation", early_time, 1);
+
+  std::cout << "feasible: " << is_feasible(span<const state_r2>(states), model) << "\n";
+  bench::consume(sum);
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/collision/footprint_checker.h"
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::int64_t size = 1024;
+  constexpr std::size_t path_count = 200;
+  constexpr std::size_t path_length = 500;
+
+  // Random boxes covering roughly 3% of the map.
+  env::bit_occupancy_grid grid(size, size, 0.05);
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 16);
+  std::uniform_int_distribution<std::int64_t> extent(1, 15);
+  for (int i = 0; i < 400; ++i) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        grid.set({x, y}, true);
+      }
+    }
+  }
+  const env::distance_field field(grid);
+
+  // A 1.0 x 0.6 car footprint, the reference point is on the rear axle.
+  const std::vector<state_r2> footprint{{-0.2, -0.3}, {0.8, -0.3}, {0.8, 0.3}, {-0.2, 0.3}};
+  const collision::footprint_checker checker(span<const state_r2>(footprint), grid, field);
+
+  // Densely sampled random walks with a step of half a cell.
+  std::vector<state_se2> states;
+  std::uniform_real_distribution<double> start(14.0, 37.0);
+  std::uniform_real_distribution<double> turn(-0.05, 0.05);
+  for (std::size_t p = 0; p < path_count; ++p) {
+    state_se2 state{start(rng), start(rng), start(rng)};
+    for (std::size_t i = 0; i < path_length; ++i) {
+      state.x += 0.025 * std::cos(state.yaw);
+      state.y += 0.025 * std::sin(state.yaw);
+      state.yaw += turn(rng);
+      states.push_back(state);
+    }
+  }
+  const span<const state_se2> all(states);
+
+  std::cout << "Footprint with " << checker.mask(0).size() << " mask cells on a " << size << "x"
+            << size << " grid\n";
+
+  std::size_t colliding = 0;
+  const double naive_time = bench::best_of(
+      [&] {
+        colliding = 0;
+        for (const state_se2& state : all) {
+          const env::cell_index cell = grid.cell_of(state.x, state.y);
+          bool collides = !grid.contains(cell);
+          for (const auto& offset : checker.mask(checker.yaw_bin(state.yaw))) {
+            if (collides) {
+              break;
+            }
+            collides = grid.value({cell.x + offset.dx, cell.y + offset.dy});
+          }
+          colliding += collides ? 1U : 0U;
+        }
+      },
+      3);
+  bench::report("full mask scan", naive_time, all.size());
+  bench::consume(static_cast<double>(colliding));
+
+  const double checker_time = bench::best_of(
+      [&] {
+        colliding = 0;
+        for (const state_se2& state : all) {
+          colliding += checker.collides(state) ? 1U : 0U;
+        }
+      },
+      3);
+  bench::report("footprint_checker::collides", checker_time, all.size());
+  std::cout << 100.0 * static_cast<double>(colliding) / static_cast<double>(all.size())
+            << "% colliding\n";
+
+  std::size_t first = 0;
+  const double first_time = bench::best_of(
+      [&] {
+        for (std::size_t p = 0; p < path_count; ++p) {
+          first += checker.first_collision(all.subspan(p * path_length, path_length));
+        }
+      },
+      3);
+  bench::consume(static_cast<double>(first));
+  bench::report("footprint_checker::first_collision", first_time, path_count);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/geofence.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/thread_pool.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t zone_count = 32;
+  constexpr std::size_t vertex_count = 4000;
+  constexpr std::size_t state_count = 1000000;
+
+  // Concave zones with jagged outlines on a 1 km x 1 km area.
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> center(100.0, 900.0);
+  std::uniform_real_distribution<double> radius(40.0, 150.0);
+  std::uniform_real_distribution<double> jitter(0.9, 1.1);
+  ragged_buffer<state_r2> zones;
+  std::vector<state_r2> vertices;
+  for (std::size_t z = 0; z < zone_count; ++z) {
+    const state_r2 c{center(rng), center(rng)};
+    const double r = radius(rng);
+    vertices.clear();
+    for (std::size_t i = 0; i < vertex_count; ++i) {
+      const double angle =
+          numbers::two_pi * static_cast<double>(i) / static_cast<double>(vertex_count);
+      const double lobes = 1.0 + 0.3 * std::sin(5.0 * angle);
+      const double length = r * lobes * jitter(rng);
+      vertices.push_back({c.x + length * std::cos(angle), c.y + length * std::sin(angle)});
+    }
+    zones.push_back(span<const state_r2>(vertices));
+  }
+
+  // Paths through the area, sampled every 10 cm.
+  std::vector<state_r2> states;
+  states.reserve(state_count);
+  std::uniform_real_distribution<double> start(0.0, 1000.0);
+  std::uniform_real_distribution<double> turn(-0.02, 0.02);
+  double heading = 0.0;
+  state_r2 state{start(rng), start(rng)};
+  for (std::size_t i = 0; i < state_count; ++i) {
+    if (i % 10000 == 0) {
+      state = {start(rng), start(rng)};
+    }
+    heading += turn(rng);
+    state.x += 0.1 * std::cos(heading);
+    state.y += 0.1 * std::sin(heading);
+    states.push_back(state);
+  }
+  const span<const state_r2> all(states);
+
+  std::cout << zone_count << " zones with " << vertex_count << " vertices, " << state_count
+            << " states\n";
+
+  std::optional<env::geofence> fence;
+  const double build_time = bench::best_of([&] { fence.emplace(zones); }, 3);
+  bench::report("geofence, build", build_time, zone_count);
+
+  std::vector<std::uint8_t> inside(state_count);
+  const double classify_time = bench::best_of(
+      [&] {
+        for (std::size_t z = 0; z < zone_count; ++z) {
+          fence->classify(z, all, span<std::uint8_t>(inside));
+        }
+      },
+      3);
+  bench::report("geofence::classify, per state and zone", classify_time,
+                state_count * zone_count);
+
+  // The plain crossing test, on a subset of the states.
+  constexpr std::size_t brute_force_count = 2000;
+  std::size_t brute_force_inside = 0;
+  const double brute_force_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < brute_force_count; ++i) {
+          for (std::size_t z = 0; z < zone_count; ++z) {
+            brute_force_inside += polygon_contains(fence->zone(z), states[i]) ? 1U : 0U;
+          }
+        }
+      },
+      3);
+  bench::report("polygon_contains, per state and zone", brute_force_time,
+                brute_force_count * zone_count);
+
+  std::vector<env::zone_transition> transitions;
+  const double transitions_time =
+      bench::best_of([&] { fence->transitions(all, transitions); }, 3);
+  bench::report("geofence::transitions, per state", transitions_time, state_count);
+
+  thread_pool pool;
+  const double parallel_time =
+      bench::best_of([&] { fence->transitions(pool, all, transitions); }, 3);
+  bench::report("geofence::transitions, " + std::to_string(pool.size()) + " threads",
+                parallel_time, state_count);
+  std::cout << transitions.size() << " transitions\n";
+
+  bench::consume(static_cast<double>(inside[state_count / 2] + brute_force_inside));
+  return 0;
+}
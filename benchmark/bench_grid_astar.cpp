@@ -0,0 +1,147 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/path.h"
+#include "trailblaze/planning/grid_astar.h"
+
+namespace {
+
+using trailblaze::env::bit_occupancy_grid;
+using trailblaze::env::cell_index;
+
+/// Textbook A*: cost and closed arrays allocated per query, std::priority_queue with lazy
+/// deletion. Returns the path cost.
+double textbook_astar(const bit_occupancy_grid& grid, cell_index start, cell_index goal) {
+  const auto width = static_cast<std::int64_t>(grid.width());
+  const std::size_t size = grid.width() * grid.height();
+  std::vector<double> cost(size, std::numeric_limits<double>::infinity());
+  std::vector<bool> closed(size, false);
+  std::vector<std::int64_t> parent(size, -1);
+  using entry = std::pair<double, std::int64_t>;
+  std::priority_queue<entry, std::vector<entry>, std::greater<>> open;
+  const auto free = [&](std::int64_t x, std::int64_t y) { return !grid.value({x, y}); };
+  const auto heuristic = [&](std::int64_t x, std::int64_t y) {
+    const auto ax = static_cast<double>(std::abs(x - goal.x));
+    const auto ay = static_cast<double>(std::abs(y - goal.y));
+    return grid.resolution() * (ax + ay + (std::sqrt(2.0) - 2.0) * std::min(ax, ay));
+  };
+  const std::int64_t goal_index = goal.y * width + goal.x;
+  cost[static_cast<std::size_t>(start.y * width + start.x)] = 0.0;
+  open.push({heuristic(start.x, start.y), start.y * width + start.x});
+  while (!open.empty()) {
+    const std::int64_t index = open.top().second;
+    open.pop();
+    if (closed[static_cast<std::size_t>(index)]) {
+      continue;
+    }
+    closed[static_cast<std::size_t>(index)] = true;
+    if (index == goal_index) {
+      break;
+    }
+    const std::int64_t x = index % width;
+    const std::int64_t y = index / width;
+    const double c = cost[static_cast<std::size_t>(index)];
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+      for (std::int64_t dx = -1; dx <= 1; ++dx) {
+        if ((dx == 0 && dy == 0) || !free(x + dx, y + dy) || !free(x + dx, y) ||
+            !free(x, y + dy)) {
+          continue;
+        }
+        const double next =
+            c + grid.resolution() * ((dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0);
+        const std::int64_t neighbor = (y + dy) * width + x + dx;
+        if (next < cost[static_cast<std::size_t>(neighbor)]) {
+          cost[static_cast<std::size_t>(neighbor)] = next;
+          parent[static_cast<std::size_t>(neighbor)] = index;
+          open.push({next + heuristic(x + dx, y + dy), neighbor});
+        }
+      }
+    }
+  }
+  return cost[static_cast<std::size_t>(goal_index)];
+}
+
+} // namespace
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::int64_t size = 1024;
+  constexpr std::size_t query_count = 200;
+
+  // A 102.4 m x 102.4 m map with scattered boxes.
+  bit_occupancy_grid grid(size, size, 0.1);
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 40);
+  std::uniform_int_distribution<std::int64_t> extent(5, 40);
+  for (int i = 0; i < 600; ++i) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        grid.set({x, y}, true);
+      }
+    }
+  }
+  // Queries between free cells, mostly a few hundred cells apart.
+  std::vector<std::pair<cell_index, cell_index>> queries;
+  std::uniform_int_distribution<std::int64_t> position(0, size - 1);
+  std::uniform_int_distribution<std::int64_t> offset(-300, 300);
+  while (queries.size() < query_count) {
+    const cell_index start{position(rng), position(rng)};
+    const cell_index goal{start.x + offset(rng), start.y + offset(rng)};
+    if (!grid.value(start) && !grid.value(goal)) {
+      queries.emplace_back(start, goal);
+    }
+  }
+
+  planning::search_workspace workspace(grid);
+  path<state_r2> out;
+  double sum = 0.0;
+  std::size_t expanded = 0;
+  for (const auto& [start, goal] : queries) {
+    planning::grid_astar(grid, grid.cell_center(start), grid.cell_center(goal), workspace, out);
+    expanded += workspace.expanded_count();
+  }
+  std::cout << size << "x" << size << " cells, " << query_count << " queries, "
+            << expanded / query_count << " expanded cells per query\n";
+
+  const double textbook_time = bench::best_of(
+      [&] {
+        for (const auto& [start, goal] : queries) {
+          sum += textbook_astar(grid, start, goal);
+        }
+      },
+      3);
+  bench::report("textbook A*, allocating per query", textbook_time, query_count);
+
+  const double workspace_time = bench::best_of(
+      [&] {
+        for (const auto& [start, goal] : queries) {
+          planning::grid_astar(grid, grid.cell_center(start), grid.cell_center(goal), workspace,
+                               out);
+          sum += workspace.path_cost();
+        }
+      },
+      3);
+  bench::report("grid_astar with search_workspace", workspace_time, query_count);
+
+  bench::consume(sum);
+  return 0;
+}
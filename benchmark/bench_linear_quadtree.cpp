@@ -0,0 +1,132 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/linear_quadtree.h"
+#include "trailblaze/environment/ray_caster.h"
+#include "trailblaze/math/numbers.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::int64_t size = 16384;
+  constexpr double resolution = 0.1;
+  constexpr std::size_t state_count = 1000000;
+  constexpr std::size_t ray_count = 100000;
+  constexpr double max_range = 200.0;
+
+  // A 1.6 km x 1.6 km map with scattered buildings, about one percent is occupied.
+  std::vector<env::cell_index> cells;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 128);
+  std::uniform_int_distribution<std::int64_t> extent(20, 127);
+  for (int i = 0; i < 400; ++i) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        cells.push_back({x, y});
+      }
+    }
+  }
+  env::bit_occupancy_grid grid(size, size, resolution);
+  for (const env::cell_index& cell : cells) {
+    grid.set(cell, true);
+  }
+  const env::ray_caster caster(grid);
+
+  std::optional<env::linear_quadtree> tree;
+  const double build_time = bench::best_of(
+      [&] {
+        tree.emplace(size, size, resolution, state_r2{}, span<const env::cell_index>(cells));
+      },
+      3);
+  bench::report("linear_quadtree construction", build_time, cells.size());
+  const std::size_t tree_bytes =
+      tree->leaf_count() * (sizeof(std::uint64_t) + sizeof(std::uint8_t));
+  const std::size_t grid_bytes = static_cast<std::size_t>(size * size / 8);
+  std::cout << size << "x" << size << " cells, " << cells.size() << " occupied\n"
+            << "  bit grid: " << grid_bytes / 1024 << " KiB, quadtree: " << tree->leaf_count()
+            << " leaves, " << tree_bytes / 1024 << " KiB\n";
+
+  // A random walk with 5 cm steps, as a dense path.
+  std::vector<state_r2> states(state_count);
+  std::uniform_real_distribution<double> step(-0.05, 0.05);
+  state_r2 state{800.0, 800.0};
+  for (state_r2& s : states) {
+    state.x = std::clamp(state.x + step(rng), 1.0, 1600.0);
+    state.y = std::clamp(state.y + step(rng), 1.0, 1600.0);
+    s = state;
+  }
+  std::vector<std::uint8_t> occupied(state_count);
+  double sum = 0.0;
+  const double grid_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < state_count; ++i) {
+          occupied[i] = grid.value(grid.cell_of(states[i].x, states[i].y)) ? 1 : 0;
+        }
+        sum += occupied[state_count / 2];
+      },
+      3);
+  bench::report("bit_occupancy_grid::value", grid_time, state_count);
+  const double tree_time = bench::best_of(
+      [&] {
+        tree->occupied(span<const state_r2>(states), span<std::uint8_t>(occupied));
+        sum += occupied[state_count / 2];
+      },
+      3);
+  bench::report("linear_quadtree::occupied", tree_time, state_count);
+
+  constexpr std::size_t clearance_count = 100000;
+  std::vector<double> clearance(clearance_count);
+  const double clearance_time = bench::best_of(
+      [&] {
+        tree->clearance(span<const state_r2>(states.data(), clearance_count),
+                        span<double>(clearance));
+        sum += clearance[clearance_count / 2];
+      },
+      3);
+  bench::report("linear_quadtree::clearance", clearance_time, clearance_count);
+
+  // Long rays through mostly free space.
+  std::vector<state_r2> origins(ray_count);
+  std::vector<double> angles(ray_count);
+  std::uniform_real_distribution<double> position(100.0, 1500.0);
+  std::uniform_real_distribution<double> angle(-numbers::pi, numbers::pi);
+  for (std::size_t i = 0; i < ray_count; ++i) {
+    origins[i] = {position(rng), position(rng)};
+    angles[i] = angle(rng);
+  }
+  std::cout << ray_count << " rays, max. range " << max_range << " m\n";
+  const double dda_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < ray_count; ++i) {
+          sum += caster.cast(origins[i], angles[i], max_range).distance;
+        }
+      },
+      3);
+  bench::report("ray_caster::cast", dda_time, ray_count);
+  const double skipping_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < ray_count; ++i) {
+          sum += tree->cast(origins[i], angles[i], max_range).distance;
+        }
+      },
+      3);
+  bench::report("linear_quadtree::cast", skipping_time, ray_count);
+
+  bench::consume(sum);
+  return 0;
+}
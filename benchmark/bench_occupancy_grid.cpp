@@ -0,0 +1,81 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/occupancy_grid.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t size = 8192;
+  constexpr double resolution = 0.05;
+  constexpr std::size_t path_count = 5000;
+  constexpr std::size_t states_per_path = 400;
+  constexpr std::size_t state_count = path_count * states_per_path;
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> cell_value(0, 255);
+  env::byte_occupancy_grid tiled(size, size, resolution);
+  env::bit_occupancy_grid bits(size, size, resolution);
+  std::vector<std::uint8_t> row_major(size * size);
+  for (std::size_t y = 0; y < size; ++y) {
+    for (std::size_t x = 0; x < size; ++x) {
+      const auto value = static_cast<std::uint8_t>(cell_value(rng));
+      const env::cell_index cell{static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)};
+      tiled.set(cell, value);
+      bits.set(cell, tiled.is_occupied_value(value));
+      row_major[y * size + x] = value;
+    }
+  }
+
+  // Straight paths in random directions, one cell apart.
+  std::uniform_real_distribution<double> position(5.0, size * resolution - 5.0);
+  std::uniform_real_distribution<double> direction(-3.14159, 3.14159);
+  std::vector<state_r2> states;
+  states.reserve(state_count);
+  for (std::size_t p = 0; p < path_count; ++p) {
+    const double x0 = position(rng);
+    const double y0 = position(rng);
+    const double angle = direction(rng);
+    for (std::size_t i = 0; i < states_per_path; ++i) {
+      const double s = resolution * static_cast<double>(i) * 0.01 * states_per_path / 4.0;
+      states.push_back({x0 + s * std::cos(angle), y0 + s * std::sin(angle)});
+    }
+  }
+  const span<const state_r2> all(states);
+
+  std::cout << "Occupancy queries, " << size << "x" << size << " grid, " << path_count
+            << " paths x " << states_per_path << " states\n";
+
+  std::vector<std::uint8_t> values(state_count);
+  const double row_major_time = bench::best_of([&] {
+    for (std::size_t i = 0; i < state_count; ++i) {
+      const auto x = static_cast<std::size_t>(std::floor(states[i].x / resolution));
+      const auto y = static_cast<std::size_t>(std::floor(states[i].y / resolution));
+      values[i] = row_major[y * size + x];
+    }
+    bench::consume(values.back());
+  });
+  bench::report("row-major uint8, per state", row_major_time, state_count);
+
+  const double tiled_time = bench::best_of([&] {
+    tiled.values(all, span<std::uint8_t>(values));
+    bench::consume(values.back());
+  });
+  bench::report("tiled uint8, values(span)", tiled_time, state_count);
+
+  const double bits_time = bench::best_of([&] {
+    bits.occupied(all, span<std::uint8_t>(values));
+    bench::consume(values.back());
+  });
+  bench::report("tiled bits, occupied(span)", bits_time, state_count);
+  return 0;
+}
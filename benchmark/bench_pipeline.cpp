@@ -0,0 +1,65 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/algorithm/annotate.h"
+#include "trailblaze/algorithm/geometry.h"
+#include "trailblaze/algorithm/resample.h"
+#include "trailblaze/pipeline.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t state_count = 200000;
+  constexpr double sample_density = 0.05;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> step(-1.0, 1.0);
+  path<state_r2> input;
+  input.resize(state_count);
+  for (std::size_t i = 1; i < state_count; ++i) {
+    input[i] = {input[i - 1].x + step(generator), input[i - 1].y + step(generator)};
+  }
+  const auto to_world = [](const state_se2& state) {
+    return state_se2{state.x + 100.0, state.y - 50.0, state.yaw};
+  };
+
+  std::size_t sample_count = 0;
+  std::size_t intermediate_bytes = 0;
+  const double eager_time = bench::best_of([&] {
+    std::vector<state_r2> resampled_states;
+    resample(input.states(), sample_density, std::back_inserter(resampled_states));
+    const path<state_se2> annotated = annotate::yaw_chord(span<state_r2>(resampled_states));
+    std::vector<state_se2> transformed_states;
+    transformed_states.reserve(annotated.size());
+    for (const auto& state : annotated.states()) {
+      transformed_states.push_back(to_world(state));
+    }
+    bench::consume(length_xy(span<const state_se2>(transformed_states)));
+    sample_count = resampled_states.size();
+    intermediate_bytes = resampled_states.capacity() * sizeof(state_r2) +
+                         annotated.size() * sizeof(state_se2) +
+                         transformed_states.capacity() * sizeof(state_se2);
+  });
+
+  std::cout << "Resample, annotate, transform, length: " << state_count << " input states, "
+            << sample_count << " samples\n";
+  bench::report("eager stages", eager_time, sample_count);
+
+  const double lazy_time = bench::best_of([&] {
+    using namespace pipeline;
+    bench::consume(pipeline::length_xy(states(input) | resampled(sample_density) |
+                                       yaw_from_chord() | transformed(to_world)));
+  });
+  bench::report("lazy pipeline", lazy_time, sample_count);
+
+  std::cout << "intermediate storage: eager " << intermediate_bytes / (1024 * 1024)
+            << " MiB, lazy O(1)\n";
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/polygon_map.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t polygon_count = 1000000;
+  constexpr std::size_t query_count = 200000;
+  constexpr double extent = 10000.0;
+
+  // Building outlines with 4 to 8 vertices on a 10 km x 10 km map.
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> position(0.0, extent);
+  std::uniform_real_distribution<double> radius(2.0, 6.0);
+  std::uniform_int_distribution<int> vertex_count(4, 8);
+  ragged_buffer<state_r2> polygons;
+  std::vector<state_r2> vertices;
+  for (std::size_t p = 0; p < polygon_count; ++p) {
+    const state_r2 center{position(rng), position(rng)};
+    const int n = vertex_count(rng);
+    vertices.clear();
+    for (int i = 0; i < n; ++i) {
+      const double angle = numbers::two_pi * i / n;
+      const double r = radius(rng);
+      vertices.push_back({center.x + r * std::cos(angle), center.y + r * std::sin(angle)});
+    }
+    polygons.push_back(span<const state_r2>(vertices));
+  }
+
+  std::vector<state_r2> points(query_count);
+  std::vector<state_r2> ends(query_count);
+  std::uniform_real_distribution<double> step(-1.0, 1.0);
+  for (std::size_t i = 0; i < query_count; ++i) {
+    points[i] = {position(rng), position(rng)};
+    ends[i] = {points[i].x + step(rng), points[i].y + step(rng)};
+  }
+
+  std::cout << polygon_count << " polygons with " << polygons.element_count() << " vertices\n";
+
+  env::polygon_map map;
+  const double build_time = bench::best_of([&] { map = env::polygon_map(polygons); }, 3);
+  bench::report("polygon_map, bulk load (incl. vertex copy)", build_time, polygon_count);
+
+  std::size_t hits = 0;
+  const double contains_time = bench::best_of(
+      [&] {
+        for (const state_r2& point : points) {
+          hits += map.contains(point) ? 1U : 0U;
+        }
+      },
+      3);
+  bench::report("polygon_map::contains", contains_time, query_count);
+
+  const double intersects_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < query_count; ++i) {
+          hits += map.intersects(points[i], ends[i]) ? 1U : 0U;
+        }
+      },
+      3);
+  bench::report("polygon_map::intersects", intersects_time, query_count);
+
+  double sum = 0.0;
+  const double distance_time = bench::best_of(
+      [&] {
+        for (const state_r2& point : points) {
+          sum += map.distance(point);
+        }
+      },
+      3);
+  bench::report("polygon_map::distance", distance_time, query_count);
+
+  const double bounded_time = bench::best_of(
+      [&] {
+        for (const state_r2& point : points) {
+          sum += map.distance(point, 5.0);
+        }
+      },
+      3);
+  bench::report("polygon_map::distance, bounded by 5 m", bounded_time, query_count);
+
+  // Without an index, every query tests all polygons.
+  constexpr std::size_t brute_force_count = 20;
+  const double brute_force_time = bench::best_of(
+      [&] {
+        for (std::size_t i = 0; i < brute_force_count; ++i) {
+          for (std::size_t p = 0; p < polygon_count; ++p) {
+            if (polygon_intersects_segment(polygons[p], points[i], ends[i])) {
+              ++hits;
+              break;
+            }
+          }
+        }
+      },
+      1);
+  bench::report("brute force intersects", brute_force_time, brute_force_count);
+  bench::consume(sum + static_cast<double>(hits));
+  return 0;
+}
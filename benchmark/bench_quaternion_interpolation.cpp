@@ -0,0 +1,99 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/math/interpolation.h"
+#include "trailblaze/quaternion.h"
+
+namespace {
+
+using trailblaze::quaternion;
+
+std::vector<quaternion> random_quaternions(std::size_t n) {
+  std::mt19937 generator(42);
+  std::normal_distribution<double> distribution;
+  std::vector<quaternion> out(n);
+  for (auto& q : out) {
+    q = trailblaze::normalized(quaternion{distribution(generator), distribution(generator),
+                                          distribution(generator), distribution(generator)});
+  }
+  return out;
+}
+
+double max_component_error(const quaternion& a, const quaternion& b) {
+  return std::max({std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z),
+                   std::fabs(a.w - b.w)});
+}
+
+} // namespace
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t segment_count = 20000;
+  constexpr std::size_t samples_per_segment = 50;
+  constexpr std::size_t operations = segment_count * samples_per_segment;
+  const std::vector<quaternion> keys = random_quaternions(segment_count + 1);
+
+  std::vector<double> ratios(samples_per_segment);
+  for (std::size_t i = 0; i < samples_per_segment; ++i) {
+    ratios[i] = static_cast<double>(i) / static_cast<double>(samples_per_segment - 1);
+  }
+  std::vector<quaternion> reference(operations);
+  std::vector<quaternion> out(operations);
+
+  std::cout << "Quaternion slerp, " << segment_count << " segments x " << samples_per_segment
+            << " ratios\n";
+
+  const double exact_time = bench::best_of([&] {
+    for (std::size_t s = 0; s < segment_count; ++s) {
+      for (std::size_t i = 0; i < samples_per_segment; ++i) {
+        reference[s * samples_per_segment + i] = interpolate_quaternion(keys[s], keys[s + 1],
+                                                                        ratios[i]);
+      }
+    }
+    bench::consume(reference.back().w);
+  });
+  bench::report("interpolate_quaternion", exact_time, operations);
+
+  const double single_time = bench::best_of([&] {
+    for (std::size_t s = 0; s < segment_count; ++s) {
+      const quaternion_slerp slerp(keys[s], keys[s + 1]);
+      for (std::size_t i = 0; i < samples_per_segment; ++i) {
+        out[s * samples_per_segment + i] = slerp(ratios[i]);
+      }
+    }
+    bench::consume(out.back().w);
+  });
+  bench::report("quaternion_slerp, single calls", single_time, operations);
+  double single_error = 0.0;
+  for (std::size_t i = 0; i < operations; ++i) {
+    single_error = std::max(single_error, max_component_error(out[i], reference[i]));
+  }
+
+  const double batch_time = bench::best_of([&] {
+    for (std::size_t s = 0; s < segment_count; ++s) {
+      const quaternion_slerp slerp(keys[s], keys[s + 1]);
+      slerp(span<const double>(ratios),
+            span<quaternion>(out.data() + s * samples_per_segment, samples_per_segment));
+    }
+    bench::consume(out.back().w);
+  });
+  bench::report("quaternion_slerp, batch", batch_time, operations);
+  double batch_error = 0.0;
+  for (std::size_t i = 0; i < operations; ++i) {
+    batch_error = std::max(batch_error, max_component_error(out[i], reference[i]));
+  }
+
+  std::cout << std::scientific << "max component error vs interpolate_quaternion: single "
+            << single_error << ", batch " << batch_error << '\n';
+  return 0;
+}
@@ -0,0 +1,123 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/environment/ray_caster.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/thread_pool.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::int64_t size = 2048;
+  constexpr std::size_t beam_count = 3600;
+  constexpr std::size_t scan_count = 50;
+  constexpr double max_range = 30.0;
+
+  // Random boxes covering a few percent of a 102.4 m x 102.4 m map.
+  env::bit_occupancy_grid grid(size, size, 0.05);
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<std::int64_t> corner(0, size - 32);
+  std::uniform_int_distribution<std::int64_t> extent(1, 31);
+  for (int i = 0; i < 300; ++i) {
+    const std::int64_t x0 = corner(rng);
+    const std::int64_t y0 = corner(rng);
+    const std::int64_t w = extent(rng);
+    const std::int64_t h = extent(rng);
+    for (std::int64_t y = y0; y < y0 + h; ++y) {
+      for (std::int64_t x = x0; x < x0 + w; ++x) {
+        grid.set({x, y}, true);
+      }
+    }
+  }
+  const env::ray_caster caster(grid);
+
+  // Range scans with 0.1 degree beam spacing from random free positions.
+  std::vector<double> angles(beam_count);
+  for (std::size_t i = 0; i < beam_count; ++i) {
+    angles[i] = numbers::two_pi * static_cast<double>(i) / static_cast<double>(beam_count);
+  }
+  std::vector<state_r2> origins;
+  std::uniform_real_distribution<double> position(20.0, 80.0);
+  while (origins.size() < scan_count) {
+    const state_r2 origin{position(rng), position(rng)};
+    if (!grid.value(grid.cell_of(origin.x, origin.y))) {
+      origins.push_back(origin);
+    }
+  }
+  std::vector<double> ranges(beam_count);
+  std::cout << scan_count << " scans with " << beam_count << " beams, max. range " << max_range
+            << " m on a " << size << "x" << size << " grid\n";
+
+  // Marching along the beam in steps of a quarter cell.
+  double sum = 0.0;
+  const double step = 0.25 * grid.resolution();
+  const double sampling_time = bench::best_of(
+      [&] {
+        for (const state_r2& origin : origins) {
+          for (std::size_t i = 0; i < beam_count; ++i) {
+            const double c = std::cos(angles[i]);
+            const double s = std::sin(angles[i]);
+            double t = 0.0;
+            while (t < max_range && !grid.value(grid.cell_of(origin.x + t * c, origin.y + t * s))) {
+              t += step;
+            }
+            sum += t;
+          }
+        }
+      },
+      3);
+  bench::report("sampled ray marching", sampling_time, scan_count * beam_count);
+
+  const double dda_time = bench::best_of(
+      [&] {
+        for (const state_r2& origin : origins) {
+          caster.cast(origin, span<const double>(angles), max_range, span<double>(ranges));
+          sum += ranges[0];
+        }
+      },
+      3);
+  bench::report("ray_caster::cast", dda_time, scan_count * beam_count);
+
+  thread_pool pool;
+  const double parallel_time = bench::best_of(
+      [&] {
+        for (const state_r2& origin : origins) {
+          caster.cast(pool, origin, span<const double>(angles), max_range, span<double>(ranges));
+          sum += ranges[0];
+        }
+      },
+      3);
+  bench::report("ray_caster::cast, " + std::to_string(pool.size()) + " threads", parallel_time,
+                scan_count * beam_count);
+
+  // Line of sight between random pairs of states, as in shortcutting.
+  constexpr std::size_t pair_count = 100000;
+  std::vector<state_r2> from(pair_count);
+  std::vector<state_r2> to(pair_count);
+  std::uniform_real_distribution<double> offset(-5.0, 5.0);
+  for (std::size_t i = 0; i < pair_count; ++i) {
+    from[i] = {position(rng), position(rng)};
+    to[i] = {from[i].x + offset(rng), from[i].y + offset(rng)};
+  }
+  std::vector<std::uint8_t> free(pair_count);
+  const double pairs_time = bench::best_of(
+      [&] {
+        caster.segments_free(span<const state_r2>(from), span<const state_r2>(to),
+                             span<std::uint8_t>(free));
+      },
+      3);
+  bench::report("ray_caster::segments_free", pairs_time, pair_count);
+
+  bench::consume(sum + static_cast<double>(free[pair_count / 2]));
+  return 0;
+}
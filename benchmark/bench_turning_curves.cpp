@@ -0,0 +1,63 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/generate/dubins.h"
+#include "trailblaze/generate/reeds_shepp.h"
+#include "trailblaze/math/numbers.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t goal_count = 200000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> yaw(-numbers::pi, numbers::pi);
+  std::vector<state_se2> goals(goal_count);
+  for (auto& goal : goals) {
+    goal = {position(generator), position(generator), yaw(generator)};
+  }
+  const state_se2 start{0.0, 0.0, 0.0};
+  std::vector<double> distances(goal_count);
+
+  std::cout << "Turning curve distances, " << goal_count << " random goals\n";
+
+  const double dubins_curve_time = bench::best_of([&] {
+    for (std::size_t i = 0; i < goal_count; ++i) {
+      distances[i] = gen::dubins_curve(start, goals[i], 2.0).length();
+    }
+    bench::consume(distances.back());
+  });
+  bench::report("dubins_curve().length()", dubins_curve_time, goal_count);
+
+  const double dubins_time = bench::best_of([&] {
+    gen::dubins_distance(start, span<const state_se2>(goals), 2.0, span<double>(distances));
+    bench::consume(distances.back());
+  });
+  bench::report("dubins_distance, batch", dubins_time, goal_count);
+
+  const double reeds_shepp_time = bench::best_of([&] {
+    gen::reeds_shepp_distance(start, span<const state_se2>(goals), 2.0,
+                              span<double>(distances));
+    bench::consume(distances.back());
+  });
+  bench::report("reeds_shepp_distance, batch", reeds_shepp_time, goal_count);
+
+  const double sample_time = bench::best_of(
+      [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < 2000; ++i) {
+          total += gen::reeds_shepp(start, goals[i], 2.0, sampling::by_step{0.1}).size();
+        }
+        bench::consume(static_cast<double>(total));
+      },
+      3);
+  bench::report("reeds_shepp path, step 0.1 (2000 goals)", sample_time, 2000);
+  return 0;
+}
@@ -0,0 +1,63 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include "bench_common.h"
+#include "trailblaze/kinematics/velocity_profile.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t state_count = 100000;
+  constexpr double step = 0.05;
+
+  // A 5 km slalom with turning radii down to 10 m.
+  path<state_r2> states;
+  states.reserve(state_count);
+  double x = 0.0;
+  double y = 0.0;
+  double yaw = 0.0;
+  for (std::size_t i = 0; i < state_count; ++i) {
+    states.push_back({x, y});
+    const double curvature = 0.1 * std::sin(static_cast<double>(i) * 2e-4);
+    x += step * std::cos(yaw);
+    y += step * std::sin(yaw);
+    yaw += step * curvature;
+  }
+
+  velocity_limits limits;
+  limits.max_speed = 15.0;
+  limits.max_acceleration = 2.0;
+  limits.max_deceleration = 4.0;
+  limits.max_lateral_acceleration = 3.0;
+  velocity_profile profile(limits);
+  profile.compute(states);
+  std::cout << state_count << " states, duration " << profile.duration() << " s\n";
+
+  double sum = 0.0;
+  const double full_time = bench::best_of(
+      [&] {
+        profile.compute(states);
+        sum += profile.duration();
+      },
+      5);
+  bench::report("velocity_profile::compute", full_time, state_count);
+
+  // A replan that changes the last 10 % of the path.
+  constexpr std::size_t first_changed = state_count - state_count / 10;
+  const double update_time = bench::best_of(
+      [&] {
+        sum += static_cast<double>(profile.update(states, first_changed));
+      },
+      5);
+  bench::report("velocity_profile::update, last 10 %", update_time, state_count / 10);
+
+  bench::consume(sum);
+  return 0;
+}
@@ -0,0 +1,59 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "trailblaze/algorithm/annotate.h"
+
+int main() {
+  using namespace trailblaze;
+
+  constexpr std::size_t state_count = 5000000;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> step(-1.0, 1.0);
+  std::vector<state_r2> states(state_count);
+  for (std::size_t i = 1; i < state_count; ++i) {
+    states[i] = {states[i - 1].x + step(generator), states[i - 1].y + step(generator)};
+  }
+  std::vector<state_se2> out(state_count);
+
+  std::cout << "Yaw annotation, " << state_count << " states\n";
+
+  const double path_time = bench::best_of([&] {
+    const path<state_se2> annotated = annotate::yaw_chord(span<state_r2>(states));
+    bench::consume(annotated[state_count - 1].yaw);
+  });
+  bench::report("yaw_chord -> path", path_time, state_count);
+
+  const double exact_time = bench::best_of([&] {
+    annotate::yaw_chord(span<const state_r2>(states), span<state_se2>(out));
+    bench::consume(out.back().yaw);
+  });
+  bench::report("yaw_chord into span, exact", exact_time, state_count);
+
+  const double fast_time = bench::best_of([&] {
+    annotate::yaw_chord(span<const state_r2>(states), span<state_se2>(out),
+                        annotate::yaw_precision::fast);
+    bench::consume(out.back().yaw);
+  });
+  bench::report("yaw_chord into span, fast", fast_time, state_count);
+
+  const double centered_path_time = bench::best_of([&] {
+    const path<state_se2> annotated = annotate::yaw_centered_diff(span<state_r2>(states));
+    bench::consume(annotated[state_count - 1].yaw);
+  });
+  bench::report("yaw_centered_diff -> path", centered_path_time, state_count);
+
+  const double centered_fast_time = bench::best_of([&] {
+    annotate::yaw_centered_diff(span<const state_r2>(states), span<state_se2>(out),
+                                annotate::yaw_precision::fast);
+    bench::consume(out.back().yaw);
+  });
+  bench::report("yaw_centered_diff into span, fast", centered_fast_time, state_count);
+  return 0;
+}
@@ -3,16 +3,153 @@
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
 #pragma once
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
+#include "trailblaze/component_access.h"
 #include "trailblaze/math/angle.h"
+#include "trailblaze/math/numbers.h"
 #include "trailblaze/path.h"
 #include "trailblaze/span.h"
 #include "trailblaze/state_spaces/state_space_r2.h"
 #include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/state_traits.h"
+#include "trailblaze/type_traits.h"
+
+/** @file annotate.h
+ *  @brief Adds yaw angles to position-only paths.
+ *
+ *  Every annotator comes in four flavors:
+ *  - @c annotate::yaw_xxx(span<state_r2>, ...) returns a new @c path<state_se2>.
+ *  - @c annotate::yaw_xxx(span<TIn>, span<TOut>, ...) writes into preallocated output. The
+ *    positions are copied if @c TOut has them. @p TIn may be any state with
+ *    @ref has_xy_v, @p TOut any state with @ref has_yaw_v.
+ *  - @c annotate::yaw_xxx_in_place(span<TState>, ...) only overwrites the yaw of states
+ *    that have both positions and yaw.
+ *  - @c annotate::yaw_xxx(span<TIn>, OutIt, ...) emits default constructed @c TOut
+ *    (@c state_se2 unless given explicitly) with positions and yaw to an output iterator.
+ */
 
 namespace trailblaze::annotate {
 
+/// Selects how the yaw annotation kernels evaluate @c atan2.
+enum class yaw_precision : std::uint8_t {
+  /// @c std::atan2, gives the same angles as the path returning annotators.
+  exact,
+  /// @ref fast_atan2, max. error below 1e-7 rad but several times faster.
+  fast
+};
+
+namespace detail {
+
+/** Heading of the vector (dx, dy) in [-Pi, Pi).
+ *
+ *  @c atan2 already returns values in [-Pi, Pi], so instead of @ref normalized only Pi
+ *  itself has to be folded onto -Pi. @ref fast_atan2 does that by itself.
+ */
+template <yaw_precision Precision>
+inline double heading(double dx, double dy) {
+  if constexpr (Precision == yaw_precision::fast) {
+    return fast_atan2(dy, dx);
+  } else {
+    const double yaw = std::atan2(dy, dx);
+    return yaw >= numbers::pi ? -numbers::pi : yaw;
+  }
+}
+
+/// Heading of the chord from @p from to @p to, see @ref heading.
+template <yaw_precision Precision, typename TFrom, typename TTo>
+inline double chord_heading(const TFrom& from, const TTo& to) {
+  return heading<Precision>(comp::x(to) - comp::x(from), comp::y(to) - comp::y(from));
+}
+
+/// Writes position (if @p out has one) and yaw.
+template <typename TOut, typename TIn>
+inline void assign(TOut& out, const TIn& in, double yaw) {
+  if constexpr (has_xy_v<TOut>) {
+    comp::x(out) = comp::x(in);
+    comp::y(out) = comp::y(in);
+  }
+  comp::yaw(out) = yaw;
+}
+
+template <typename TOut, typename TIn>
+inline TOut make_annotated(const TIn& in, double yaw) {
+  TOut out{};
+  assign(out, in, yaw);
+  return out;
+}
+
+template <typename TIn, typename TOut>
+constexpr void check_annotation_types() {
+  static_assert(has_xy_v<std::remove_const_t<TIn>>, "input states need x and y components");
+  static_assert(has_yaw_v<TOut>, "output states need a yaw component");
+}
+
+// The kernels below only read positions and only write yaw (positions are rewritten with
+// their own value when annotating in place), so @p states and @p out may alias.
+
+template <yaw_precision Precision, typename TIn, typename TOut>
+void yaw_chord_into(span<TIn> states, span<TOut> out) {
+  const std::size_t n = states.size();
+  if (n == 0) {
+    return;
+  }
+  if (n == 1) {
+    assign(out[0], states[0], 0.0);
+    return;
+  }
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    assign(out[i], states[i], chord_heading<Precision>(states[i], states[i + 1]));
+  }
+  // backward difference, same chord as the forward difference of the previous state
+  assign(out[n - 1], states[n - 1], comp::yaw(out[n - 2]));
+}
+
+template <yaw_precision Precision, typename TIn, typename TOut>
+void yaw_centered_diff_into(span<TIn> states, span<TOut> out) {
+  const std::size_t n = states.size();
+  if (n == 0) {
+    return;
+  }
+  if (n == 1) {
+    assign(out[0], states[0], 0.0);
+    return;
+  }
+  const double first = chord_heading<Precision>(states[0], states[1]);
+  const double last = chord_heading<Precision>(states[n - 2], states[n - 1]);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    assign(out[i], states[i], chord_heading<Precision>(states[i - 1], states[i + 1]));
+  }
+  assign(out[0], states[0], first);
+  assign(out[n - 1], states[n - 1], last);
+}
+
+template <typename TIn, typename TOut>
+void yaw_lerp_into(span<TIn> states, span<TOut> out, double start_yaw, double end_yaw) {
+  // Shortest angular interpolation
+  const double diff = normalized(end_yaw - start_yaw);
+  const std::size_t n = states.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t =
+        (n == 1) ? 0.0 : static_cast<double>(i) / static_cast<double>(n - std::size_t(1));
+    assign(out[i], states[i], normalized(start_yaw + (t * diff)));
+  }
+}
+
+template <typename TIn, typename TOut>
+void yaw_constant_into(span<TIn> states, span<TOut> out, double yaw) {
+  const double value = normalized(yaw);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    assign(out[i], states[i], value);
+  }
+}
+
+} // namespace detail
+
 /** Adds yaw angles to a span of state_r2 states using forward chord (next - current). The last yaw
  *  angle is determined using a backward chord.
  *
@@ -24,30 +161,67 @@ namespace trailblaze::annotate {
  */
 inline path<state_se2> yaw_chord(const span<state_r2>& states) {
   path<state_se2> out;
-  if (states.empty()) {
-    return out;
+  out.resize(states.size());
+  detail::yaw_chord_into<yaw_precision::exact>(states, out.states());
+  return out;
+}
+
+/** Forward chord yaw annotation into preallocated output, see @ref yaw_chord.
+ *
+ *  Unlike the path returning overload this does not allocate and the loop over the states
+ *  has no calls to @c fmod, so with @ref yaw_precision::fast it can be vectorized.
+ *
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives the positions and yaw angles, must hold at least @c states.size()
+ *             states. May be the same memory as @p states.
+ *  @param precision How the angles are computed.
+ */
+template <typename TIn, typename TOut>
+void yaw_chord(span<TIn> states, span<TOut> out,
+               yaw_precision precision = yaw_precision::exact) {
+  detail::check_annotation_types<TIn, TOut>();
+  assert(out.size() >= states.size());
+  if (precision == yaw_precision::fast) {
+    detail::yaw_chord_into<yaw_precision::fast>(states, out);
+  } else {
+    detail::yaw_chord_into<yaw_precision::exact>(states, out);
   }
-  out.reserve(states.size());
+}
 
-  const auto yaw_of = [](const state_r2& a, const state_r2& b) {
-    return std::atan2(b.y - a.y, b.x - a.x);
-  };
+/** Forward chord yaw annotation that overwrites the yaw of the given states.
+ *  @param states The states to annotate.
+ *  @param precision How the angles are computed.
+ */
+template <typename TState>
+void yaw_chord_in_place(span<TState> states, yaw_precision precision = yaw_precision::exact) {
+  yaw_chord(states, states, precision);
+}
 
-  if (states.size() == 1) {
-    out.push_back({states[0].x, states[0].y, 0.0});
+/** Forward chord yaw annotation to an output iterator.
+ *  @tparam TOut The emitted state type.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives one annotated state per input state.
+ *  @param precision How the angles are computed.
+ *  @returns the output iterator past the last written state.
+ */
+template <typename TOut = state_se2, typename TIn, typename OutIt>
+std::enable_if_t<!is_span_v<OutIt>, OutIt> yaw_chord(
+    span<TIn> states, OutIt out, yaw_precision precision = yaw_precision::exact) {
+  detail::check_annotation_types<TIn, TOut>();
+  const std::size_t n = states.size();
+  if (n == 1) {
+    *out++ = detail::make_annotated<TOut>(states[0], 0.0);
     return out;
   }
-
-  for (std::size_t i = 0; i < states.size(); ++i) {
-    double yaw = 0.0;
-    if (i + 1 < states.size()) {
-      // forward difference
-      yaw = yaw_of(states[i], states[i + 1]);
-    } else {
-      // backward difference
-      yaw = yaw_of(states[i - 1], states[i]);
-    }
-    out.push_back({states[i].x, states[i].y, normalized(yaw)});
+  const auto heading = [precision](const auto& from, const auto& to) {
+    return precision == yaw_precision::fast
+               ? detail::chord_heading<yaw_precision::fast>(from, to)
+               : detail::chord_heading<yaw_precision::exact>(from, to);
+  };
+  for (std::size_t i = 0; i < n; ++i) {
+    const double yaw =
+        (i + 1 < n) ? heading(states[i], states[i + 1]) : heading(states[i - 1], states[i]);
+    *out++ = detail::make_annotated<TOut>(states[i], yaw);
   }
   return out;
 }
@@ -60,29 +234,65 @@ inline path<state_se2> yaw_chord(const span<state_r2>& states) {
  */
 inline path<state_se2> yaw_centered_diff(const span<state_r2> states) {
   path<state_se2> out;
-  if (states.empty()) {
-    return out;
+  out.resize(states.size());
+  detail::yaw_centered_diff_into<yaw_precision::exact>(states, out.states());
+  return out;
+}
+
+/** Centered difference yaw annotation into preallocated output, see @ref yaw_centered_diff.
+ *
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives the positions and yaw angles, must hold at least @c states.size()
+ *             states. May be the same memory as @p states.
+ *  @param precision How the angles are computed.
+ */
+template <typename TIn, typename TOut>
+void yaw_centered_diff(span<TIn> states, span<TOut> out,
+                       yaw_precision precision = yaw_precision::exact) {
+  detail::check_annotation_types<TIn, TOut>();
+  assert(out.size() >= states.size());
+  if (precision == yaw_precision::fast) {
+    detail::yaw_centered_diff_into<yaw_precision::fast>(states, out);
+  } else {
+    detail::yaw_centered_diff_into<yaw_precision::exact>(states, out);
   }
-  if (states.size() == 1) {
-    out.push_back({states[0].x, states[0].y, 0.0});
+}
+
+/** Centered difference yaw annotation that overwrites the yaw of the given states.
+ *  @param states The states to annotate.
+ *  @param precision How the angles are computed.
+ */
+template <typename TState>
+void yaw_centered_diff_in_place(span<TState> states,
+                                yaw_precision precision = yaw_precision::exact) {
+  yaw_centered_diff(states, states, precision);
+}
+
+/** Centered difference yaw annotation to an output iterator.
+ *  @tparam TOut The emitted state type.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives one annotated state per input state.
+ *  @param precision How the angles are computed.
+ *  @returns the output iterator past the last written state.
+ */
+template <typename TOut = state_se2, typename TIn, typename OutIt>
+std::enable_if_t<!is_span_v<OutIt>, OutIt> yaw_centered_diff(
+    span<TIn> states, OutIt out, yaw_precision precision = yaw_precision::exact) {
+  detail::check_annotation_types<TIn, TOut>();
+  const std::size_t n = states.size();
+  if (n == 1) {
+    *out++ = detail::make_annotated<TOut>(states[0], 0.0);
     return out;
   }
-  out.reserve(states.size());
-
-  const auto yaw_of = [](const state_r2& a, const state_r2& b) {
-    return std::atan2(b.y - a.y, b.x - a.x);
+  const auto heading = [precision](const auto& from, const auto& to) {
+    return precision == yaw_precision::fast
+               ? detail::chord_heading<yaw_precision::fast>(from, to)
+               : detail::chord_heading<yaw_precision::exact>(from, to);
   };
-
-  for (std::size_t i = 0; i < states.size(); ++i) {
-    double yaw = 0.0;
-    if (i == 0) {
-      yaw = yaw_of(states[0], states[1]); // forward at start
-    } else if (i + 1 == states.size()) {
-      yaw = yaw_of(states[i - 1], states[i]); // backward at end
-    } else {
-      yaw = yaw_of(states[i - 1], states[i + 1]); // centered
-    }
-    out.push_back({states[i].x, states[i].y, normalized(yaw)});
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t from = (i == 0) ? 0 : i - 1;
+    const std::size_t to = (i + 1 == n) ? i : i + 1;
+    *out++ = detail::make_annotated<TOut>(states[i], heading(states[from], states[to]));
   }
   return out;
 }
@@ -94,19 +304,53 @@ inline path<state_se2> yaw_centered_diff(const span<state_r2> states) {
  */
 inline path<state_se2> yaw_lerp(const span<state_r2>& states, double start_yaw, double end_yaw) {
   path<state_se2> out;
-  out.reserve(states.size());
-  if (states.empty()) {
-    return out;
-  }
+  out.resize(states.size());
+  detail::yaw_lerp_into(states, out.states(), start_yaw, end_yaw);
+  return out;
+}
 
-  // Shortest angular interpolation
-  double diff = normalized(end_yaw - start_yaw);
-  for (std::size_t i = 0; i < states.size(); ++i) {
-    double t = (states.size() == 1)
-                   ? 0.0
-                   : static_cast<double>(i) / static_cast<double>(states.size() - std::size_t(1));
-    double yaw = normalized(start_yaw + (t * diff));
-    out.push_back({states[i].x, states[i].y, yaw});
+/** Linear yaw interpolation into preallocated output, see @ref yaw_lerp.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives the positions and yaw angles, must hold at least @c states.size()
+ *             states. May be the same memory as @p states.
+ *  @param start_yaw Yaw of the first state.
+ *  @param end_yaw Yaw of the last state.
+ */
+template <typename TIn, typename TOut>
+void yaw_lerp(span<TIn> states, span<TOut> out, double start_yaw, double end_yaw) {
+  detail::check_annotation_types<TIn, TOut>();
+  assert(out.size() >= states.size());
+  detail::yaw_lerp_into(states, out, start_yaw, end_yaw);
+}
+
+/** Linear yaw interpolation that overwrites the yaw of the given states.
+ *  @param states The states to annotate.
+ *  @param start_yaw Yaw of the first state.
+ *  @param end_yaw Yaw of the last state.
+ */
+template <typename TState>
+void yaw_lerp_in_place(span<TState> states, double start_yaw, double end_yaw) {
+  yaw_lerp(states, states, start_yaw, end_yaw);
+}
+
+/** Linear yaw interpolation to an output iterator.
+ *  @tparam TOut The emitted state type.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives one annotated state per input state.
+ *  @param start_yaw Yaw of the first state.
+ *  @param end_yaw Yaw of the last state.
+ *  @returns the output iterator past the last written state.
+ */
+template <typename TOut = state_se2, typename TIn, typename OutIt>
+std::enable_if_t<!is_span_v<OutIt>, OutIt> yaw_lerp(span<TIn> states, OutIt out,
+                                                    double start_yaw, double end_yaw) {
+  detail::check_annotation_types<TIn, TOut>();
+  const double diff = normalized(end_yaw - start_yaw);
+  const std::size_t n = states.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t =
+        (n == 1) ? 0.0 : static_cast<double>(i) / static_cast<double>(n - std::size_t(1));
+    *out++ = detail::make_annotated<TOut>(states[i], normalized(start_yaw + (t * diff)));
   }
   return out;
 }
@@ -118,9 +362,47 @@ inline path<state_se2> yaw_lerp(const span<state_r2>& states, double start_yaw,
  */
 inline path<state_se2> yaw_constant(const span<state_r2>& states, double yaw) {
   path<state_se2> out;
-  out.reserve(states.size());
+  out.resize(states.size());
+  detail::yaw_constant_into(states, out.states(), yaw);
+  return out;
+}
+
+/** Constant yaw annotation into preallocated output, see @ref yaw_constant.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives the positions and yaw angles, must hold at least @c states.size()
+ *             states. May be the same memory as @p states.
+ *  @param yaw The yaw angle.
+ */
+template <typename TIn, typename TOut>
+void yaw_constant(span<TIn> states, span<TOut> out, double yaw) {
+  detail::check_annotation_types<TIn, TOut>();
+  assert(out.size() >= states.size());
+  detail::yaw_constant_into(states, out, yaw);
+}
+
+/** Constant yaw annotation that overwrites the yaw of the given states.
+ *  @param states The states to annotate.
+ *  @param yaw The yaw angle.
+ */
+template <typename TState>
+void yaw_constant_in_place(span<TState> states, double yaw) {
+  yaw_constant(states, states, yaw);
+}
+
+/** Constant yaw annotation to an output iterator.
+ *  @tparam TOut The emitted state type.
+ *  @param states The input states for which to annotate yaw angles.
+ *  @param out Receives one annotated state per input state.
+ *  @param yaw The yaw angle.
+ *  @returns the output iterator past the last written state.
+ */
+template <typename TOut = state_se2, typename TIn, typename OutIt>
+std::enable_if_t<!is_span_v<OutIt>, OutIt> yaw_constant(span<TIn> states, OutIt out,
+                                                        double yaw) {
+  detail::check_annotation_types<TIn, TOut>();
+  const double value = normalized(yaw);
   for (const auto& state : states) {
-    out.push_back({state.x, state.y, normalized(yaw)});
+    *out++ = detail::make_annotated<TOut>(state, value);
   }
   return out;
 }
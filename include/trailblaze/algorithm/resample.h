@@ -6,12 +6,44 @@
 #include <cstddef>
 #include <limits>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "trailblaze/sampling.h"
 #include "trailblaze/span.h"
 #include "trailblaze/state_space.h"
+#include "trailblaze/type_traits.h"
 
 namespace trailblaze {
 
+namespace detail {
+
+/** Interpolates one segment at all given ratios with the batch interface of @p interpolator
+ *  and writes the states to @p out.
+ *
+ *  @p buffer is used as scratch space and only grows, so a caller that keeps it alive across
+ *  segments allocates at most a few times per path.
+ */
+template <typename TState, typename TInterpolation, typename OutIt>
+OutIt interpolate_segment(const TState& a, const TState& b, const std::vector<double>& ratios,
+                          std::vector<TState>& buffer, TInterpolation& interpolator, OutIt out) {
+  if (ratios.size() == 1) {
+    *out++ = interpolator(a, b, ratios.front());
+    return out;
+  }
+  if (buffer.size() < ratios.size()) {
+    buffer.resize(ratios.size());
+  }
+  interpolator(a, b, span<const double>(ratios.data(), ratios.size()),
+               span<TState>(buffer.data(), ratios.size()));
+  for (std::size_t i = 0; i < ratios.size(); ++i) {
+    *out++ = std::move(buffer[i]);
+  }
+  return out;
+}
+
+} // namespace detail
+
 // State-agnostic resampler: you inject TMetric and TInterpolation policies.
 // TMetric:  double operator()(const S& a, const S& b) const;
 // TInterpolation:  S operator()(const S& a, const S& b, double t) const;
@@ -48,6 +80,9 @@ namespace trailblaze {
  *
  *  @return The total number of output states written through @p out.
  *
+ *  If @p interpolator also supports batch calls (see @ref is_batch_interpolator_v), all
+ *  samples that fall onto one segment are interpolated with a single batch call.
+ *
  *  @note The algorithm ensures spacing <= @p sample_density between samples, but small
  *        deviations may occur due to floating-point accumulation.
  *
@@ -76,6 +111,11 @@ std::size_t resample(span<const TState> path_span, double sample_density, OutIt
   std::size_t written_count = 1;
 
   double carried_distance = 0.0;
+  // A batch interpolator gets the ratios of all samples on a segment at once. The buffers stay
+  // empty, and thus unallocated, for other interpolators.
+  constexpr bool batch = is_batch_interpolator_v<TInterpolation, TState>;
+  std::vector<double> ratios;
+  std::vector<TState> batch_buffer;
 
   for (std::size_t i = 1; i < path_span.size(); ++i) {
     const TState& previous = path_span[i - 1];
@@ -86,20 +126,29 @@ std::size_t resample(span<const TState> path_span, double sample_density, OutIt
       continue;
     }
 
+    ratios.clear();
     double remaining_length = segment_length;
     while (carried_distance + remaining_length >= sample_density) {
       // Normalized interpolation parameter t in [0, 1] along the segment.
       const double t_along_segment =
           1.0 - (remaining_length - (sample_density - carried_distance)) / segment_length;
-
-      TState interpolated_state = interpolator(previous, current, t_along_segment);
-      *out++ = std::move(interpolated_state);
-      ++written_count;
+      if constexpr (batch) {
+        ratios.push_back(t_along_segment);
+      } else {
+        TState interpolated_state = interpolator(previous, current, t_along_segment);
+        *out++ = std::move(interpolated_state);
+        ++written_count;
+      }
 
       remaining_length -= (sample_density - carried_distance);
       carried_distance = 0.0;
     }
 
+    if constexpr (batch) {
+      out = detail::interpolate_segment(previous, current, ratios, batch_buffer, interpolator,
+                                        out);
+      written_count += ratios.size();
+    }
     carried_distance += remaining_length;
   }
 
@@ -132,6 +181,118 @@ std::size_t resample(span<const TState> path_span, double sample_density, OutIt
   return resample(path_span, sample_density, out, metric{}, iterpolation{});
 }
 
+/**
+ *  Resample a path into a fixed number of states that are evenly spaced by arc length.
+ *
+ *  The cumulative lengths of the input are computed once. The samples are then placed at
+ *  the arc lengths k * L / (N - 1) by a monotonic walk that advances through samples and
+ *  segments together, which makes the function O(n + N) and avoids any iterative guessing
+ *  of a sample density. The first and last output states are exact copies of the input
+ *  endpoints.
+ *
+ *  @tparam TState State type representing an element of the path.
+ *  @tparam TMetric Callable type with signature
+ *          <tt>double(const TState&, const TState&)</tt>.
+ *  @tparam TInterpolation Callable type with signature
+ *          <tt>TState(const TState&, const TState&, double t)</tt>. Batch interpolators
+ *          (see @ref is_batch_interpolator_v) get all samples of a segment at once.
+ *  @tparam OutIt Output iterator type to which resampled states are written.
+ *
+ *  @param path_span Span over the input path to resample.
+ *  @param policy The number of output states N.
+ *  @param out Output iterator receiving the resampled sequence.
+ *  @param metric Distance metric functor used to compute segment lengths.
+ *  @param interpolator Interpolation functor used to generate intermediate states.
+ *
+ *  @return The total number of output states written through @p out. This is N for
+ *          non-empty inputs and 0 otherwise.
+ *
+ *  @note If the path has zero length, all but the last output state are copies of the
+ *        first input state.
+ */
+template <typename TState, typename TMetric, typename TInterpolation, typename OutIt>
+std::size_t resample(span<const TState> path_span, sampling::by_count policy, OutIt out,
+                     TMetric metric, TInterpolation interpolator) {
+  const std::size_t sample_count = policy.n;
+  if (path_span.empty() || sample_count == 0) {
+    return 0;
+  }
+  *out++ = path_span.front();
+  if (sample_count == 1) {
+    return 1;
+  }
+
+  std::vector<double> cumulative_length(path_span.size());
+  cumulative_length[0] = 0.0;
+  for (std::size_t i = 1; i < path_span.size(); ++i) {
+    cumulative_length[i] = cumulative_length[i - 1] + metric(path_span[i - 1], path_span[i]);
+  }
+  const double total_length = cumulative_length.back();
+  const double spacing = total_length / static_cast<double>(sample_count - 1);
+
+  if (total_length <= std::numeric_limits<double>::epsilon()) {
+    for (std::size_t k = 1; k + 1 < sample_count; ++k) {
+      *out++ = path_span.front();
+    }
+    *out++ = path_span.back();
+    return sample_count;
+  }
+
+  // Ratios of the samples on a segment for a batch interpolator, see the overload above.
+  constexpr bool batch = is_batch_interpolator_v<TInterpolation, TState>;
+  std::vector<double> ratios;
+  std::vector<TState> batch_buffer;
+  std::size_t segment = 0;
+  std::size_t k = 1;
+  while (k + 1 < sample_count) {
+    double target = static_cast<double>(k) * spacing;
+    // Invariant: cumulative_length[segment] < target, so the segment has a positive length.
+    while (segment + 2 < path_span.size() && cumulative_length[segment + 1] < target) {
+      ++segment;
+    }
+    const double segment_start = cumulative_length[segment];
+    const double segment_end = cumulative_length[segment + 1];
+    const double segment_length = segment_end - segment_start;
+    const bool last_segment = segment + 2 == path_span.size();
+
+    ratios.clear();
+    while (k + 1 < sample_count && (last_segment || target <= segment_end)) {
+      const double ratio = (target - segment_start) / segment_length;
+      if constexpr (batch) {
+        ratios.push_back(ratio);
+      } else {
+        *out++ = interpolator(path_span[segment], path_span[segment + 1], ratio);
+      }
+      ++k;
+      target = static_cast<double>(k) * spacing;
+    }
+    if constexpr (batch) {
+      out = detail::interpolate_segment(path_span[segment], path_span[segment + 1], ratios,
+                                        batch_buffer, interpolator, out);
+    }
+  }
+
+  *out++ = path_span.back();
+  return sample_count;
+}
+
+/**
+ *  Resample a path into a fixed number of states using the default metric and interpolation
+ *  from its state space. See the primary overload for algorithm details and guarantees.
+ *
+ *  @param path_span Span over the input path to resample (const view).
+ *  @param policy The number of output states.
+ *  @param out Output iterator to which resampled states are written.
+ *
+ *  @returns The Number of states written to @p out.
+ */
+template <typename TState, typename OutIt>
+std::size_t resample(span<const TState> path_span, sampling::by_count policy, OutIt out) {
+  using metric = typename state_space<TState>::metric_type;
+  using interpolation = typename state_space<TState>::interpolation_type;
+  return resample(path_span, policy, out, metric{}, interpolation{});
+}
+
 // forwarding overload to help template deduction when caller has span<TState>.
 template <typename TState, typename TMetric, typename TInterpolation, typename OutIt>
 std::size_t resample(span<TState> path_span, double sample_density, OutIt out, TMetric metric,
@@ -153,4 +314,19 @@ std::size_t resample(span<TState> path_span, double sample_density, OutIt out) {
       sample_density, out, metric{}, interpolation{});
 }
 
+// forwarding overload to help template deduction when caller has span<TState>.
+template <typename TState, typename TMetric, typename TInterpolation, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+resample(span<TState> path_span, sampling::by_count policy, OutIt out, TMetric metric,
+         TInterpolation interpolator) {
+  return resample(span<const TState>(path_span), policy, out, metric, interpolator);
+}
+
+// forwarding overload using state_space Metric and Interpolation
+template <typename TState, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+resample(span<TState> path_span, sampling::by_count policy, OutIt out) {
+  return resample(span<const TState>(path_span), policy, out);
+}
+
 } // namespace trailblaze
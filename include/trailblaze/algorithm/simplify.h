@@ -0,0 +1,366 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "trailblaze/math/util.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_traits.h"
+
+/** @file simplify.h
+ *  @brief Tolerance based polyline simplification and collision aware shortcutting.
+ *
+ *  The simplifiers only look at the x and y components to decide which states are kept,
+ *  but the kept states are emitted unchanged, i.e. including yaw and all other components.
+ *  The first and the last state are always kept. Shortcutting leaves the geometric test to
+ *  a caller supplied collision check.
+ */
+
+namespace trailblaze::simplify {
+
+namespace detail {
+
+/** Squared distance of point p to the segment [a, b].
+ *  Degenerate segments fall back to the point distance to @p a.
+ */
+inline double squared_segment_distance(double px, double py, double ax, double ay, double bx,
+                                       double by) {
+  const double dx = bx - ax;
+  const double dy = by - ay;
+  const double length_sq = square(dx) + square(dy);
+  double t = 0.0;
+  if (length_sq > 0.0) {
+    t = ((px - ax) * dx + (py - ay) * dy) / length_sq;
+    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+  }
+  return square(px - (ax + t * dx)) + square(py - (ay + t * dy));
+}
+
+/// Twice the area of the triangle (a, b, c), always positive.
+template <typename TState>
+double double_triangle_area(const TState& a, const TState& b, const TState& c) {
+  return std::fabs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+}
+
+/// Writes the indices of all set flags to @p out.
+template <typename OutIt>
+std::size_t emit_kept_indices(const std::vector<std::uint8_t>& keep, OutIt out) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < keep.size(); ++i) {
+    if (keep[i] != 0) {
+      *out++ = i;
+      ++count;
+    }
+  }
+  return count;
+}
+
+/// Writes the states of all set flags to @p out.
+template <typename TState, typename OutIt>
+std::size_t emit_kept_states(span<const TState> states, const std::vector<std::uint8_t>& keep,
+                             OutIt out) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < keep.size(); ++i) {
+    if (keep[i] != 0) {
+      *out++ = states[i];
+      ++count;
+    }
+  }
+  return count;
+}
+
+/** Marks the states kept by Douglas-Peucker.
+ *
+ *  Uses an explicit stack of index ranges instead of recursion, so deep inputs (e.g. a
+ *  slowly curving spiral) cannot overflow the call stack.
+ */
+template <typename TState>
+std::vector<std::uint8_t> douglas_peucker_flags(span<const TState> states, double tolerance) {
+  static_assert(has_xy_v<TState>, "douglas_peucker: TState must have components x & y");
+  const std::size_t n = states.size();
+  std::vector<std::uint8_t> keep(n, 0);
+  if (n == 0) {
+    return keep;
+  }
+  keep.front() = 1;
+  keep.back() = 1;
+  if (n < 3) {
+    return keep;
+  }
+
+  const double tolerance_sq = square(tolerance);
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  ranges.emplace_back(0, n - 1);
+  while (!ranges.empty()) {
+    const auto [first, last] = ranges.back();
+    ranges.pop_back();
+
+    const TState& a = states[first];
+    const TState& b = states[last];
+    double max_distance_sq = -1.0;
+    std::size_t farthest = first;
+    for (std::size_t i = first + 1; i < last; ++i) {
+      const double distance_sq =
+          squared_segment_distance(states[i].x, states[i].y, a.x, a.y, b.x, b.y);
+      if (distance_sq > max_distance_sq) {
+        max_distance_sq = distance_sq;
+        farthest = i;
+      }
+    }
+
+    if (max_distance_sq > tolerance_sq) {
+      keep[farthest] = 1;
+      if (farthest - first > 1) {
+        ranges.emplace_back(first, farthest);
+      }
+      if (last - farthest > 1) {
+        ranges.emplace_back(farthest, last);
+      }
+    }
+  }
+  return keep;
+}
+
+/** Marks the states kept by Visvalingam-Whyatt.
+ *
+ *  Each interior state is ranked by the area of the triangle it forms with its current
+ *  neighbors. The state with the smallest area is removed and the areas of its neighbors are
+ *  updated, until all remaining areas reach the tolerance. A binary heap with lazy deletion
+ *  (stale entries are detected by a per-state version counter) gives O(n log n).
+ */
+template <typename TState>
+std::vector<std::uint8_t> visvalingam_whyatt_flags(span<const TState> states, double min_area) {
+  static_assert(has_xy_v<TState>, "visvalingam_whyatt: TState must have components x & y");
+  const std::size_t n = states.size();
+  std::vector<std::uint8_t> keep(n, 1);
+  if (n < 3) {
+    return keep;
+  }
+
+  struct entry {
+    double area;
+    std::size_t index;
+    std::uint32_t version;
+
+    bool operator>(const entry& other) const {
+      return area > other.area;
+    }
+  };
+
+  // Doubled areas avoid a multiplication per triangle.
+  const double threshold = 2.0 * min_area;
+  std::vector<std::size_t> previous(n);
+  std::vector<std::size_t> next(n);
+  std::vector<std::uint32_t> version(n, 0);
+  std::vector<entry> heap_storage;
+  heap_storage.reserve(n);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    previous[i] = i - 1;
+    next[i] = i + 1;
+    heap_storage.push_back({double_triangle_area(states[i - 1], states[i], states[i + 1]), i, 0});
+  }
+  std::priority_queue<entry, std::vector<entry>, std::greater<>> heap(std::greater<>{},
+                                                                      std::move(heap_storage));
+
+  while (!heap.empty()) {
+    const entry smallest = heap.top();
+    if (smallest.area >= threshold) {
+      break;
+    }
+    heap.pop();
+    const std::size_t i = smallest.index;
+    if (keep[i] == 0 || smallest.version != version[i]) {
+      continue; // stale entry
+    }
+
+    keep[i] = 0;
+    const std::size_t before = previous[i];
+    const std::size_t after = next[i];
+    next[before] = after;
+    previous[after] = before;
+
+    // Neighbors never drop below the removed area, so removal order stays monotonic.
+    for (const std::size_t neighbor : {before, after}) {
+      if (neighbor == 0 || neighbor + 1 == n) {
+        continue;
+      }
+      const double area = double_triangle_area(states[previous[neighbor]], states[neighbor],
+                                               states[next[neighbor]]);
+      heap.push({area < smallest.area ? smallest.area : area, neighbor, ++version[neighbor]});
+    }
+  }
+  return keep;
+}
+
+/// Marks the states kept by greedy shortcutting.
+template <typename TState, typename SegmentFree>
+std::vector<std::uint8_t> shortcut_flags(span<const TState> states, SegmentFree&& segment_free) {
+  const std::size_t n = states.size();
+  std::vector<std::uint8_t> keep(n, 0);
+  if (n == 0) {
+    return keep;
+  }
+  keep.front() = 1;
+  keep.back() = 1;
+  std::size_t anchor = 0;
+  for (std::size_t i = 2; i < n; ++i) {
+    if (!segment_free(states[anchor], states[i])) {
+      // The previous state is the farthest one that can be reached directly.
+      anchor = i - 1;
+      keep[anchor] = 1;
+    }
+  }
+  return keep;
+}
+
+} // namespace detail
+
+/** Simplifies a polyline with the Douglas-Peucker algorithm.
+ *
+ *  Recursively keeps the state farthest from the chord between two kept states as long as
+ *  its distance exceeds @p tolerance. The recursion is implemented with an explicit stack.
+ *
+ *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+ *  @tparam OutIt Output iterator receiving the indices (std::size_t) of the kept states in
+ *          ascending order.
+ *  @param states The states to simplify.
+ *  @param tolerance Maximum distance of a dropped state to the simplified polyline.
+ *  @param out Output iterator for the kept indices.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename OutIt>
+std::size_t douglas_peucker_indices(span<const TState> states, double tolerance, OutIt out) {
+  return detail::emit_kept_indices(detail::douglas_peucker_flags(states, tolerance), out);
+}
+
+/** Simplifies a polyline with the Douglas-Peucker algorithm.
+ *
+ *  @see douglas_peucker_indices for details.
+ *
+ *  @param states The states to simplify.
+ *  @param tolerance Maximum distance of a dropped state to the simplified polyline.
+ *  @param out Output iterator receiving copies of the kept states, in order.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename OutIt>
+std::size_t douglas_peucker(span<const TState> states, double tolerance, OutIt out) {
+  return detail::emit_kept_states(states, detail::douglas_peucker_flags(states, tolerance), out);
+}
+
+/** Simplifies a polyline with the Visvalingam-Whyatt algorithm.
+ *
+ *  Repeatedly drops the state whose triangle with its current neighbors has the smallest
+ *  area, as long as that area is below @p min_area. Runs in O(n log n).
+ *
+ *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+ *  @tparam OutIt Output iterator receiving the indices (std::size_t) of the kept states in
+ *          ascending order.
+ *  @param states The states to simplify.
+ *  @param min_area Triangle area (in squared length units) below which states are dropped.
+ *  @param out Output iterator for the kept indices.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename OutIt>
+std::size_t visvalingam_whyatt_indices(span<const TState> states, double min_area, OutIt out) {
+  return detail::emit_kept_indices(detail::visvalingam_whyatt_flags(states, min_area), out);
+}
+
+/** Simplifies a polyline with the Visvalingam-Whyatt algorithm.
+ *
+ *  @see visvalingam_whyatt_indices for details.
+ *
+ *  @param states The states to simplify.
+ *  @param min_area Triangle area (in squared length units) below which states are dropped.
+ *  @param out Output iterator receiving copies of the kept states, in order.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename OutIt>
+std::size_t visvalingam_whyatt(span<const TState> states, double min_area, OutIt out) {
+  return detail::emit_kept_states(states, detail::visvalingam_whyatt_flags(states, min_area),
+                                  out);
+}
+
+/** Shortens a polyline by connecting states directly where a collision check allows it.
+ *
+ *  Starting at the first state, extends a straight segment over the following states as long
+ *  as @p segment_free accepts it, keeps the last state that could be reached and continues
+ *  from there. The segments between consecutive input states are assumed to be free. Needs
+ *  one collision check per input state.
+ *
+ *  @tparam TState State type.
+ *  @tparam SegmentFree Callable invoked as <tt>segment_free(a, b)</tt> with two states, returns
+ *          @c true if the straight segment between them is collision free, e.g. a lambda that
+ *          forwards to @ref env::ray_caster::segment_free.
+ *  @tparam OutIt Output iterator receiving the indices (std::size_t) of the kept states in
+ *          ascending order.
+ *  @param states The states to shorten.
+ *  @param segment_free The collision check.
+ *  @param out Output iterator for the kept indices.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename SegmentFree, typename OutIt>
+std::size_t shortcut_indices(span<const TState> states, SegmentFree&& segment_free, OutIt out) {
+  return detail::emit_kept_indices(detail::shortcut_flags(states, segment_free), out);
+}
+
+/** Shortens a polyline by connecting states directly where a collision check allows it.
+ *
+ *  @see shortcut_indices for details.
+ *
+ *  @param states The states to shorten.
+ *  @param segment_free The collision check.
+ *  @param out Output iterator receiving copies of the kept states, in order.
+ *  @returns the number of kept states.
+ */
+template <typename TState, typename SegmentFree, typename OutIt>
+std::size_t shortcut(span<const TState> states, SegmentFree&& segment_free, OutIt out) {
+  return detail::emit_kept_states(states, detail::shortcut_flags(states, segment_free), out);
+}
+
+// forwarding overloads to help template deduction when caller has span<TState>.
+template <typename TState, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+douglas_peucker_indices(span<TState> states, double tolerance, OutIt out) {
+  return douglas_peucker_indices(span<const TState>(states), tolerance, out);
+}
+
+template <typename TState, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+douglas_peucker(span<TState> states, double tolerance, OutIt out) {
+  return douglas_peucker(span<const TState>(states), tolerance, out);
+}
+
+template <typename TState, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+visvalingam_whyatt_indices(span<TState> states, double min_area, OutIt out) {
+  return visvalingam_whyatt_indices(span<const TState>(states), min_area, out);
+}
+
+template <typename TState, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+visvalingam_whyatt(span<TState> states, double min_area, OutIt out) {
+  return visvalingam_whyatt(span<const TState>(states), min_area, out);
+}
+
+template <typename TState, typename SegmentFree, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+shortcut_indices(span<TState> states, SegmentFree&& segment_free, OutIt out) {
+  return shortcut_indices(span<const TState>(states), segment_free, out);
+}
+
+template <typename TState, typename SegmentFree, typename OutIt>
+std::enable_if_t<!std::is_const_v<TState>, std::size_t>
+shortcut(span<TState> states, SegmentFree&& segment_free, OutIt out) {
+  return shortcut(span<const TState>(states), segment_free, out);
+}
+
+} // namespace trailblaze::simplify
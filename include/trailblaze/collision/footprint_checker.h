@@ -0,0 +1,308 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/math/angle.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze::collision {
+
+/// A cell of a footprint mask, relative to the cell that contains the reference point.
+struct mask_cell {
+  std::int32_t dx;
+  std::int32_t dy;
+  /// dx^2 + dy^2
+  std::int64_t squared_length;
+};
+
+/** Collision checker for a polygonal robot footprint on an occupancy grid.
+ *
+ *  For every yaw bin, the footprint is rasterized into a mask of grid cells that it may touch
+ *  when its reference point lies anywhere in a cell and its yaw anywhere in the bin, so masks
+ *  are conservative. A state collides if a cell of its mask is occupied or outside of the
+ *  grid.
+ *
+ *  Most states are decided without the mask by the distance @c d of their cell to the closest
+ *  occupied cell, taken from a distance field of the same grid:
+ *  - If @c d exceeds the mask radius (a circumscribed circle), no mask cell can be occupied.
+ *  - If the closest occupied cell lies within the inscribed circle of the footprint, the
+ *    state collides.
+ *  Only states in the narrow band between the two circles scan their mask, starting from its
+ *  rim and stopping at cells that are closer than @c d, as those cannot be occupied.
+ *
+ *  Sequences of states are checked as a swept footprint: the motion between two consecutive
+ *  states is sampled at intermediate poses at most one cell and one yaw bin apart, so that
+ *  sparse samples do not jump over thin obstacles.
+ *
+ *  The checker keeps references to the grid and the distance field, which must outlive it
+ *  and must be kept consistent with each other.
+ *
+ *  @tparam TCell The cell type of the occupancy grid.
+ */
+template <typename TCell>
+class footprint_checker {
+public:
+  /** Constructor
+   *  @param footprint Vertices of the footprint polygon in the robot frame. The reference point
+   *         of a state is the origin of this frame.
+   *  @param grid The occupancy grid.
+   *  @param field A distance field of @p grid, e.g. an @ref env::distance_field.
+   *  @param yaw_bin_count The number of yaw bins.
+   *  @throws std::invalid_argument if the footprint has less than 3 vertices, there are no yaw
+   *          bins or the geometries of @p grid and @p field differ.
+   */
+  footprint_checker(span<const state_r2> footprint, const env::occupancy_grid<TCell>& grid,
+                    const env::distance_grid& field, std::size_t yaw_bin_count = 64)
+      : grid_(grid), field_(field), yaw_bin_count_(yaw_bin_count) {
+    if (footprint.size() < 3) {
+      throw std::invalid_argument("footprint_checker: the footprint needs at least 3 vertices!");
+    }
+    if (yaw_bin_count == 0) {
+      throw std::invalid_argument("footprint_checker: at least one yaw bin is required!");
+    }
+    if (grid.width() != field.width() || grid.height() != field.height() ||
+        grid.resolution() != field.resolution() || grid.origin().x != field.origin().x ||
+        grid.origin().y != field.origin().y) {
+      throw std::invalid_argument("footprint_checker: grid and distance field differ!");
+    }
+
+    const state_r2 reference{0.0, 0.0};
+    circumscribed_radius_ = 0.0;
+    inscribed_radius_ = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0, j = footprint.size() - 1; i < footprint.size(); j = i++) {
+      circumscribed_radius_ =
+          std::max(circumscribed_radius_, std::hypot(footprint[i].x, footprint[i].y));
+      inscribed_radius_ =
+          std::min(inscribed_radius_, segment_distance(reference, footprint[j], footprint[i]));
+    }
+    if (!polygon_contains(footprint, reference)) {
+      inscribed_radius_ = 0.0;
+    }
+    build_masks(footprint);
+  }
+
+  /// @returns the number of yaw bins.
+  [[__nodiscard__]] std::size_t yaw_bin_count() const noexcept {
+    return yaw_bin_count_;
+  }
+
+  /// @returns the radius of the largest circle around the reference point inside the footprint.
+  [[__nodiscard__]] double inscribed_radius() const noexcept {
+    return inscribed_radius_;
+  }
+
+  /// @returns the radius of the smallest circle around the reference point that contains the
+  ///          footprint.
+  [[__nodiscard__]] double circumscribed_radius() const noexcept {
+    return circumscribed_radius_;
+  }
+
+  /// @returns the yaw bin of @p yaw. Bin @c b is centered at the yaw <tt>b * 2 Pi / count</tt>.
+  [[__nodiscard__]] std::size_t yaw_bin(double yaw) const noexcept {
+    const auto count = static_cast<std::int64_t>(yaw_bin_count_);
+    const double bin_width = numbers::two_pi / static_cast<double>(yaw_bin_count_);
+    // normalized() maps to [-Pi, Pi), negative bins wrap around.
+    const auto bin = static_cast<std::int64_t>(std::floor(normalized(yaw) / bin_width + 0.5));
+    return static_cast<std::size_t>((bin % count + count) % count);
+  }
+
+  /// @returns the mask of yaw bin @p bin, sorted by decreasing length of the cell offsets.
+  [[__nodiscard__]] span<const mask_cell> mask(std::size_t bin) const noexcept {
+    return span<const mask_cell>(cells_.data() + mask_offsets_[bin],
+                                 mask_offsets_[bin + 1] - mask_offsets_[bin]);
+  }
+
+  /** Checks a single state.
+   *  @tparam TState State type. Must satisfy the predicates @e has_xy_v and @e has_yaw_v.
+   *  @param state The state to check.
+   *  @returns @c true if the footprint at @p state may touch an occupied cell or leave the
+   *           grid.
+   */
+  template <typename TState>
+  [[__nodiscard__]] bool collides(const TState& state) const noexcept {
+    static_assert(has_xy_v<TState> && has_yaw_v<TState>,
+                  "footprint_checker: TState must have components x, y & yaw");
+    const env::cell_index cell = grid_.cell_of(state.x, state.y);
+    if (!grid_.contains(cell)) {
+      return true;
+    }
+    const std::size_t bin = yaw_bin(state.yaw);
+    const span<const mask_cell> cells = mask(bin);
+    const bool interior = cell.x >= reach_ && cell.y >= reach_ &&
+                          cell.x + reach_ < static_cast<std::int64_t>(grid_.width()) &&
+                          cell.y + reach_ < static_cast<std::int64_t>(grid_.height());
+    if (!interior) {
+      // The mask may leave the grid, which the distance field does not know about.
+      return scan(cell, cells, -1.0);
+    }
+
+    // Occupied cell centers are at least this far away (in cells) from the center of `cell`.
+    const double distance = field_.distance(cell) / grid_.resolution();
+    const double squared_distance = distance * distance;
+    // Broad phase, circumscribed circle: all mask cells are closer than any occupied cell.
+    if (static_cast<double>(cells.front().squared_length) + 0.5 < squared_distance) {
+      return false;
+    }
+    // Broad phase, inscribed circle: the reference point is at most half a cell diagonal away
+    // from the cell center, so the closest occupied cell center lies inside the footprint.
+    if ((distance + std::sqrt(0.5)) * grid_.resolution() < inscribed_radius_) {
+      return true;
+    }
+    return scan(cell, cells, squared_distance);
+  }
+
+  /** Checks the motion between two states.
+   *
+   *  Position and yaw are interpolated linearly, the yaw along the shorter direction. The
+   *  intermediate poses are at most one cell and one yaw bin apart, so the masks of
+   *  consecutive poses overlap and cover the swept footprint.
+   *
+   *  @tparam TState State type. Must satisfy the predicates @e has_xy_v and @e has_yaw_v.
+   *  @param from The state the motion starts at, which is not checked itself.
+   *  @param to The state the motion ends at.
+   *  @returns @c true if an intermediate pose or @p to collides, see @ref collides.
+   */
+  template <typename TState>
+  [[__nodiscard__]] bool motion_collides(const TState& from, const TState& to) const noexcept {
+    if (collides(to)) {
+      return true;
+    }
+    const double dx = to.x - from.x;
+    const double dy = to.y - from.y;
+    const double dyaw = normalized(to.yaw - from.yaw);
+    const double bin_width = numbers::two_pi / static_cast<double>(yaw_bin_count_);
+    const double count = std::ceil(
+        std::max(std::hypot(dx, dy) / grid_.resolution(), std::abs(dyaw) / bin_width));
+    // A pose outside of the grid ends the loop, so a distant @p from stops at its first step.
+    TState pose = from;
+    for (double j = 1.0; j < count; j += 1.0) {
+      const double t = j / count;
+      pose.x = from.x + t * dx;
+      pose.y = from.y + t * dy;
+      pose.yaw = from.yaw + t * dyaw;
+      if (collides(pose)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Finds the first collision along a sequence of states, see @ref motion_collides.
+   *  @tparam TState State type. Must satisfy the predicates @e has_xy_v and @e has_yaw_v.
+   *  @param states The states to check.
+   *  @returns the index of the first state that collides or whose motion from its predecessor
+   *           collides, or @c states.size() if there is no collision.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_collision(span<const TState> states) const noexcept {
+    if (states.empty() || collides(states[0])) {
+      return 0;
+    }
+    for (std::size_t i = 1; i < states.size(); ++i) {
+      if (motion_collides(states[i - 1], states[i])) {
+        return i;
+      }
+    }
+    return states.size();
+  }
+
+  /// @see first_collision(span<const TState>) const
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_collision(const path<TState>& states) const noexcept {
+    return first_collision(states.states());
+  }
+
+private:
+  /// Checks the mask cells around @p cell that are at least sqrt(@p skip_below) cells away.
+  [[__nodiscard__]] bool scan(const env::cell_index& cell, span<const mask_cell> cells,
+                              double skip_below) const noexcept {
+    for (const mask_cell& offset : cells) {
+      if (static_cast<double>(offset.squared_length) + 0.5 < skip_below) {
+        // This and all further cells are closer than the closest occupied cell.
+        return false;
+      }
+      const env::cell_index neighbor{cell.x + offset.dx, cell.y + offset.dy};
+      if (grid_.is_occupied_value(grid_.value(neighbor))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void build_masks(span<const state_r2> footprint) {
+    const double resolution = grid_.resolution();
+    const double bin_width = numbers::two_pi / static_cast<double>(yaw_bin_count_);
+    // Largest displacement of a footprint point when the yaw deviates by half a bin, in cells.
+    const double yaw_margin =
+        2.0 * circumscribed_radius_ * std::sin(0.25 * bin_width) / resolution;
+    const auto extent = static_cast<std::int32_t>(
+        std::ceil(circumscribed_radius_ / resolution + yaw_margin + 1.0));
+
+    std::vector<state_r2> rotated(footprint.size());
+    mask_offsets_.assign(1, 0);
+    reach_ = 0;
+    for (std::size_t bin = 0; bin < yaw_bin_count_; ++bin) {
+      const double yaw = static_cast<double>(bin) * bin_width;
+      const double c = std::cos(yaw);
+      const double s = std::sin(yaw);
+      for (std::size_t i = 0; i < footprint.size(); ++i) {
+        rotated[i] = {(c * footprint[i].x - s * footprint[i].y) / resolution,
+                      (s * footprint[i].x + c * footprint[i].y) / resolution};
+      }
+      const std::size_t first = cells_.size();
+      for (std::int32_t dy = -extent; dy <= extent; ++dy) {
+        for (std::int32_t dx = -extent; dx <= extent; ++dx) {
+          // The reference point lies anywhere in its cell, so a footprint point p hits cell
+          // offset (dx, dy) if p lies in [dx - 1, dx + 1] x [dy - 1, dy + 1] relative to the
+          // lower corner of the reference cell.
+          const box2d box{dx - 1.0 - yaw_margin, dy - 1.0 - yaw_margin, dx + 1.0 + yaw_margin,
+                          dy + 1.0 + yaw_margin};
+          if (polygon_intersects_box(span<const state_r2>(rotated), box)) {
+            cells_.push_back({dx, dy, std::int64_t{dx} * dx + std::int64_t{dy} * dy});
+            reach_ = std::max<std::int64_t>(reach_, std::max(std::abs(dx), std::abs(dy)));
+          }
+        }
+      }
+      std::sort(cells_.begin() + static_cast<std::ptrdiff_t>(first), cells_.end(),
+                [](const mask_cell& a, const mask_cell& b) {
+                  return a.squared_length > b.squared_length;
+                });
+      mask_offsets_.push_back(cells_.size());
+    }
+  }
+
+  /// The occupancy grid.
+  const env::occupancy_grid<TCell>& grid_;
+  /// Distance field of the grid.
+  const env::distance_grid& field_;
+  /// Number of yaw bins.
+  std::size_t yaw_bin_count_;
+  /// Radius of the inscribed circle, 0 if the reference point lies outside of the footprint.
+  double inscribed_radius_{0.0};
+  /// Radius of the circumscribed circle.
+  double circumscribed_radius_{0.0};
+  /// Largest cell offset of all masks in x or y direction.
+  std::int64_t reach_{0};
+  /// Cells of all masks.
+  std::vector<mask_cell> cells_;
+  /// Mask @c b consists of cells_[mask_offsets_[b], mask_offsets_[b + 1]).
+  std::vector<std::size_t> mask_offsets_;
+};
+
+} // namespace trailblaze::collision
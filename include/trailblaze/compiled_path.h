@@ -0,0 +1,223 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "trailblaze/math/angle.h"
+#include "trailblaze/math/interpolation.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_space.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze {
+
+namespace detail {
+
+/// Whether @c state_space<TState> defines an @c interpolation_type.
+template <typename TState, typename = void>
+struct has_state_space_interpolation : std::false_type {};
+
+template <typename TState>
+struct has_state_space_interpolation<
+    TState, std::void_t<typename state_space<TState>::interpolation_type>> : std::true_type {};
+
+} // namespace detail
+
+/** A path prepared for fast repeated interpolation.
+ *
+ *  All quantities that the state space interpolation derives from a segment's end points are
+ *  computed once per segment and stored in separate arrays per component (structure of
+ *  arrays): the start values and deltas of x, y (and z), the start yaw and the shortest yaw
+ *  difference, and the slerp constants of quaternion rotations. Evaluating a segment is then
+ *  a multiply-add per component, without the @c std::fmod of @ref normalized, or any
+ *  @c atan2 or @c acos.
+ *
+ *  The results match the default interpolation of the built-in state spaces up to rounding:
+ *  linear interpolation of positions, shortest arc interpolation of yaw and spherical linear
+ *  interpolation of the @c rotation quaternion. The built-in states consist of these
+ *  components only. Other states without a state space get the same interpolation, and their
+ *  remaining components are copied from the segment end state, like
+ *  @ref interpolation_composition does. States whose @c state_space defines another
+ *  @c interpolation_type are not compiled, their segments are evaluated with that
+ *  interpolation.
+ *
+ *  Paths are evaluated at a global parameter s in [0, segment_count()], where the integer
+ *  part selects the segment and the fractional part is the interpolation ratio. The state
+ *  with index i is located at s = i.
+ *
+ *  @tparam TState The state type. Must satisfy the predicate @e has_xy_v.
+ */
+template <typename TState>
+class compiled_path {
+  static_assert(has_xy_v<TState>, "compiled_path: TState must have components x & y");
+
+  /// The built-in states have no components besides the interpolated ones.
+  static constexpr bool interpolates_all_components =
+      std::is_same_v<TState, state_r2> || std::is_same_v<TState, state_se2>;
+  /// Other state spaces keep their own interpolation.
+  static constexpr bool uses_state_space =
+      !interpolates_all_components && detail::has_state_space_interpolation<TState>::value;
+
+public:
+  /** Precomputes the segments of a path.
+   *  @param states The states of the path.
+   *  @throws std::invalid_argument if fewer than two states are given.
+   */
+  explicit compiled_path(span<const TState> states) : segment_count_(states.size() - 1) {
+    if (states.size() < 2) {
+      throw std::invalid_argument("compiled_path requires at least two states");
+    }
+    if constexpr (!interpolates_all_components) {
+      states_.assign(states.begin(), states.end());
+    }
+    if constexpr (!uses_state_space) {
+      compile(states);
+    }
+  }
+
+  /// @see compiled_path(span<const TState>)
+  explicit compiled_path(const path<TState>& input) : compiled_path(input.states()) {}
+
+  /// @returns the number of segments, i.e. the upper bound of the parameter range.
+  [[__nodiscard__]] std::size_t segment_count() const noexcept {
+    return segment_count_;
+  }
+
+  /** Interpolates within one segment.
+   *  @param segment The segment index, in [0, segment_count()).
+   *  @param t The interpolation ratio. Values outside of [0, 1] extrapolate.
+   *  @returns the interpolated state.
+   */
+  [[__nodiscard__]] TState evaluate(std::size_t segment, double t) const {
+    assert(segment < segment_count());
+    if constexpr (uses_state_space) {
+      return typename state_space<TState>::interpolation_type{}(states_[segment],
+                                                                states_[segment + 1], t);
+    } else if constexpr (interpolates_all_components) {
+      TState out;
+      write(segment, t, out);
+      return out;
+    } else {
+      TState out = states_[segment + 1];
+      write(segment, t, out);
+      return out;
+    }
+  }
+
+  /** Interpolates at a global parameter.
+   *  @param s The parameter, see class description. Values outside of the parameter range
+   *         extrapolate the first or last segment.
+   *  @returns the interpolated state.
+   */
+  [[__nodiscard__]] TState evaluate(double s) const {
+    const double last = static_cast<double>(segment_count() - 1);
+    // NaN fails both comparisons and selects the first segment, the result is NaN then.
+    const double segment = s > last ? last : (s >= 0.0 ? std::floor(s) : 0.0);
+    return evaluate(static_cast<std::size_t>(segment), s - segment);
+  }
+
+  /** Interpolates at many global parameters.
+   *  @param params The parameters, see class description.
+   *  @param out Receives one state per parameter. Must hold at least @c params.size() states.
+   */
+  void evaluate(span<const double> params, span<TState> out) const {
+    assert(out.size() >= params.size());
+    const double last = static_cast<double>(segment_count() - 1);
+    for (std::size_t k = 0; k < params.size(); ++k) {
+      const double s = params[k];
+      const double segment = s > last ? last : (s >= 0.0 ? std::floor(s) : 0.0);
+      const auto index = static_cast<std::size_t>(segment);
+      if constexpr (interpolates_all_components) {
+        write(index, s - segment, out[k]);
+      } else {
+        out[k] = evaluate(index, s - segment);
+      }
+    }
+  }
+
+private:
+  void compile(span<const TState> states) {
+    const std::size_t segments = segment_count_;
+    x0_.resize(segments);
+    dx_.resize(segments);
+    y0_.resize(segments);
+    dy_.resize(segments);
+    if constexpr (has_xyz_v<TState>) {
+      z0_.resize(segments);
+      dz_.resize(segments);
+    }
+    if constexpr (has_yaw_v<TState>) {
+      yaw0_.resize(segments);
+      dyaw_.resize(segments);
+    }
+    if constexpr (has_quat_v<TState>) {
+      rotations_.reserve(segments);
+    }
+
+    for (std::size_t i = 0; i < segments; ++i) {
+      const TState& a = states[i];
+      const TState& b = states[i + 1];
+      x0_[i] = a.x;
+      dx_[i] = b.x - a.x;
+      y0_[i] = a.y;
+      dy_[i] = b.y - a.y;
+      if constexpr (has_xyz_v<TState>) {
+        z0_[i] = a.z;
+        dz_[i] = b.z - a.z;
+      }
+      if constexpr (has_yaw_v<TState>) {
+        yaw0_[i] = normalized(a.yaw);
+        dyaw_[i] = normalized(b.yaw - a.yaw);
+      }
+      if constexpr (has_quat_v<TState>) {
+        rotations_.emplace_back(a.rotation, b.rotation);
+      }
+    }
+  }
+
+  /// Overwrites the interpolated components of @p out.
+  void write(std::size_t i, double t, TState& out) const {
+    out.x = x0_[i] + t * dx_[i];
+    out.y = y0_[i] + t * dy_[i];
+    if constexpr (has_xyz_v<TState>) {
+      out.z = z0_[i] + t * dz_[i];
+    }
+    if constexpr (has_yaw_v<TState>) {
+      // Start yaw and difference are both normalized, so for t in [0, 1] the sum is at most
+      // one turn off the target range.
+      const double yaw = yaw0_[i] + t * dyaw_[i];
+      out.yaw = (t >= 0.0 && t <= 1.0) ? normalized_near(yaw) : normalized(yaw);
+    }
+    if constexpr (has_quat_v<TState>) {
+      out.rotation = rotations_[i](t);
+    }
+  }
+
+  /// Number of segments.
+  std::size_t segment_count_;
+  /// The states of the path, which provide the components that are not compiled. Empty for
+  /// the built-in states.
+  std::vector<TState> states_;
+  /// Start value and delta of x per segment.
+  std::vector<double> x0_, dx_;
+  /// Start value and delta of y per segment.
+  std::vector<double> y0_, dy_;
+  /// Start value and delta of z per segment (only used for states with z).
+  std::vector<double> z0_, dz_;
+  /// Normalized start yaw and shortest yaw difference per segment (only for states with yaw).
+  std::vector<double> yaw0_, dyaw_;
+  /// Slerp constants per segment (only for states with a rotation quaternion).
+  std::vector<quaternion_slerp> rotations_;
+};
+
+} // namespace trailblaze
@@ -6,6 +6,9 @@
 
 #include <ostream>
 #include <type_traits>
+#include <utility>
+
+#include "trailblaze/span.h"
 
 namespace trailblaze::detail {
 
@@ -19,4 +22,47 @@ struct is_ostream_insertable<
     T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>>
     : std::true_type {};
 
+// Primary template: interpolation piece without a batch implementation.
+template <typename Piece, typename TState, typename = void>
+struct has_apply_batch : std::false_type {};
+
+// Specialization: valid if `Piece::apply_batch(a, b, ratios, out)` is well-formed.
+template <typename Piece, typename TState>
+struct has_apply_batch<
+    Piece, TState,
+    std::void_t<decltype(Piece::apply_batch(
+        std::declval<const TState&>(), std::declval<const TState&>(),
+        std::declval<span<const double>>(), std::declval<span<TState>>()))>> : std::true_type {};
+
+// Primary template: interpolator that only supports single ratios.
+template <typename TInterpolation, typename TState, typename = void>
+struct is_batch_interpolator : std::false_type {};
+
+// Specialization: valid if `interpolator(a, b, ratios, out)` is well-formed.
+template <typename TInterpolation, typename TState>
+struct is_batch_interpolator<
+    TInterpolation, TState,
+    std::void_t<decltype(std::declval<TInterpolation&>()(
+        std::declval<const TState&>(), std::declval<const TState&>(),
+        std::declval<span<const double>>(), std::declval<span<TState>>()))>> : std::true_type {};
+
+// Primary template: curve that is evaluated one parameter at a time.
+template <typename Curve, typename TState, typename = void>
+struct is_batch_curve : std::false_type {};
+
+// Specialization: valid if `curve(parameters, out)` is well-formed.
+template <typename Curve, typename TState>
+struct is_batch_curve<Curve, TState,
+                      std::void_t<decltype(std::declval<const Curve&>()(
+                          std::declval<span<const double>>(), std::declval<span<TState>>()))>>
+    : std::true_type {};
+
+// Primary template: not a span.
+template <typename T>
+struct is_span : std::false_type {};
+
+// Specialization: any span.
+template <typename T>
+struct is_span<span<T>> : std::true_type {};
+
 } // namespace trailblaze::detail
@@ -0,0 +1,332 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze::env {
+
+/** Distances of the cells of a grid to the closest occupied cell, with clearance lookups.
+ *
+ *  Distances are measured between cell centers, in world units, and are 0 for occupied cells.
+ *  If there is no occupied cell at all, every distance is infinite. Positions outside of the
+ *  grid have clearance 0, like the occupancy grid treats them as occupied.
+ *
+ *  This is the common base of @ref distance_field and @ref dynamic_distance_field, which
+ *  differ in how they compute the distances.
+ */
+class distance_grid {
+public:
+  /// @returns the number of cells in x direction.
+  [[__nodiscard__]] std::size_t width() const noexcept {
+    return width_;
+  }
+
+  /// @returns the number of cells in y direction.
+  [[__nodiscard__]] std::size_t height() const noexcept {
+    return height_;
+  }
+
+  /// @returns the edge length of a cell.
+  [[__nodiscard__]] double resolution() const noexcept {
+    return resolution_;
+  }
+
+  /// @returns the position of the corner of cell (0, 0).
+  [[__nodiscard__]] const state_r2& origin() const noexcept {
+    return origin_;
+  }
+
+  /// @returns the distance of @p cell to the closest occupied cell, 0 outside of the grid.
+  [[__nodiscard__]] double distance(const cell_index& cell) const noexcept {
+    if (cell.x < 0 || cell.y < 0 || static_cast<std::uint64_t>(cell.x) >= width_ ||
+        static_cast<std::uint64_t>(cell.y) >= height_) {
+      return 0.0;
+    }
+    return distances_[static_cast<std::size_t>(cell.y) * width_ +
+                      static_cast<std::size_t>(cell.x)];
+  }
+
+  /// @returns the distances of all cells in row-major order.
+  [[__nodiscard__]] span<const float> distances() const noexcept {
+    return span<const float>(distances_);
+  }
+
+  /** Interpolates the distance field bilinearly between cell centers.
+   *  @param x The x coordinate of the position.
+   *  @param y The y coordinate of the position.
+   *  @returns the clearance at the position, 0 outside of the grid.
+   */
+  [[__nodiscard__]] double clearance(double x, double y) const noexcept {
+    const double grid_x = (x - origin_.x) * inverse_resolution_;
+    const double grid_y = (y - origin_.y) * inverse_resolution_;
+    // Written so that NaN coordinates are outside.
+    if (!(grid_x >= 0.0 && grid_y >= 0.0 && grid_x < static_cast<double>(width_) &&
+          grid_y < static_cast<double>(height_))) {
+      return 0.0;
+    }
+    if (!has_obstacles_) {
+      return std::numeric_limits<double>::infinity();
+    }
+    // Interpolate between the centers of the four closest cells, clamped at the border.
+    const double center_x = std::max(grid_x - 0.5, 0.0);
+    const double center_y = std::max(grid_y - 0.5, 0.0);
+    const auto x0 = std::min(static_cast<std::size_t>(center_x), width_ - 1);
+    const auto y0 = std::min(static_cast<std::size_t>(center_y), height_ - 1);
+    const std::size_t x1 = std::min(x0 + 1, width_ - 1);
+    const std::size_t y1 = std::min(y0 + 1, height_ - 1);
+    const double tx = std::min(center_x - static_cast<double>(x0), 1.0);
+    const double ty = std::min(center_y - static_cast<double>(y0), 1.0);
+
+    const float* row0 = distances_.data() + y0 * width_;
+    const float* row1 = distances_.data() + y1 * width_;
+    const double bottom = row0[x0] + tx * (row0[x1] - row0[x0]);
+    const double top = row1[x0] + tx * (row1[x1] - row1[x0]);
+    return bottom + ty * (top - bottom);
+  }
+
+  /** Looks up the clearance at the positions of a sequence of states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to look up.
+   *  @param out Receives the clearances, see @ref clearance(double, double) const. Must have
+   *         the same size as @p states.
+   */
+  template <typename TState>
+  void clearance(span<const TState> states, span<double> out) const noexcept {
+    static_assert(has_xy_v<TState>, "distance_field: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = clearance(states[i].x, states[i].y);
+    }
+  }
+
+  /// @see clearance(span<const TState>, span<double>) const
+  template <typename TState>
+  void clearance(const path<TState>& states, span<double> out) const noexcept {
+    clearance(states.states(), out);
+  }
+
+protected:
+  /** Constructor, all distances are infinite.
+   *  @param width Number of cells in x direction.
+   *  @param height Number of cells in y direction.
+   *  @param resolution Edge length of a cell.
+   *  @param origin Position of the corner of cell (0, 0).
+   */
+  distance_grid(std::size_t width, std::size_t height, double resolution, const state_r2& origin)
+      : width_(width), height_(height), resolution_(resolution),
+        inverse_resolution_(1.0 / resolution), origin_(origin),
+        distances_(width * height, std::numeric_limits<float>::infinity()) {}
+
+  /// Number of cells in x direction.
+  std::size_t width_;
+  /// Number of cells in y direction.
+  std::size_t height_;
+  /// Edge length of a cell.
+  double resolution_;
+  /// 1 / resolution_
+  double inverse_resolution_;
+  /// Corner of cell (0, 0).
+  state_r2 origin_;
+  /// @c false if the grid has no occupied cell.
+  bool has_obstacles_{false};
+  /// Distances in world units, row-major.
+  std::vector<float> distances_;
+};
+
+/** Euclidean distance field of an occupancy grid, see @ref distance_grid.
+ *
+ *  The field is computed with the exact linear time algorithm of Felzenszwalb and
+ *  Huttenlocher ("Distance Transforms of Sampled Functions", 2012): a pass along the columns
+ *  finds the closest occupied cell within each column, then the lower envelope of parabolas
+ *  along each row combines the columns. Both passes are independent per column block or row
+ *  and are distributed over a @ref thread_pool when one is given.
+ *
+ *  The field uses the geometry (size, resolution, origin) of the grid it is computed from.
+ */
+class distance_field : public distance_grid {
+public:
+  /** Computes the distance field of an occupancy grid.
+   *  @param grid The grid, cells count as occupied according to its threshold.
+   */
+  template <typename TCell>
+  explicit distance_field(const occupancy_grid<TCell>& grid) : distance_field(grid, nullptr) {}
+
+  /** Computes the distance field of an occupancy grid using several threads.
+   *  @param grid The grid, cells count as occupied according to its threshold.
+   *  @param pool The threads that compute the field.
+   */
+  template <typename TCell>
+  distance_field(const occupancy_grid<TCell>& grid, thread_pool& pool)
+      : distance_field(grid, &pool) {}
+
+private:
+  template <typename TCell>
+  distance_field(const occupancy_grid<TCell>& grid, thread_pool* pool)
+      : distance_grid(grid.width(), grid.height(), grid.resolution(), grid.origin()) {
+    const auto run = [pool](std::size_t count, std::size_t grain, auto&& body) {
+      if (pool != nullptr) {
+        pool->parallel_for(count, grain, body);
+      } else {
+        body(std::size_t{0}, count);
+      }
+    };
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    std::vector<std::uint8_t> row_has_obstacle(height_, 0);
+    run(height_, 64, [&](std::size_t begin, std::size_t end) {
+      std::vector<std::uint8_t> occupied(width_);
+      for (std::size_t y = begin; y < end; ++y) {
+        grid.row_occupancy(y, span<std::uint8_t>(occupied));
+        float* row = distances_.data() + y * width_;
+        std::uint8_t any = 0;
+        for (std::size_t x = 0; x < width_; ++x) {
+          row[x] = occupied[x] != 0 ? 0.0F : infinity;
+          any |= occupied[x];
+        }
+        row_has_obstacle[y] = any;
+      }
+    });
+    has_obstacles_ = std::any_of(row_has_obstacle.begin(), row_has_obstacle.end(),
+                                 [](std::uint8_t any) { return any != 0; });
+    if (!has_obstacles_) {
+      return;
+    }
+
+    // Pass 1: distance in cells to the closest occupied cell in the same column. The sweeps
+    // run row by row over a block of columns, so memory is accessed contiguously.
+    constexpr std::size_t column_block = 256;
+    const std::size_t block_count = (width_ + column_block - 1) / column_block;
+    run(block_count, 1, [&](std::size_t begin, std::size_t end) {
+      const std::size_t x_begin = begin * column_block;
+      const std::size_t x_end = std::min(width_, end * column_block);
+      for (std::size_t y = 1; y < height_; ++y) {
+        const float* previous = distances_.data() + (y - 1) * width_;
+        float* row = distances_.data() + y * width_;
+        for (std::size_t x = x_begin; x < x_end; ++x) {
+          row[x] = std::min(row[x], previous[x] + 1.0F);
+        }
+      }
+      for (std::size_t y = height_ - 1; y-- > 0;) {
+        const float* next = distances_.data() + (y + 1) * width_;
+        float* row = distances_.data() + y * width_;
+        for (std::size_t x = x_begin; x < x_end; ++x) {
+          row[x] = std::min(row[x], next[x] + 1.0F);
+        }
+      }
+    });
+
+    // Pass 2: lower envelope of the parabolas (x - q)^2 + column_distance(q)^2 along each row.
+    run(height_, 16, [&](std::size_t begin, std::size_t end) {
+      std::vector<double> squared(width_);
+      std::vector<double> nearest(width_);
+      std::vector<std::size_t> sites(width_);
+      std::vector<double> bounds(width_);
+      for (std::size_t y = begin; y < end; ++y) {
+        float* row = distances_.data() + y * width_;
+        for (std::size_t x = 0; x < width_; ++x) {
+          squared[x] = static_cast<double>(row[x]) * static_cast<double>(row[x]);
+        }
+        const std::size_t site_count = lower_envelope(squared, sites, bounds);
+        std::size_t k = 0;
+        for (std::size_t x = 0; x < width_; ++x) {
+          const double position = static_cast<double>(x);
+          while (k + 1 < site_count && bounds[k + 1] < position) {
+            ++k;
+          }
+          const double dx = position - static_cast<double>(sites[k]);
+          nearest[x] = dx * dx + squared[sites[k]];
+        }
+        // Separate loop without branches, so that the square roots can be vectorized.
+        for (std::size_t x = 0; x < width_; ++x) {
+          row[x] = static_cast<float>(std::sqrt(nearest[x]) * resolution_);
+        }
+      }
+    });
+  }
+
+  /** Computes the lower envelope of the parabolas <tt>(x - q)^2 + squared[q]</tt> for all q
+   *  with a finite value.
+   *  @param squared Squared column distances of one row, at least one is finite.
+   *  @param sites Receives the parabola vertices of the envelope from left to right.
+   *  @param bounds Receives the position from which on each envelope parabola is the lowest.
+   *  @returns the number of parabolas in the envelope.
+   */
+  static std::size_t lower_envelope(const std::vector<double>& squared,
+                                    std::vector<std::size_t>& sites,
+                                    std::vector<double>& bounds) noexcept {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    std::size_t count = 0;
+    for (std::size_t q = 0; q < squared.size(); ++q) {
+      if (squared[q] == infinity) {
+        continue;
+      }
+      const double fq = squared[q] + static_cast<double>(q) * static_cast<double>(q);
+      double intersection = -infinity;
+      while (count > 0) {
+        const std::size_t v = sites[count - 1];
+        const double fv = squared[v] + static_cast<double>(v) * static_cast<double>(v);
+        intersection = (fq - fv) / (2.0 * static_cast<double>(q - v));
+        if (intersection > bounds[count - 1]) {
+          break;
+        }
+        // Parabola v is nowhere the lowest anymore.
+        --count;
+        intersection = -infinity;
+      }
+      sites[count] = q;
+      bounds[count] = intersection;
+      ++count;
+    }
+    return count;
+  }
+};
+
+/** Computes the smallest clearance along a sequence of states.
+ *
+ *  The search stops at the first state whose clearance is <= @p stop_below and returns that
+ *  clearance. With the default of 0, it only stops at states that collide, where the result
+ *  is 0 anyway, so the true minimum is returned.
+ *
+ *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+ *  @param field The distance field, e.g. a @ref distance_field.
+ *  @param states The states to check.
+ *  @param stop_below Clearance at or below which the search stops early.
+ *  @returns the smallest clearance found, infinity for an empty sequence.
+ */
+template <typename TState>
+[[__nodiscard__]] double min_clearance(const distance_grid& field, span<const TState> states,
+                                       double stop_below = 0.0) noexcept {
+  static_assert(has_xy_v<TState>, "min_clearance: TState must have components x & y");
+  double minimum = std::numeric_limits<double>::infinity();
+  for (const auto& state : states) {
+    minimum = std::min(minimum, field.clearance(state.x, state.y));
+    if (minimum <= stop_below) {
+      break;
+    }
+  }
+  return minimum;
+}
+
+/// @see min_clearance(const distance_grid&, span<const TState>, double)
+template <typename TState>
+[[__nodiscard__]] double min_clearance(const distance_grid& field, const path<TState>& states,
+                                       double stop_below = 0.0) noexcept {
+  return min_clearance(field, states.states(), stop_below);
+}
+
+} // namespace trailblaze::env
@@ -0,0 +1,469 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/span.h"
+
+namespace trailblaze::env {
+
+/** Euclidean distance field that is updated incrementally when cells change, see
+ *  @ref distance_grid.
+ *
+ *  Follows the dynamic brushfire algorithm of Lau, Sprunk and Burgard ("Efficient grid-based
+ *  spatial representations for robot navigation in dynamic environments", 2013), but keeps
+ *  the distances exact. Every cell stores its closest occupied cell. Handing an obstacle on
+ *  only to the 8 neighbors that become closer to it misses cells by a fraction of a cell where
+ *  the region of an obstacle is a thin sliver between the cells. Along a digital straight line
+ *  from an obstacle to a cell that has it closest, every cell is at most one cell farther from
+ *  that obstacle than from its own closest one, so the waves continue outwards through all
+ *  cells within this slack:
+ *  - Setting a cell starts a lower wave that hands the new obstacle on to all cells that are
+ *    closer to it, and that passes through the cells within the slack of it.
+ *  - Clearing a cell starts a raise wave through the cells within the slack of it, which
+ *    resets all cells that referred to it. The reset cells are then recomputed exactly with
+ *    the column and row passes of @ref distance_field, restricted to a window around them
+ *    that is widened until it contains the closest obstacle of every reset cell.
+ *
+ *  The cost of an update scales with the changed area and a band around it, not with the size
+ *  of the map.
+ */
+class dynamic_distance_field : public distance_grid {
+public:
+  /** Constructor, all cells are free.
+   *  @param width Number of cells in x direction.
+   *  @param height Number of cells in y direction.
+   *  @param resolution Edge length of a cell.
+   *  @param origin Position of the corner of cell (0, 0).
+   *  @throws std::invalid_argument if @p resolution is not positive or the grid has 2^32 or
+   *          more cells.
+   */
+  dynamic_distance_field(std::size_t width, std::size_t height, double resolution,
+                         const state_r2& origin = {0.0, 0.0})
+      : distance_grid(width, height, resolution, origin), cells_(width * height) {
+    if (!(resolution > 0.0)) {
+      throw std::invalid_argument("dynamic_distance_field: resolution must be positive!");
+    }
+    if (width * height >= no_obstacle) {
+      throw std::invalid_argument("dynamic_distance_field: too many cells!");
+    }
+  }
+
+  /** Constructor, computes the distances of an occupancy grid.
+   *  @param grid The grid, cells count as occupied according to its threshold.
+   */
+  template <typename TCell>
+  explicit dynamic_distance_field(const occupancy_grid<TCell>& grid)
+      : dynamic_distance_field(grid.width(), grid.height(), grid.resolution(), grid.origin()) {
+    std::vector<std::uint8_t> row(width_);
+    for (std::size_t y = 0; y < height_; ++y) {
+      grid.row_occupancy(y, span<std::uint8_t>(row));
+      for (std::size_t x = 0; x < width_; ++x) {
+        if (row[x] != 0) {
+          cells_[y * width_ + x].occupied = true;
+          ++obstacle_count_;
+        }
+      }
+    }
+    has_obstacles_ = obstacle_count_ > 0;
+    reset_.resize(cells_.size());
+    for (std::size_t i = 0; i < reset_.size(); ++i) {
+      reset_[i] = static_cast<std::uint32_t>(i);
+    }
+    recompute();
+  }
+
+  /// @returns @c true if @p cell is occupied, cells outside of the grid count as occupied.
+  [[__nodiscard__]] bool is_occupied(const cell_index& cell) const noexcept {
+    if (!contains(cell)) {
+      return true;
+    }
+    return cells_[index_of(cell)].occupied;
+  }
+
+  /** Applies changes of the occupancy and updates the affected distances.
+   *
+   *  Cells outside of the grid, occupied cells in @p set and free cells in @p cleared are
+   *  ignored. A cell in both lists ends up free.
+   *
+   *  @param set Cells that became occupied.
+   *  @param cleared Cells that became free.
+   *  @returns the number of cells that were processed, a measure for the cost of the update.
+   */
+  std::size_t update(span<const cell_index> set, span<const cell_index> cleared) {
+    std::vector<std::uint32_t> added;
+    for (const cell_index& cell : set) {
+      if (!contains(cell) || cells_[index_of(cell)].occupied) {
+        continue;
+      }
+      const std::uint32_t index = index_of(cell);
+      cells_[index].occupied = true;
+      added.push_back(index);
+      ++obstacle_count_;
+    }
+    std::vector<std::uint32_t> removed;
+    for (const cell_index& cell : cleared) {
+      if (!contains(cell) || !cells_[index_of(cell)].occupied) {
+        continue;
+      }
+      const std::uint32_t index = index_of(cell);
+      cells_[index].occupied = false;
+      // Only obstacles from before this update refer to themselves.
+      if (cells_[index].obstacle == index) {
+        removed.push_back(index);
+      }
+      --obstacle_count_;
+    }
+    has_obstacles_ = obstacle_count_ > 0;
+
+    // The raise waves rely on the distances from before the update, so they run first.
+    std::size_t processed = 0;
+    for (const std::uint32_t index : removed) {
+      processed += raise(index);
+    }
+    processed += recompute();
+
+    for (const std::uint32_t index : added) {
+      cell_data& data = cells_[index];
+      if (data.occupied) {
+        data.squared_distance = 0;
+        data.obstacle = index;
+        distances_[index] = 0.0F;
+        data.queued = index;
+        open_.push({0, index, index});
+      }
+    }
+    entry previous{-1, 0, 0};
+    while (!open_.empty()) {
+      const entry current = open_.top();
+      open_.pop();
+      // Keys only grow along a wave, so duplicates of an entry are popped in a row.
+      if (current == previous) {
+        continue;
+      }
+      previous = current;
+      const auto [key, index, obstacle] = current;
+      if (cells_[index].queued == obstacle) {
+        cells_[index].queued = no_obstacle;
+      }
+      if (!within_slack(key, cells_[index].squared_distance)) {
+        // The cell got a closer obstacle since the entry was pushed.
+        continue;
+      }
+      ++processed;
+      lower(index, obstacle, key);
+    }
+    return processed;
+  }
+
+private:
+  /// Marks cells without a closest obstacle.
+  static constexpr std::uint32_t no_obstacle = std::numeric_limits<std::uint32_t>::max();
+  /// Squared distance of cells without a closest obstacle.
+  static constexpr std::int64_t infinite = std::numeric_limits<std::int64_t>::max();
+  /// How much farther than the closest obstacle a wave may be to pass through a cell, in cells.
+  /// Slightly more than one cell, so rounding of the square roots cannot stop a wave.
+  static constexpr double slack = 1.0 + 1e-6;
+
+  struct cell_data {
+    /// Squared distance in cells to the closest obstacle.
+    std::int64_t squared_distance{infinite};
+    /// Index of the closest obstacle cell, @ref no_obstacle if unknown.
+    std::uint32_t obstacle{no_obstacle};
+    /// Number of the last raise wave that visited the cell.
+    std::uint32_t visit{0};
+    /// Obstacle of the last entry of the cell in the open list that is not popped yet.
+    std::uint32_t queued{no_obstacle};
+    /// The cell itself is occupied.
+    bool occupied{false};
+  };
+
+  /// (squared distance to the obstacle, cell index, obstacle index)
+  using entry = std::tuple<std::int64_t, std::uint32_t, std::uint32_t>;
+
+  [[__nodiscard__]] std::uint32_t index_of(const cell_index& cell) const noexcept {
+    return static_cast<std::uint32_t>(static_cast<std::size_t>(cell.y) * width_ +
+                                      static_cast<std::size_t>(cell.x));
+  }
+
+  /// @returns the squared distance in cells between the cells with indices @p a and @p b.
+  [[__nodiscard__]] std::int64_t squared_distance(std::uint32_t a, std::uint32_t b) const {
+    const std::int64_t dx = static_cast<std::int64_t>(a % width_) -
+                            static_cast<std::int64_t>(b % width_);
+    const std::int64_t dy = static_cast<std::int64_t>(a / width_) -
+                            static_cast<std::int64_t>(b / width_);
+    return dx * dx + dy * dy;
+  }
+
+  /// @returns @c true if an obstacle at @p squared_distance is at most @ref slack farther
+  /// away than the closest obstacle at @p closest.
+  [[__nodiscard__]] static bool within_slack(std::int64_t squared_distance,
+                                             std::int64_t closest) noexcept {
+    return closest == infinite || std::sqrt(static_cast<double>(squared_distance)) <=
+                                      std::sqrt(static_cast<double>(closest)) + slack;
+  }
+
+  /// Calls @p f(neighbor_index) for the up to 8 neighbors of a cell.
+  template <typename F>
+  void for_each_neighbor(std::uint32_t index, F&& f) const {
+    const auto width = static_cast<std::int64_t>(width_);
+    const auto height = static_cast<std::int64_t>(height_);
+    const std::int64_t x = index % width;
+    const std::int64_t y = index / width;
+    for (std::int64_t ny = y - 1; ny <= y + 1; ++ny) {
+      for (std::int64_t nx = x - 1; nx <= x + 1; ++nx) {
+        if ((nx == x && ny == y) || nx < 0 || ny < 0 || nx >= width || ny >= height) {
+          continue;
+        }
+        f(static_cast<std::uint32_t>(ny * width + nx));
+      }
+    }
+  }
+
+  /** Resets all cells whose closest obstacle was cleared, starting at a cleared obstacle.
+   *  @param obstacle Index of the cleared obstacle.
+   *  @returns the number of visited cells.
+   */
+  std::size_t raise(std::uint32_t obstacle) {
+    if (++visit_ == 0) {
+      // The wave numbers wrapped around, forget the old ones.
+      for (cell_data& data : cells_) {
+        data.visit = 0;
+      }
+      visit_ = 1;
+    }
+    std::size_t processed = 0;
+    cells_[obstacle].visit = visit_;
+    stack_.assign(1, obstacle);
+    while (!stack_.empty()) {
+      const std::uint32_t index = stack_.back();
+      stack_.pop_back();
+      ++processed;
+      cell_data& data = cells_[index];
+      if (data.obstacle != no_obstacle && !cells_[data.obstacle].occupied) {
+        data.squared_distance = infinite;
+        data.obstacle = no_obstacle;
+        distances_[index] = std::numeric_limits<float>::infinity();
+        reset_.push_back(index);
+      }
+      const std::int64_t key = squared_distance(index, obstacle);
+      for_each_neighbor(index, [&](std::uint32_t neighbor) {
+        cell_data& next = cells_[neighbor];
+        if (next.visit == visit_) {
+          return;
+        }
+        const std::int64_t distance = squared_distance(neighbor, obstacle);
+        if (distance > key && within_slack(distance, next.squared_distance)) {
+          next.visit = visit_;
+          stack_.push_back(neighbor);
+        }
+      });
+    }
+    return processed;
+  }
+
+  /// Hands @p obstacle on from a cell to the neighbors farther away that are within the slack.
+  void lower(std::uint32_t index, std::uint32_t obstacle, std::int64_t key) {
+    for_each_neighbor(index, [&](std::uint32_t neighbor) {
+      const std::int64_t distance = squared_distance(neighbor, obstacle);
+      if (distance <= key) {
+        return;
+      }
+      cell_data& data = cells_[neighbor];
+      if (distance < data.squared_distance) {
+        data.squared_distance = distance;
+        data.obstacle = obstacle;
+        distances_[neighbor] =
+            static_cast<float>(std::sqrt(static_cast<double>(distance)) * resolution_);
+      }
+      // All entries of a cell and obstacle are pushed before the first one is popped, this
+      // catches most of the duplicates.
+      if (data.queued != obstacle && within_slack(distance, data.squared_distance)) {
+        data.queued = obstacle;
+        open_.push({distance, neighbor, obstacle});
+      }
+    });
+  }
+
+  /** Computes the exact closest obstacle of all cells in @ref reset_ and empties it.
+   *
+   *  Within a window around the cells, a pass along each column finds the closest occupied
+   *  cell in the column, then the lower envelope of parabolas along each row combines the
+   *  columns, like in @ref distance_field. Obstacles within the margin of the window around a
+   *  cell are all seen, cells whose closest obstacle is farther away are computed again with
+   *  twice the margin.
+   *
+   *  @returns the number of computed cells.
+   */
+  std::size_t recompute() {
+    const auto width = static_cast<std::int64_t>(width_);
+    const auto height = static_cast<std::int64_t>(height_);
+    std::size_t processed = 0;
+    std::int64_t margin = 0;
+    while (!reset_.empty()) {
+      std::sort(reset_.begin(), reset_.end());
+      const std::int64_t min_y = reset_.front() / width;
+      const std::int64_t max_y = reset_.back() / width;
+      std::int64_t min_x = width;
+      std::int64_t max_x = 0;
+      for (const std::uint32_t index : reset_) {
+        min_x = std::min<std::int64_t>(min_x, index % width);
+        max_x = std::max<std::int64_t>(max_x, index % width);
+      }
+      margin = std::max({2 * margin, max_x - min_x + 2, max_y - min_y + 2});
+      const std::int64_t left = std::max<std::int64_t>(min_x - margin, 0);
+      const std::int64_t right = std::min(max_x + margin, width - 1);
+      const std::int64_t top = std::max<std::int64_t>(min_y - margin, 0);
+      const std::int64_t bottom = std::min(max_y + margin, height - 1);
+      const bool whole_grid = left == 0 && top == 0 && right == width - 1 && bottom == height - 1;
+
+      // Row of the closest occupied cell in each column of the window, -1 if there is none.
+      const auto columns = static_cast<std::size_t>(right - left + 1);
+      column_rows_.assign(static_cast<std::size_t>(max_y - min_y + 1) * columns, -1);
+      for (std::int64_t x = left; x <= right; ++x) {
+        std::int64_t* rows = column_rows_.data() + (x - left);
+        std::int64_t above = -1;
+        for (std::int64_t y = top; y <= max_y; ++y) {
+          if (cells_[static_cast<std::size_t>(y * width + x)].occupied) {
+            above = y;
+          }
+          if (y >= min_y) {
+            rows[static_cast<std::size_t>(y - min_y) * columns] = above;
+          }
+        }
+        std::int64_t below = -1;
+        for (std::int64_t y = bottom; y >= min_y; --y) {
+          if (cells_[static_cast<std::size_t>(y * width + x)].occupied) {
+            below = y;
+          }
+          if (y > max_y || below < 0) {
+            continue;
+          }
+          std::int64_t& row = rows[static_cast<std::size_t>(y - min_y) * columns];
+          if (row < 0 || below - y < y - row) {
+            row = below;
+          }
+        }
+      }
+
+      sites_.resize(columns);
+      bounds_.resize(columns);
+      unresolved_.clear();
+      for (std::size_t i = 0; i < reset_.size();) {
+        const std::int64_t y = reset_[i] / width;
+        const std::int64_t* rows = column_rows_.data() + static_cast<std::size_t>(y - min_y) *
+                                                             columns;
+        const std::size_t site_count = lower_envelope(rows, columns, y);
+        std::size_t k = 0;
+        for (; i < reset_.size() && reset_[i] / width == y; ++i) {
+          const std::uint32_t index = reset_[i];
+          const std::int64_t x = index % width - left;
+          while (k + 1 < site_count && bounds_[k + 1] < static_cast<double>(x)) {
+            ++k;
+          }
+          std::int64_t distance = infinite;
+          std::uint32_t obstacle = no_obstacle;
+          if (site_count > 0) {
+            const auto site = static_cast<std::int64_t>(sites_[k]);
+            const std::int64_t dy = rows[sites_[k]] - y;
+            distance = (x - site) * (x - site) + dy * dy;
+            obstacle = static_cast<std::uint32_t>(rows[sites_[k]] * width + left + site);
+          }
+          if (!whole_grid && (site_count == 0 || distance > margin * margin)) {
+            // A closer obstacle may lie outside of the window.
+            unresolved_.push_back(index);
+            continue;
+          }
+          cell_data& data = cells_[index];
+          data.squared_distance = distance;
+          data.obstacle = obstacle;
+          distances_[index] =
+              obstacle == no_obstacle
+                  ? std::numeric_limits<float>::infinity()
+                  : static_cast<float>(std::sqrt(static_cast<double>(distance)) * resolution_);
+          ++processed;
+        }
+      }
+      reset_.swap(unresolved_);
+    }
+    return processed;
+  }
+
+  /** Computes the lower envelope of the parabolas <tt>(x - q)^2 + (rows[q] - y)^2</tt> for
+   *  all columns q of the window with an occupied cell into @ref sites_ and @ref bounds_.
+   *  @param rows Row of the closest occupied cell in each column, -1 if there is none.
+   *  @param columns Number of columns of the window.
+   *  @param y The row of the envelope.
+   *  @returns the number of parabolas in the envelope.
+   */
+  std::size_t lower_envelope(const std::int64_t* rows, std::size_t columns, std::int64_t y) {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    const auto height = [&](std::size_t q) {
+      const auto dy = static_cast<double>(rows[q] - y);
+      const auto position = static_cast<double>(q);
+      return dy * dy + position * position;
+    };
+    std::size_t count = 0;
+    for (std::size_t q = 0; q < columns; ++q) {
+      if (rows[q] < 0) {
+        continue;
+      }
+      const double fq = height(q);
+      double intersection = -infinity;
+      while (count > 0) {
+        const std::size_t v = sites_[count - 1];
+        intersection = (fq - height(v)) / (2.0 * static_cast<double>(q - v));
+        if (intersection > bounds_[count - 1]) {
+          break;
+        }
+        // Parabola v is nowhere the lowest anymore.
+        --count;
+        intersection = -infinity;
+      }
+      sites_[count] = q;
+      bounds_[count] = intersection;
+      ++count;
+    }
+    return count;
+  }
+
+  [[__nodiscard__]] bool contains(const cell_index& cell) const noexcept {
+    return cell.x >= 0 && cell.y >= 0 && static_cast<std::uint64_t>(cell.x) < width_ &&
+           static_cast<std::uint64_t>(cell.y) < height_;
+  }
+
+  /// State of all cells, row-major.
+  std::vector<cell_data> cells_;
+  /// Entries of the lower waves, smallest squared distance first.
+  std::priority_queue<entry, std::vector<entry>, std::greater<>> open_;
+  /// Number of occupied cells.
+  std::size_t obstacle_count_{0};
+  /// Number of the last raise wave.
+  std::uint32_t visit_{0};
+  /// Cells the current raise wave still has to visit.
+  std::vector<std::uint32_t> stack_;
+  /// Cells that were reset and have to be recomputed.
+  std::vector<std::uint32_t> reset_;
+  /// Reset cells whose closest obstacle lies outside of the current window.
+  std::vector<std::uint32_t> unresolved_;
+  /// Scratch memory of @ref recompute.
+  std::vector<std::int64_t> column_rows_;
+  std::vector<std::size_t> sites_;
+  std::vector<double> bounds_;
+};
+
+} // namespace trailblaze::env
@@ -0,0 +1,377 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+#include "trailblaze/ragged_buffer.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze::env {
+
+/// A change of the zone membership between two consecutive states of a sequence.
+struct zone_transition {
+  /// Index of the first state after the change.
+  std::size_t index;
+  /// Index of the zone.
+  std::size_t zone;
+  /// @c true if the state at @c index lies inside the zone and its predecessor does not.
+  bool entering;
+};
+
+/** Set of polygonal zones with fast point membership tests.
+ *
+ *  Each zone is covered by its own uniform grid over its bounding box, with about
+ *  @c cells_per_edge cells per polygon edge. Every cell stores the edges that touch it and
+ *  whether its center lies inside the polygon. Cells without edges lie completely inside or
+ *  outside, so most points are classified by a single lookup. For a point in a cell with
+ *  edges, the segment from the cell center to the point lies inside the cell, so counting
+ *  its crossings with the edges of that cell flips the known state of the center into the
+ *  state of the point.
+ *
+ *  The result matches @ref polygon_contains for points that do not lie exactly on an edge.
+ *  Zones may overlap and need not be convex, but must not intersect themselves.
+ */
+class geofence {
+public:
+  /** Constructor, builds the grids.
+   *  @param zones One row of vertices per zone, the last vertex is implicitly connected with
+   *         the first one.
+   *  @param cells_per_edge Number of grid cells per polygon edge. More cells classify more
+   *         points by lookup at the cost of memory.
+   *  @throws std::invalid_argument if a zone has less than 3 vertices or @p cells_per_edge is
+   *          not positive.
+   */
+  explicit geofence(ragged_buffer<state_r2> zones, double cells_per_edge = 2.0)
+      : zones_(std::move(zones)) {
+    if (!(cells_per_edge > 0.0)) {
+      throw std::invalid_argument("geofence: cells_per_edge must be positive!");
+    }
+    for (std::size_t i = 0; i < zones_.size(); ++i) {
+      if (zones_[i].size() < 3) {
+        throw std::invalid_argument("geofence: a zone needs at least 3 vertices!");
+      }
+    }
+    grids_.reserve(zones_.size());
+    for (std::size_t i = 0; i < zones_.size(); ++i) {
+      build_grid(zones_[i], cells_per_edge);
+    }
+  }
+
+  /// @returns the number of zones.
+  [[__nodiscard__]] std::size_t zone_count() const noexcept {
+    return zones_.size();
+  }
+
+  /// @returns the vertices of zone @p index.
+  [[__nodiscard__]] span<const state_r2> zone(std::size_t index) const noexcept {
+    return zones_[index];
+  }
+
+  /** Checks if a point lies inside a zone.
+   *  @param zone Index of the zone.
+   *  @param point The point.
+   *  @returns @c true if @p point lies inside of the zone.
+   */
+  [[__nodiscard__]] bool contains(std::size_t zone, const state_r2& point) const noexcept {
+    const grid& g = grids_[zone];
+    const double fx = (point.x - g.bounds.min_x) * g.inverse_cell_size;
+    const double fy = (point.y - g.bounds.min_y) * g.inverse_cell_size;
+    // Also rejects NaN.
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(g.columns) &&
+          fy < static_cast<double>(g.rows))) {
+      return false;
+    }
+    const auto column = static_cast<std::size_t>(fx);
+    const auto row = static_cast<std::size_t>(fy);
+    const cell& c = cells_[g.first_cell + row * g.columns + column];
+    bool inside = c.center_inside;
+    if (c.edge_count == 0) {
+      return inside;
+    }
+    const state_r2 center{g.bounds.min_x + (static_cast<double>(column) + 0.5) * g.cell_size,
+                          g.bounds.min_y + (static_cast<double>(row) + 0.5) * g.cell_size};
+    const edge* first = edges_.data() + c.first_edge;
+    for (const edge* e = first; e != first + c.edge_count; ++e) {
+      if (crosses(center, point, e->a, e->b)) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+  /** Classifies a sequence of points against one zone.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param zone Index of the zone.
+   *  @param states The points.
+   *  @param out Receives 1 for each point inside of the zone, else 0. Must have the same size
+   *         as @p states.
+   */
+  template <typename TState>
+  void classify(std::size_t zone, span<const TState> states,
+                span<std::uint8_t> out) const noexcept {
+    static_assert(has_xy_v<TState>, "geofence: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = contains(zone, state_r2{states[i].x, states[i].y}) ? 1 : 0;
+    }
+  }
+
+  /** Classifies a sequence of points against one zone in parallel.
+   *  @see classify(std::size_t, span<const TState>, span<std::uint8_t>) const
+   *  @param pool The threads to use.
+   *  @param grain Number of points per task.
+   */
+  template <typename TState>
+  void classify(thread_pool& pool, std::size_t zone, span<const TState> states,
+                span<std::uint8_t> out, std::size_t grain = 4096) const {
+    assert(out.size() == states.size());
+    pool.parallel_for(states.size(), grain, [&](std::size_t begin, std::size_t end) {
+      classify(zone, states.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+  }
+
+  /// @see classify(std::size_t, span<const TState>, span<std::uint8_t>) const
+  template <typename TState>
+  void classify(std::size_t zone, const path<TState>& states,
+                span<std::uint8_t> out) const noexcept {
+    classify(zone, states.states(), out);
+  }
+
+  /** Finds all changes of the zone membership along a sequence of states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states.
+   *  @param out Receives the transitions ordered by state index and zone, previous contents
+   *         are removed.
+   */
+  template <typename TState>
+  void transitions(span<const TState> states, std::vector<zone_transition>& out) const {
+    static_assert(has_xy_v<TState>, "geofence: TState must have components x & y");
+    out.clear();
+    append_transitions(states, 0, out);
+  }
+
+  /** Finds all changes of the zone membership along a sequence of states in parallel.
+   *  @see transitions(span<const TState>, std::vector<zone_transition>&) const
+   *  @param pool The threads to use.
+   *  @param grain Number of states per task.
+   */
+  template <typename TState>
+  void transitions(thread_pool& pool, span<const TState> states,
+                   std::vector<zone_transition>& out, std::size_t grain = 4096) const {
+    static_assert(has_xy_v<TState>, "geofence: TState must have components x & y");
+    out.clear();
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t block_count = (states.size() + grain - 1) / grain;
+    std::vector<std::vector<zone_transition>> blocks(block_count);
+    pool.parallel_for(block_count, 1, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t block = begin; block < end; ++block) {
+        // Each block also looks at the last state of its predecessor.
+        const std::size_t first = block * grain;
+        const std::size_t start = first == 0 ? 0 : first - 1;
+        const std::size_t last = std::min(first + grain, states.size());
+        append_transitions(states.subspan(start, last - start), start, blocks[block]);
+      }
+    });
+    for (const auto& block : blocks) {
+      out.insert(out.end(), block.begin(), block.end());
+    }
+  }
+
+  /// @see transitions(span<const TState>, std::vector<zone_transition>&) const
+  template <typename TState>
+  void transitions(const path<TState>& states, std::vector<zone_transition>& out) const {
+    transitions(states.states(), out);
+  }
+
+private:
+  struct grid {
+    /// Bounding box of the zone.
+    box2d bounds;
+    /// Edge length of a cell.
+    double cell_size;
+    double inverse_cell_size;
+    std::size_t columns;
+    std::size_t rows;
+    /// Index of cell (0, 0) in @c cells_, the cells of a zone are stored row-major.
+    std::size_t first_cell;
+  };
+
+  struct cell {
+    /// Index of the first edge that touches the cell in @c edges_.
+    std::uint32_t first_edge;
+    /// Number of edges that touch the cell.
+    std::uint32_t edge_count;
+    /// The center of the cell lies inside the zone.
+    bool center_inside;
+  };
+
+  struct edge {
+    state_r2 a;
+    state_r2 b;
+  };
+
+  /** Checks if the segment from @p p to @p q crosses the edge from @p a to @p b. Points
+   *  exactly on a line count as lying on its right side, so an edge chain through which the
+   *  segment passes at a vertex is counted once, and one that it only touches zero or two
+   *  times.
+   */
+  [[__nodiscard__]] static bool crosses(const state_r2& p, const state_r2& q, const state_r2& a,
+                                        const state_r2& b) noexcept {
+    const auto left = [](const state_r2& u, const state_r2& v, const state_r2& w) {
+      return (v.x - u.x) * (w.y - u.y) - (v.y - u.y) * (w.x - u.x) > 0.0;
+    };
+    return left(p, q, a) != left(p, q, b) && left(a, b, p) != left(a, b, q);
+  }
+
+  /// Appends the transitions of @p states, whose first element has index @p offset.
+  template <typename TState>
+  void append_transitions(span<const TState> states, std::size_t offset,
+                          std::vector<zone_transition>& out) const {
+    if (states.empty()) {
+      return;
+    }
+    const std::size_t begin = out.size();
+    for (std::size_t zone = 0; zone < zones_.size(); ++zone) {
+      const std::size_t first = out.size();
+      bool previous = contains(zone, state_r2{states[0].x, states[0].y});
+      for (std::size_t i = 1; i < states.size(); ++i) {
+        const bool current = contains(zone, state_r2{states[i].x, states[i].y});
+        if (current != previous) {
+          out.push_back({offset + i, zone, current});
+          previous = current;
+        }
+      }
+      // Merges the transitions of this zone into those of the previous zones.
+      std::inplace_merge(out.begin() + static_cast<std::ptrdiff_t>(begin),
+                         out.begin() + static_cast<std::ptrdiff_t>(first), out.end(),
+                         [](const zone_transition& a, const zone_transition& b) {
+                           return a.index < b.index;
+                         });
+    }
+  }
+
+  void build_grid(span<const state_r2> vertices, double cells_per_edge) {
+    box2d bounds{vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y};
+    for (const state_r2& vertex : vertices) {
+      bounds.min_x = std::min(bounds.min_x, vertex.x);
+      bounds.min_y = std::min(bounds.min_y, vertex.y);
+      bounds.max_x = std::max(bounds.max_x, vertex.x);
+      bounds.max_y = std::max(bounds.max_y, vertex.y);
+    }
+    const double width = bounds.max_x - bounds.min_x;
+    const double height = bounds.max_y - bounds.min_y;
+    // Square cells, about cells_per_edge * vertices.size() of them, at most 2048 per axis.
+    const double target = cells_per_edge * static_cast<double>(vertices.size());
+    double cell_size = std::sqrt(width * height / target);
+    cell_size = std::max({cell_size, width / 2048.0, height / 2048.0});
+    if (!(cell_size > 0.0)) {
+      // Degenerate zone without area.
+      cell_size = std::max({width, height, 1.0});
+    }
+    grid g;
+    g.bounds = bounds;
+    g.cell_size = cell_size;
+    g.inverse_cell_size = 1.0 / cell_size;
+    g.columns = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(width / cell_size)));
+    g.rows = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(height / cell_size)));
+    g.first_cell = cells_.size();
+    cells_.resize(g.first_cell + g.columns * g.rows, cell{0, 0, false});
+    const span<cell> cells(cells_.data() + g.first_cell, g.columns * g.rows);
+
+    // Slightly enlarged, so that rounding in contains() cannot move a point out of the
+    // cell whose edges it is tested against.
+    const double margin = 1e-9 * cell_size;
+    const auto cell_box = [&](std::size_t column, std::size_t row) {
+      const double x = bounds.min_x + static_cast<double>(column) * cell_size;
+      const double y = bounds.min_y + static_cast<double>(row) * cell_size;
+      return box2d{x - margin, y - margin, x + cell_size + margin, y + cell_size + margin};
+    };
+    const auto clamped = [](double value, std::size_t size) {
+      return std::min(static_cast<std::size_t>(std::max(value, 0.0)), size - 1);
+    };
+
+    // Edge buckets: counts first, then the edges of each cell back to back.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> touches;
+    for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++) {
+      const state_r2& a = vertices[j];
+      const state_r2& b = vertices[i];
+      const std::size_t c0 = clamped((std::min(a.x, b.x) - bounds.min_x) / cell_size, g.columns);
+      const std::size_t c1 = clamped((std::max(a.x, b.x) - bounds.min_x) / cell_size, g.columns);
+      const std::size_t r0 = clamped((std::min(a.y, b.y) - bounds.min_y) / cell_size, g.rows);
+      const std::size_t r1 = clamped((std::max(a.y, b.y) - bounds.min_y) / cell_size, g.rows);
+      for (std::size_t row = r0; row <= r1; ++row) {
+        for (std::size_t column = c0; column <= c1; ++column) {
+          if (segment_intersects_box(a, b, cell_box(column, row))) {
+            touches.emplace_back(static_cast<std::uint32_t>(row * g.columns + column),
+                                 static_cast<std::uint32_t>(j));
+          }
+        }
+      }
+    }
+    std::sort(touches.begin(), touches.end());
+    if (edges_.size() + touches.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::invalid_argument("geofence: too many edges!");
+    }
+    for (const auto& [index, vertex] : touches) {
+      cell& c = cells[index];
+      if (c.edge_count == 0) {
+        c.first_edge = static_cast<std::uint32_t>(edges_.size());
+      }
+      ++c.edge_count;
+      const std::size_t next = (vertex + 1) % vertices.size();
+      edges_.push_back({vertices[vertex], vertices[next]});
+    }
+
+    // Cell centers, one scanline per row with the same crossing rule as polygon_contains.
+    std::vector<double> crossings;
+    for (std::size_t row = 0; row < g.rows; ++row) {
+      const double y = bounds.min_y + (static_cast<double>(row) + 0.5) * cell_size;
+      crossings.clear();
+      for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++) {
+        const state_r2& a = vertices[i];
+        const state_r2& b = vertices[j];
+        if ((a.y > y) != (b.y > y)) {
+          crossings.push_back((b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x);
+        }
+      }
+      std::sort(crossings.begin(), crossings.end());
+      // The center is inside if an odd number of crossings lies to its right.
+      std::size_t left_of_center = 0;
+      for (std::size_t column = 0; column < g.columns; ++column) {
+        const double x = bounds.min_x + (static_cast<double>(column) + 0.5) * cell_size;
+        while (left_of_center < crossings.size() && crossings[left_of_center] <= x) {
+          ++left_of_center;
+        }
+        cells[row * g.columns + column].center_inside =
+            (crossings.size() - left_of_center) % 2 == 1;
+      }
+    }
+    grids_.push_back(g);
+  }
+
+  /// Vertices of all zones.
+  ragged_buffer<state_r2> zones_;
+  /// One grid per zone.
+  std::vector<grid> grids_;
+  /// Cells of all grids.
+  std::vector<cell> cells_;
+  /// Edge buckets of all cells.
+  std::vector<edge> edges_;
+};
+
+} // namespace trailblaze::env
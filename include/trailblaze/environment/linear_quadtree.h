@@ -0,0 +1,583 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/environment/ray_caster.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze::env {
+
+/** Sparse occupancy map for large, mostly empty areas.
+ *
+ *  A region quadtree without pointers: the map is padded to a square of 2^depth cells and the
+ *  cells are ordered by their Morton code (interleaved x and y bits), so that every quadtree
+ *  node covers a contiguous range of codes. Only the occupied leaves are stored, as the
+ *  sorted start codes of maximal aligned blocks. A completely occupied square is one leaf, so
+ *  the memory grows with the boundary of the obstacles and not with the map area. Free space
+ *  is implicit: the largest free block around a cell follows from the two neighboring leaves
+ *  in the array.
+ *
+ *  Lookups are binary searches over the leaves. Sequences of states, ray casts and path
+ *  checks skip through free blocks instead of visiting every cell. Cells outside of the map
+ *  count as occupied, as for @ref occupancy_grid.
+ */
+class linear_quadtree {
+public:
+  /** Constructor
+   *  @param width Number of cells in x direction.
+   *  @param height Number of cells in y direction.
+   *  @param resolution Edge length of a cell.
+   *  @param origin Position of the corner of cell (0, 0).
+   *  @param occupied The occupied cells, duplicates are allowed.
+   *  @throws std::invalid_argument if @p resolution is not positive or the map is empty or
+   *          larger than 2^30 cells in a direction.
+   *  @throws std::out_of_range if an occupied cell lies outside of the map.
+   */
+  linear_quadtree(std::size_t width, std::size_t height, double resolution,
+                  const state_r2& origin, span<const cell_index> occupied)
+      : linear_quadtree(width, height, resolution, origin) {
+    std::vector<std::uint64_t> codes;
+    codes.reserve(occupied.size());
+    for (const cell_index& cell : occupied) {
+      if (!contains(cell)) {
+        throw std::out_of_range("linear_quadtree: cell is outside of the map!");
+      }
+      codes.push_back(encode(cell.x, cell.y));
+    }
+    build(codes);
+  }
+
+  /** Constructor, converts a dense grid.
+   *  @param grid The grid, cells count as occupied according to its threshold.
+   */
+  template <typename TCell>
+  explicit linear_quadtree(const occupancy_grid<TCell>& grid)
+      : linear_quadtree(grid.width(), grid.height(), grid.resolution(), grid.origin()) {
+    std::vector<std::uint64_t> codes;
+    std::vector<std::uint8_t> row(width_);
+    for (std::size_t y = 0; y < height_; ++y) {
+      grid.row_occupancy(y, span<std::uint8_t>(row));
+      for (std::size_t x = 0; x < width_; ++x) {
+        if (row[x] != 0) {
+          codes.push_back(encode(static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)));
+        }
+      }
+    }
+    build(codes);
+  }
+
+  /// @returns the number of cells in x direction.
+  [[__nodiscard__]] std::size_t width() const noexcept {
+    return width_;
+  }
+
+  /// @returns the number of cells in y direction.
+  [[__nodiscard__]] std::size_t height() const noexcept {
+    return height_;
+  }
+
+  /// @returns the edge length of a cell.
+  [[__nodiscard__]] double resolution() const noexcept {
+    return resolution_;
+  }
+
+  /// @returns the position of the corner of cell (0, 0).
+  [[__nodiscard__]] const state_r2& origin() const noexcept {
+    return origin_;
+  }
+
+  /// @returns the number of stored leaves.
+  [[__nodiscard__]] std::size_t leaf_count() const noexcept {
+    return starts_.size();
+  }
+
+  /// @returns @c true if @p cell lies inside of the map.
+  [[__nodiscard__]] bool contains(const cell_index& cell) const noexcept {
+    return cell.x >= 0 && cell.y >= 0 && static_cast<std::uint64_t>(cell.x) < width_ &&
+           static_cast<std::uint64_t>(cell.y) < height_;
+  }
+
+  /// @returns the cell that contains the position (@p x, @p y), it may lie outside the map.
+  [[__nodiscard__]] cell_index cell_of(double x, double y) const noexcept {
+    return {floor_to_cell((x - origin_.x) * inverse_resolution_),
+            floor_to_cell((y - origin_.y) * inverse_resolution_)};
+  }
+
+  /// @returns @c true if @p cell is occupied or lies outside of the map.
+  [[__nodiscard__]] bool is_occupied(const cell_index& cell) const noexcept {
+    return !contains(cell) || locate(cell).occupied;
+  }
+
+  /** Checks the cells at the positions of a sequence of states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to check.
+   *  @param out Receives 1 for states in occupied cells or outside the map, else 0. Must have
+   *         the same size as @p states.
+   */
+  template <typename TState>
+  void occupied(span<const TState> states, span<std::uint8_t> out) const noexcept {
+    static_assert(has_xy_v<TState>, "linear_quadtree: TState must have components x & y");
+    assert(out.size() == states.size());
+    cached_block cache;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = occupied_at(states[i].x, states[i].y, cache) ? 1 : 0;
+    }
+  }
+
+  /// @see occupied(span<const TState>, span<std::uint8_t>) const
+  template <typename TState>
+  void occupied(const path<TState>& states, span<std::uint8_t> out) const noexcept {
+    occupied(states.states(), out);
+  }
+
+  /** Finds the first state of a sequence in an occupied cell.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to check.
+   *  @returns the index of the first state in an occupied cell or outside the map, or
+   *           @c states.size() if there is none.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_occupied(span<const TState> states) const noexcept {
+    static_assert(has_xy_v<TState>, "linear_quadtree: TState must have components x & y");
+    cached_block cache;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      if (occupied_at(states[i].x, states[i].y, cache)) {
+        return i;
+      }
+    }
+    return states.size();
+  }
+
+  /// @see first_occupied(span<const TState>) const
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_occupied(const path<TState>& states) const noexcept {
+    return first_occupied(states.states());
+  }
+
+  /// @returns @c true if all states lie in free cells.
+  template <typename TState>
+  [[__nodiscard__]] bool is_free(span<const TState> states) const noexcept {
+    return first_occupied(states) == states.size();
+  }
+
+  /// @see is_free(span<const TState>)
+  template <typename TState>
+  [[__nodiscard__]] bool is_free(const path<TState>& states) const noexcept {
+    return is_free(states.states());
+  }
+
+  /** Computes the distance of a position to the closest occupied cell.
+   *  @param x The x coordinate.
+   *  @param y The y coordinate.
+   *  @param max_distance Cells farther away than this are ignored, a tight bound speeds up
+   *         the query.
+   *  @returns the Euclidean distance to the area of the closest occupied cell, at most
+   *           @p max_distance. 0 inside occupied cells and outside of the map.
+   */
+  [[__nodiscard__]] double clearance(
+      double x, double y,
+      double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    const double fx = (x - origin_.x) * inverse_resolution_;
+    const double fy = (y - origin_.y) * inverse_resolution_;
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(width_) &&
+          fy < static_cast<double>(height_))) {
+      return 0.0;
+    }
+    const double bound = max_distance * inverse_resolution_;
+    return std::sqrt(nearest(fx, fy, bound * bound)) * resolution_;
+  }
+
+  /** Computes the clearance of a sequence of states, see @ref clearance.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states.
+   *  @param out Receives the clearances. Must have the same size as @p states.
+   *  @param max_distance Upper bound of the reported clearances.
+   */
+  template <typename TState>
+  void clearance(span<const TState> states, span<double> out,
+                 double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    static_assert(has_xy_v<TState>, "linear_quadtree: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = clearance(states[i].x, states[i].y, max_distance);
+    }
+  }
+
+  /// @see clearance(span<const TState>, span<double>, double) const
+  template <typename TState>
+  void clearance(const path<TState>& states, span<double> out,
+                 double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    clearance(states.states(), out, max_distance);
+  }
+
+  /** Casts a ray, see @ref ray_caster::cast. Free blocks are crossed in one step.
+   *  @param origin Start of the ray.
+   *  @param angle Direction of the ray in [rad].
+   *  @param max_range Maximum length of the ray.
+   *  @returns the first occupied cell along the ray.
+   */
+  [[__nodiscard__]] ray_hit cast(const state_r2& origin, double angle,
+                                 double max_range) const noexcept {
+    return traverse(origin, std::cos(angle), std::sin(angle), max_range);
+  }
+
+  /** Checks if a line segment passes through free cells only, see
+   *  @ref ray_caster::segment_free.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param a Start of the segment.
+   *  @param b End of the segment.
+   *  @returns @c true if no cell that the segment passes through is occupied.
+   */
+  template <typename TState>
+  [[__nodiscard__]] bool segment_free(const TState& a, const TState& b) const noexcept {
+    static_assert(has_xy_v<TState>, "linear_quadtree: TState must have components x & y");
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    const double length = std::hypot(dx, dy);
+    if (length > 0.0) {
+      dx /= length;
+      dy /= length;
+    }
+    return !traverse(state_r2{a.x, a.y}, dx, dy, length).hit;
+  }
+
+  /** Finds the first segment of a polyline that passes through an occupied cell, see
+   *  @ref ray_caster::first_intersection.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The vertices of the polyline.
+   *  @returns 0 if the first point lies in an occupied cell, @c i if the segment from point
+   *           <tt>i - 1</tt> to point @c i is the first blocked one, or @c states.size() if
+   *           the polyline is free.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(span<const TState> states) const noexcept {
+    if (states.empty() || !segment_free(states[0], states[0])) {
+      return 0;
+    }
+    for (std::size_t i = 1; i < states.size(); ++i) {
+      if (!segment_free(states[i - 1], states[i])) {
+        return i;
+      }
+    }
+    return states.size();
+  }
+
+  /// @see first_intersection(span<const TState>) const
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(const path<TState>& states) const noexcept {
+    return first_intersection(states.states());
+  }
+
+private:
+  /// An aligned square of cells.
+  struct block {
+    std::int64_t x;
+    std::int64_t y;
+    std::int64_t size;
+    bool occupied;
+  };
+
+  /// The last free block of a sequence query, clipped to the map.
+  struct cached_block {
+    std::int64_t min_x{0};
+    std::int64_t min_y{0};
+    std::int64_t max_x{-1};
+    std::int64_t max_y{-1};
+  };
+
+  /// Nodes of the nearest search, 3 siblings per level stay on the stack.
+  static constexpr std::size_t stack_capacity = 4 * 32;
+
+  linear_quadtree(std::size_t width, std::size_t height, double resolution,
+                  const state_r2& origin)
+      : width_(width), height_(height), resolution_(resolution),
+        inverse_resolution_(1.0 / resolution), origin_(origin) {
+    if (!(resolution > 0.0)) {
+      throw std::invalid_argument("linear_quadtree: resolution must be positive!");
+    }
+    constexpr std::size_t max_size = std::size_t{1} << 30U;
+    if (width == 0 || height == 0 || width > max_size || height > max_size) {
+      throw std::invalid_argument("linear_quadtree: invalid map size!");
+    }
+    while ((std::size_t{1} << depth_) < std::max(width, height)) {
+      ++depth_;
+    }
+  }
+
+  /// Interleaves the lower 32 bits of @p value with zeros.
+  [[__nodiscard__]] static std::uint64_t spread(std::uint64_t value) noexcept {
+    value &= 0xFFFFFFFFULL;
+    value = (value | (value << 16U)) & 0x0000FFFF0000FFFFULL;
+    value = (value | (value << 8U)) & 0x00FF00FF00FF00FFULL;
+    value = (value | (value << 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+    value = (value | (value << 2U)) & 0x3333333333333333ULL;
+    value = (value | (value << 1U)) & 0x5555555555555555ULL;
+    return value;
+  }
+
+  /// Inverse of @ref spread.
+  [[__nodiscard__]] static std::uint64_t compact(std::uint64_t value) noexcept {
+    value &= 0x5555555555555555ULL;
+    value = (value | (value >> 1U)) & 0x3333333333333333ULL;
+    value = (value | (value >> 2U)) & 0x0F0F0F0F0F0F0F0FULL;
+    value = (value | (value >> 4U)) & 0x00FF00FF00FF00FFULL;
+    value = (value | (value >> 8U)) & 0x0000FFFF0000FFFFULL;
+    value = (value | (value >> 16U)) & 0x00000000FFFFFFFFULL;
+    return value;
+  }
+
+  [[__nodiscard__]] static std::uint64_t encode(std::int64_t x, std::int64_t y) noexcept {
+    return spread(static_cast<std::uint64_t>(x)) | (spread(static_cast<std::uint64_t>(y)) << 1U);
+  }
+
+  /// @returns the number of cells of a block of @p level.
+  [[__nodiscard__]] static std::uint64_t cell_count(unsigned level) noexcept {
+    return std::uint64_t{1} << (2U * level);
+  }
+
+  /// Converts sorted runs of occupied cells into maximal aligned blocks.
+  void build(std::vector<std::uint64_t>& codes) {
+    std::sort(codes.begin(), codes.end());
+    codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+    for (std::size_t i = 0; i < codes.size();) {
+      std::size_t j = i + 1;
+      while (j < codes.size() && codes[j] == codes[j - 1] + 1) {
+        ++j;
+      }
+      // The run [first, last) of consecutive codes.
+      std::uint64_t first = codes[i];
+      const std::uint64_t last = codes[j - 1] + 1;
+      while (first < last) {
+        unsigned level = 0;
+        while (level < depth_ && first % cell_count(level + 1) == 0 &&
+               first + cell_count(level + 1) <= last) {
+          ++level;
+        }
+        starts_.push_back(first);
+        levels_.push_back(static_cast<std::uint8_t>(level));
+        first += cell_count(level);
+      }
+      i = j;
+    }
+    starts_.shrink_to_fit();
+    levels_.shrink_to_fit();
+  }
+
+  /** Finds the occupied leaf that contains a cell, or else the largest free block around it.
+   *  @param cell A cell inside of the map.
+   */
+  [[__nodiscard__]] block locate(const cell_index& cell) const noexcept {
+    const std::uint64_t code = encode(cell.x, cell.y);
+    const auto next = static_cast<std::size_t>(
+        std::upper_bound(starts_.begin(), starts_.end(), code) - starts_.begin());
+    std::uint64_t free_begin = 0;
+    if (next > 0) {
+      const std::uint64_t leaf_end = starts_[next - 1] + cell_count(levels_[next - 1]);
+      if (code < leaf_end) {
+        return make_block(starts_[next - 1], levels_[next - 1], true);
+      }
+      free_begin = leaf_end;
+    }
+    const std::uint64_t free_end = next < starts_.size() ? starts_[next] : cell_count(depth_);
+    unsigned level = 0;
+    while (level < depth_) {
+      const std::uint64_t size = cell_count(level + 1);
+      const std::uint64_t start = code & ~(size - 1);
+      if (start < free_begin || start + size > free_end) {
+        break;
+      }
+      ++level;
+    }
+    return make_block(code & ~(cell_count(level) - 1), level, false);
+  }
+
+  [[__nodiscard__]] static block make_block(std::uint64_t start, unsigned level,
+                                            bool occupied) noexcept {
+    return {static_cast<std::int64_t>(compact(start)),
+            static_cast<std::int64_t>(compact(start >> 1U)), std::int64_t{1} << level,
+            occupied};
+  }
+
+  /// Occupancy lookup that reuses the free block of the previous lookup.
+  [[__nodiscard__]] bool occupied_at(double x, double y, cached_block& cache) const noexcept {
+    const double fx = (x - origin_.x) * inverse_resolution_;
+    const double fy = (y - origin_.y) * inverse_resolution_;
+    // Written so that NaN coordinates are outside. Truncation equals floor for values >= 0.
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < static_cast<double>(width_) &&
+          fy < static_cast<double>(height_))) {
+      return true;
+    }
+    const cell_index cell{static_cast<std::int64_t>(fx), static_cast<std::int64_t>(fy)};
+    if (cell.x >= cache.min_x && cell.x <= cache.max_x && cell.y >= cache.min_y &&
+        cell.y <= cache.max_y) {
+      return false;
+    }
+    const block b = locate(cell);
+    if (b.occupied) {
+      return true;
+    }
+    cache = {b.x, b.y, b.x + b.size - 1, b.y + b.size - 1};
+    return false;
+  }
+
+  /** Classifies the quadtree node that covers the codes [@p begin, @p end).
+   *  @returns 0 if it is free, 1 if it is partially and 2 if it is completely occupied.
+   */
+  [[__nodiscard__]] int node_occupancy(std::uint64_t begin, std::uint64_t end) const noexcept {
+    const auto next = static_cast<std::size_t>(
+        std::upper_bound(starts_.begin(), starts_.end(), begin) - starts_.begin());
+    if (next > 0) {
+      // Aligned blocks are either nested or disjoint.
+      const std::uint64_t leaf_end = starts_[next - 1] + cell_count(levels_[next - 1]);
+      if (leaf_end >= end) {
+        return 2;
+      }
+      if (leaf_end > begin) {
+        return 1;
+      }
+    }
+    return next < starts_.size() && starts_[next] < end ? 1 : 0;
+  }
+
+  /** Branch and bound search for the closest occupied cell, visiting closer children first.
+   *  @param x Position in cell units.
+   *  @param y Position in cell units.
+   *  @param bound Squared distance in cells beyond which cells are ignored.
+   *  @returns the squared distance in cells, at most @p bound.
+   */
+  [[__nodiscard__]] double nearest(double x, double y, double bound) const noexcept {
+    struct entry {
+      double squared_distance;
+      std::uint64_t start;
+      unsigned level;
+    };
+    const auto squared_distance = [&](std::uint64_t start, unsigned level) {
+      const auto min_x = static_cast<double>(compact(start));
+      const auto min_y = static_cast<double>(compact(start >> 1U));
+      const auto size = static_cast<double>(std::uint64_t{1} << level);
+      const double dx = std::max({min_x - x, 0.0, x - (min_x + size)});
+      const double dy = std::max({min_y - y, 0.0, y - (min_y + size)});
+      return dx * dx + dy * dy;
+    };
+    std::array<entry, stack_capacity> stack;
+    std::size_t top = 0;
+    stack[top++] = {0.0, 0, depth_};
+    while (top > 0) {
+      const entry current = stack[--top];
+      if (current.squared_distance >= bound) {
+        continue;
+      }
+      const int occupancy =
+          node_occupancy(current.start, current.start + cell_count(current.level));
+      if (occupancy == 0) {
+        continue;
+      }
+      if (occupancy == 2) {
+        bound = current.squared_distance;
+        continue;
+      }
+      // Partially occupied nodes are never single cells. Pushes the farthest child first.
+      const std::size_t first = top;
+      const unsigned level = current.level - 1;
+      for (std::uint64_t child = 0; child < 4; ++child) {
+        const std::uint64_t start = current.start + child * cell_count(level);
+        const double distance = squared_distance(start, level);
+        if (distance < bound) {
+          stack[top++] = {distance, start, level};
+        }
+      }
+      std::sort(stack.begin() + static_cast<std::ptrdiff_t>(first),
+                stack.begin() + static_cast<std::ptrdiff_t>(top),
+                [](const entry& a, const entry& b) {
+                  return a.squared_distance > b.squared_distance;
+                });
+    }
+    return bound;
+  }
+
+  /** Walks from @p origin in the unit direction (@p dx, @p dy) for at most @p max_range and
+   *  jumps from block to block.
+   */
+  [[__nodiscard__]] ray_hit traverse(const state_r2& origin, double dx, double dy,
+                                     double max_range) const noexcept {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    // Position and range in cell units.
+    const double fx = (origin.x - origin_.x) * inverse_resolution_;
+    const double fy = (origin.y - origin_.y) * inverse_resolution_;
+    if (!std::isfinite(fx) || !std::isfinite(fy)) {
+      return {0.0, {-1, -1}, true};
+    }
+    const double max_t = max_range * inverse_resolution_;
+    cell_index cell{floor_to_cell(fx), floor_to_cell(fy)};
+    const auto width = static_cast<std::int64_t>(width_);
+    const auto height = static_cast<std::int64_t>(height_);
+
+    double t = 0.0;
+    while (true) {
+      if (!contains(cell)) {
+        return {t * resolution_, cell, true};
+      }
+      const block b = locate(cell);
+      if (b.occupied) {
+        return {t * resolution_, cell, true};
+      }
+      // Leaves the free block, clipped to the map, through the boundary that comes first.
+      const std::int64_t end_x = std::min(b.x + b.size, width);
+      const std::int64_t end_y = std::min(b.y + b.size, height);
+      double exit_x = infinity;
+      double exit_y = infinity;
+      if (dx != 0.0) {
+        exit_x = (static_cast<double>(dx > 0.0 ? end_x : b.x) - fx) / dx;
+      }
+      if (dy != 0.0) {
+        exit_y = (static_cast<double>(dy > 0.0 ? end_y : b.y) - fy) / dy;
+      }
+      if (exit_x < exit_y) {
+        t = exit_x;
+        cell.x = dx > 0.0 ? end_x : b.x - 1;
+        cell.y = std::clamp(floor_to_cell(fy + t * dy), b.y, end_y - 1);
+      } else {
+        t = exit_y;
+        cell.y = dy > 0.0 ? end_y : b.y - 1;
+        cell.x = std::clamp(floor_to_cell(fx + t * dx), b.x, end_x - 1);
+      }
+      if (!(t <= max_t)) {
+        return {max_range, cell, false};
+      }
+    }
+  }
+
+  /// Number of cells in x direction.
+  std::size_t width_;
+  /// Number of cells in y direction.
+  std::size_t height_;
+  /// Edge length of a cell.
+  double resolution_;
+  /// 1 / resolution_
+  double inverse_resolution_;
+  /// Position of the corner of cell (0, 0).
+  state_r2 origin_;
+  /// The map is padded to 2^depth_ x 2^depth_ cells.
+  unsigned depth_{0};
+  /// Morton codes of the first cells of the occupied leaves, ascending.
+  std::vector<std::uint64_t> starts_;
+  /// Levels of the occupied leaves, a leaf of level l has 4^l cells.
+  std::vector<std::uint8_t> levels_;
+};
+
+} // namespace trailblaze::env
@@ -0,0 +1,370 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze::env {
+
+/// Integer coordinates of a grid cell, x is the column and y the row.
+struct cell_index {
+  std::int64_t x{0};
+  std::int64_t y{0};
+};
+
+/** Rounds a coordinate in cell units down to a cell coordinate.
+ *
+ *  Converting a double that does not fit into std::int64_t is undefined, so values beyond
+ *  +-2^62 are clamped and NaN maps to -2^62. Both lie far outside of any grid, and stepping
+ *  to neighbors from there cannot overflow.
+ */
+[[__nodiscard__]] inline std::int64_t floor_to_cell(double value) noexcept {
+  constexpr std::int64_t bound = std::int64_t{1} << 62;
+  constexpr auto limit = static_cast<double>(bound);
+  if (!(value > -limit)) {
+    return -bound;
+  }
+  if (!(value < limit)) {
+    return bound;
+  }
+  return static_cast<std::int64_t>(std::floor(value));
+}
+
+/** Values and defaults of a cell type of @ref occupancy_grid.
+ *  @tparam TCell The cell type.
+ */
+template <typename TCell>
+struct cell_traits;
+
+/// One bit per cell, set means occupied.
+template <>
+struct cell_traits<bool> {
+  static constexpr bool free = false;
+  static constexpr bool occupied = true;
+  static constexpr bool default_threshold = true;
+};
+
+/// One byte per cell, e.g. a cost or a scaled occupancy probability.
+template <>
+struct cell_traits<std::uint8_t> {
+  static constexpr std::uint8_t free = 0;
+  static constexpr std::uint8_t occupied = 255;
+  static constexpr std::uint8_t default_threshold = 128;
+};
+
+/// Occupancy probability per cell.
+template <>
+struct cell_traits<float> {
+  static constexpr float free = 0.0F;
+  static constexpr float occupied = 1.0F;
+  static constexpr float default_threshold = 0.5F;
+};
+
+/** A 2D occupancy grid with a tiled memory layout.
+ *
+ *  Cells are stored in tiles of @ref tile_size x @ref tile_size cells, tile after tile. A
+ *  tile of bit cells is one 64 bit word and a tile of byte cells is one cache line, so the
+ *  states of a path, which move only a few cells from one to the next, mostly hit memory
+ *  that is already cached regardless of the direction of travel. In a row-major layout, each
+ *  step in y direction would touch a new cache line.
+ *
+ *  Cell (0, 0) covers the square [origin.x, origin.x + resolution) x
+ *  [origin.y, origin.y + resolution). Positions outside of the grid are treated as occupied.
+ *  A cell counts as occupied if its value is >= @ref occupied_threshold.
+ *
+ *  @tparam TCell The cell type: @c bool, @c std::uint8_t or @c float, see @ref cell_traits.
+ */
+template <typename TCell>
+class occupancy_grid {
+public:
+  using cell_type = TCell;
+  using traits = cell_traits<TCell>;
+
+  /// Edge length of a tile in cells.
+  static constexpr std::size_t tile_size = 8;
+
+  /** Constructor
+   *  @param width Number of cells in x direction.
+   *  @param height Number of cells in y direction.
+   *  @param resolution Edge length of a cell.
+   *  @param origin Position of the corner of cell (0, 0) with the smallest coordinates.
+   *  @param initial The initial value of all cells.
+   *  @throws std::invalid_argument if @p resolution is not positive.
+   */
+  occupancy_grid(std::size_t width, std::size_t height, double resolution,
+                 const state_r2& origin = {0.0, 0.0}, TCell initial = traits::free)
+      : width_(width), height_(height), tiles_x_((width + tile_size - 1) / tile_size),
+        resolution_(resolution), inverse_resolution_(1.0 / resolution), origin_(origin),
+        threshold_(traits::default_threshold) {
+    if (!(resolution > 0.0)) {
+      throw std::invalid_argument("occupancy_grid: resolution must be positive!");
+    }
+    data_.resize(tiles_x_ * ((height + tile_size - 1) / tile_size) * words_per_tile);
+    fill(initial);
+  }
+
+  /// @returns the number of cells in x direction.
+  [[__nodiscard__]] std::size_t width() const noexcept {
+    return width_;
+  }
+
+  /// @returns the number of cells in y direction.
+  [[__nodiscard__]] std::size_t height() const noexcept {
+    return height_;
+  }
+
+  /// @returns the edge length of a cell.
+  [[__nodiscard__]] double resolution() const noexcept {
+    return resolution_;
+  }
+
+  /// @returns the position of the corner of cell (0, 0).
+  [[__nodiscard__]] const state_r2& origin() const noexcept {
+    return origin_;
+  }
+
+  /// @returns the smallest cell value that counts as occupied.
+  [[__nodiscard__]] TCell occupied_threshold() const noexcept {
+    return threshold_;
+  }
+
+  /// @param threshold The smallest cell value that counts as occupied.
+  void set_occupied_threshold(TCell threshold) noexcept {
+    threshold_ = threshold;
+  }
+
+  /// @returns @c true if @p value counts as occupied.
+  [[__nodiscard__]] bool is_occupied_value(TCell value) const noexcept {
+    return value >= threshold_;
+  }
+
+  /// @returns @c true if @p cell lies inside of the grid.
+  [[__nodiscard__]] bool contains(const cell_index& cell) const noexcept {
+    return cell.x >= 0 && cell.y >= 0 && static_cast<std::uint64_t>(cell.x) < width_ &&
+           static_cast<std::uint64_t>(cell.y) < height_;
+  }
+
+  /// @returns the cell that contains the position (@p x, @p y), it may lie outside the grid.
+  [[__nodiscard__]] cell_index cell_of(double x, double y) const noexcept {
+    return {floor_to_cell((x - origin_.x) * inverse_resolution_),
+            floor_to_cell((y - origin_.y) * inverse_resolution_)};
+  }
+
+  /// @returns the position of the center of @p cell.
+  [[__nodiscard__]] state_r2 cell_center(const cell_index& cell) const noexcept {
+    return {origin_.x + (static_cast<double>(cell.x) + 0.5) * resolution_,
+            origin_.y + (static_cast<double>(cell.y) + 0.5) * resolution_};
+  }
+
+  /// @returns the value of @p cell, or @c traits::occupied if it lies outside the grid.
+  [[__nodiscard__]] TCell value(const cell_index& cell) const noexcept {
+    if (!contains(cell)) {
+      return traits::occupied;
+    }
+    return read(static_cast<std::size_t>(cell.x), static_cast<std::size_t>(cell.y));
+  }
+
+  /** Sets the value of a cell.
+   *  @param cell The cell to modify.
+   *  @param value The new value.
+   *  @throws std::out_of_range if @p cell lies outside the grid.
+   */
+  void set(const cell_index& cell, TCell value) {
+    if (!contains(cell)) {
+      throw std::out_of_range("occupancy_grid: cell is outside of the grid!");
+    }
+    const auto [word, offset] =
+        locate(static_cast<std::size_t>(cell.x), static_cast<std::size_t>(cell.y));
+    if constexpr (std::is_same_v<TCell, bool>) {
+      const std::uint64_t mask = std::uint64_t{1} << offset;
+      data_[word] = value ? (data_[word] | mask) : (data_[word] & ~mask);
+    } else {
+      data_[word + offset] = value;
+    }
+  }
+
+  /// Sets all cells to @p value.
+  void fill(TCell value) noexcept {
+    if constexpr (std::is_same_v<TCell, bool>) {
+      std::fill(data_.begin(), data_.end(), value ? ~std::uint64_t{0} : std::uint64_t{0});
+    } else {
+      std::fill(data_.begin(), data_.end(), value);
+    }
+  }
+
+  /** Looks up the cell values at the positions of a sequence of states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to look up.
+   *  @param out Receives the cell values, @c traits::occupied for states outside the grid.
+   *         Must have the same size as @p states.
+   */
+  template <typename TState>
+  void values(span<const TState> states, span<TCell> out) const noexcept {
+    static_assert(has_xy_v<TState>, "occupancy_grid: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = value_at(states[i].x, states[i].y);
+    }
+  }
+
+  /// @see values(span<const TState>, span<TCell>)
+  template <typename TState>
+  void values(const path<TState>& states, span<TCell> out) const noexcept {
+    values(states.states(), out);
+  }
+
+  /** Checks the occupancy at the positions of a sequence of states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to check.
+   *  @param out Receives 1 for occupied states and states outside the grid, 0 otherwise.
+   *         Must have the same size as @p states.
+   */
+  template <typename TState>
+  void occupied(span<const TState> states, span<std::uint8_t> out) const noexcept {
+    static_assert(has_xy_v<TState>, "occupancy_grid: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = static_cast<std::uint8_t>(is_occupied_value(value_at(states[i].x, states[i].y)));
+    }
+  }
+
+  /// @see occupied(span<const TState>, span<std::uint8_t>)
+  template <typename TState>
+  void occupied(const path<TState>& states, span<std::uint8_t> out) const noexcept {
+    occupied(states.states(), out);
+  }
+
+  /** Finds the first state of a sequence that is occupied or outside the grid.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to check.
+   *  @returns the index of the first occupied state, or @c states.size() if all are free.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_occupied(span<const TState> states) const noexcept {
+    static_assert(has_xy_v<TState>, "occupancy_grid: TState must have components x & y");
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      if (is_occupied_value(value_at(states[i].x, states[i].y))) {
+        return i;
+      }
+    }
+    return states.size();
+  }
+
+  /// @see first_occupied(span<const TState>)
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_occupied(const path<TState>& states) const noexcept {
+    return first_occupied(states.states());
+  }
+
+  /// @returns @c true if no state of @p states is occupied or outside the grid.
+  template <typename TState>
+  [[__nodiscard__]] bool is_free(span<const TState> states) const noexcept {
+    return first_occupied(states) == states.size();
+  }
+
+  /// @see is_free(span<const TState>)
+  template <typename TState>
+  [[__nodiscard__]] bool is_free(const path<TState>& states) const noexcept {
+    return is_free(states.states());
+  }
+
+  /** Reads the occupancy of one row of cells.
+   *  @param y The row.
+   *  @param out Receives 1 for occupied cells and 0 for free cells. Must have @ref width()
+   *         elements.
+   */
+  void row_occupancy(std::size_t y, span<std::uint8_t> out) const noexcept {
+    assert(y < height_ && out.size() == width_);
+    const std::size_t row_offset = (y % tile_size) * tile_size;
+    for (std::size_t x_begin = 0; x_begin < width_; x_begin += tile_size) {
+      const std::size_t word = locate(x_begin, y).word;
+      const std::size_t count = std::min(tile_size, width_ - x_begin);
+      for (std::size_t i = 0; i < count; ++i) {
+        if constexpr (std::is_same_v<TCell, bool>) {
+          out[x_begin + i] = static_cast<std::uint8_t>((data_[word] >> (row_offset + i)) & 1U);
+        } else {
+          out[x_begin + i] =
+              static_cast<std::uint8_t>(is_occupied_value(data_[word + row_offset + i]));
+        }
+      }
+    }
+  }
+
+private:
+  /// Bit grids pack a tile into one word, other grids store one element per cell.
+  using storage_type = std::conditional_t<std::is_same_v<TCell, bool>, std::uint64_t, TCell>;
+  static constexpr std::size_t words_per_tile =
+      std::is_same_v<TCell, bool> ? 1 : tile_size * tile_size;
+
+  /// Location of a cell in @ref data_.
+  struct location {
+    /// Index of the first word of the tile.
+    std::size_t word;
+    /// Index of the cell within the tile.
+    std::size_t offset;
+  };
+
+  [[__nodiscard__]] location locate(std::size_t x, std::size_t y) const noexcept {
+    const std::size_t tile = (y / tile_size) * tiles_x_ + x / tile_size;
+    return {tile * words_per_tile, (y % tile_size) * tile_size + x % tile_size};
+  }
+
+  [[__nodiscard__]] TCell read(std::size_t x, std::size_t y) const noexcept {
+    const auto [word, offset] = locate(x, y);
+    if constexpr (std::is_same_v<TCell, bool>) {
+      return ((data_[word] >> offset) & 1U) != 0;
+    } else {
+      return data_[word + offset];
+    }
+  }
+
+  [[__nodiscard__]] TCell value_at(double x, double y) const noexcept {
+    const double grid_x = (x - origin_.x) * inverse_resolution_;
+    const double grid_y = (y - origin_.y) * inverse_resolution_;
+    // Written so that NaN coordinates are outside. Truncation equals floor for values >= 0.
+    if (!(grid_x >= 0.0 && grid_y >= 0.0 && grid_x < static_cast<double>(width_) &&
+          grid_y < static_cast<double>(height_))) {
+      return traits::occupied;
+    }
+    return read(static_cast<std::size_t>(grid_x), static_cast<std::size_t>(grid_y));
+  }
+
+  /// Number of cells in x direction.
+  std::size_t width_;
+  /// Number of cells in y direction.
+  std::size_t height_;
+  /// Number of tiles in x direction.
+  std::size_t tiles_x_;
+  /// Edge length of a cell.
+  double resolution_;
+  /// 1 / resolution_
+  double inverse_resolution_;
+  /// Corner of cell (0, 0).
+  state_r2 origin_;
+  /// Smallest value that counts as occupied.
+  TCell threshold_;
+  /// Tiles in row-major tile order, cells in row-major order within a tile.
+  std::vector<storage_type> data_;
+};
+
+/// Occupancy grid with one bit per cell.
+using bit_occupancy_grid = occupancy_grid<bool>;
+/// Occupancy grid with one byte per cell.
+using byte_occupancy_grid = occupancy_grid<std::uint8_t>;
+/// Occupancy grid with a probability per cell.
+using float_occupancy_grid = occupancy_grid<float>;
+
+} // namespace trailblaze::env
@@ -0,0 +1,400 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+#include "trailblaze/ragged_buffer.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze::env {
+
+/** Static map of polygonal obstacles, e.g. building outlines or keep-out zones.
+ *
+ *  The vertices of all polygons are stored back to back in one @ref ragged_buffer. The polygons
+ *  are indexed by a packed R-tree that is bulk loaded with the Sort-Tile-Recursive algorithm
+ *  (Leutenegger, Lopez and Edgington, 1997): the bounding boxes are sorted by x, cut into
+ *  vertical slices, sorted by y within each slice and packed into full nodes, level by level.
+ *  All nodes live in one array and the children of a node are stored consecutively.
+ *
+ *  Queries traverse the tree depth first with a fixed size stack and do not allocate.
+ *  Polygons may overlap and need not be convex, but must not intersect themselves.
+ */
+class polygon_map {
+public:
+  /// Maximum number of children of a node.
+  static constexpr std::size_t node_capacity = 16;
+
+  /// Constructor, creates an empty map.
+  polygon_map() = default;
+
+  /** Constructor, builds the index.
+   *  @param polygons One row of vertices per polygon, the last vertex is implicitly connected
+   *         with the first one.
+   *  @throws std::invalid_argument if a polygon has less than 3 vertices or there are 2^31 or
+   *          more polygons.
+   */
+  explicit polygon_map(ragged_buffer<state_r2> polygons) : polygons_(std::move(polygons)) {
+    if (polygons_.size() >= (std::size_t{1} << 31U)) {
+      throw std::invalid_argument("polygon_map: too many polygons!");
+    }
+    for (std::size_t i = 0; i < polygons_.size(); ++i) {
+      if (polygons_[i].size() < 3) {
+        throw std::invalid_argument("polygon_map: a polygon needs at least 3 vertices!");
+      }
+    }
+    build();
+  }
+
+  /// @returns the number of polygons.
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return polygons_.size();
+  }
+
+  /// @returns @c true if the map has no polygons.
+  [[__nodiscard__]] bool empty() const noexcept {
+    return polygons_.empty();
+  }
+
+  /// @returns the vertices of polygon @p index, in the order they were passed in.
+  [[__nodiscard__]] span<const state_r2> polygon(std::size_t index) const noexcept {
+    return polygons_[index];
+  }
+
+  /// @returns @c true if @p point lies inside of any polygon.
+  [[__nodiscard__]] bool contains(const state_r2& point) const noexcept {
+    return search(
+        [&](const box2d& box) {
+          return point.x < box.min_x || point.x > box.max_x || point.y < box.min_y ||
+                 point.y > box.max_y;
+        },
+        [&](std::uint32_t index) { return polygon_contains(polygons_[index], point); });
+  }
+
+  /// @returns @c true if the line segment from @p a to @p b touches any polygon.
+  [[__nodiscard__]] bool intersects(const state_r2& a, const state_r2& b) const noexcept {
+    return search([&](const box2d& box) { return !segment_intersects_box(a, b, box); },
+                  [&](std::uint32_t index) {
+                    return polygon_intersects_segment(polygons_[index], a, b);
+                  });
+  }
+
+  /** Computes the distance of a point to the closest polygon.
+   *  @param point The point.
+   *  @param max_distance Polygons farther away than this are ignored, a tight bound speeds up
+   *         the query.
+   *  @returns 0 if @p point lies inside a polygon, else the distance to the closest polygon
+   *           boundary, at most @p max_distance.
+   */
+  [[__nodiscard__]] double distance(
+      const state_r2& point,
+      double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    return std::sqrt(nearest(point, max_distance * max_distance));
+  }
+
+  /** Checks a sequence of points.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The points to check.
+   *  @param out Receives 1 for each point inside of a polygon, else 0. Must have the same size
+   *         as @p states.
+   */
+  template <typename TState>
+  void contains(span<const TState> states, span<std::uint8_t> out) const noexcept {
+    static_assert(has_xy_v<TState>, "polygon_map: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = contains(state_r2{states[i].x, states[i].y}) ? 1 : 0;
+    }
+  }
+
+  /// @see contains(span<const TState>, span<std::uint8_t>) const
+  template <typename TState>
+  void contains(const path<TState>& states, span<std::uint8_t> out) const noexcept {
+    contains(states.states(), out);
+  }
+
+  /** Computes the distances of a sequence of points, see @ref distance.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The points.
+   *  @param out Receives the distances. Must have the same size as @p states.
+   *  @param max_distance Upper bound of the reported distances.
+   */
+  template <typename TState>
+  void distance(span<const TState> states, span<double> out,
+                double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    static_assert(has_xy_v<TState>, "polygon_map: TState must have components x & y");
+    assert(out.size() == states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      out[i] = distance(state_r2{states[i].x, states[i].y}, max_distance);
+    }
+  }
+
+  /// @see distance(span<const TState>, span<double>, double) const
+  template <typename TState>
+  void distance(const path<TState>& states, span<double> out,
+                double max_distance = std::numeric_limits<double>::infinity()) const noexcept {
+    distance(states.states(), out, max_distance);
+  }
+
+  /** Finds the first part of a polyline that touches a polygon.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The vertices of the polyline.
+   *  @returns 0 if the first point lies inside a polygon, @c i if the segment from point
+   *           <tt>i - 1</tt> to point @c i is the first one that touches a polygon, or
+   *           @c states.size() if the polyline is free.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(span<const TState> states) const noexcept {
+    static_assert(has_xy_v<TState>, "polygon_map: TState must have components x & y");
+    if (states.empty()) {
+      return 0;
+    }
+    state_r2 previous{states[0].x, states[0].y};
+    if (contains(previous)) {
+      return 0;
+    }
+    for (std::size_t i = 1; i < states.size(); ++i) {
+      const state_r2 current{states[i].x, states[i].y};
+      if (intersects(previous, current)) {
+        return i;
+      }
+      previous = current;
+    }
+    return states.size();
+  }
+
+  /// @see first_intersection(span<const TState>) const
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(const path<TState>& states) const noexcept {
+    return first_intersection(states.states());
+  }
+
+private:
+  struct node {
+    /// Bounding box of all children.
+    box2d box;
+    /// Index of the first child, in @c nodes_ for inner nodes and in the item arrays for leaves.
+    std::uint32_t first;
+    /// Number of children.
+    std::uint32_t count;
+  };
+
+  struct item {
+    box2d box;
+    std::uint32_t polygon;
+  };
+
+  /// Depth first traversal needs at most (node_capacity - 1) entries per level plus one, the
+  /// tree of 2^31 polygons has 8 levels.
+  static constexpr std::size_t stack_capacity = 8 * node_capacity;
+
+  [[__nodiscard__]] static double squared_box_distance(const box2d& box,
+                                                       const state_r2& point) noexcept {
+    const double dx = std::max({box.min_x - point.x, 0.0, point.x - box.max_x});
+    const double dy = std::max({box.min_y - point.y, 0.0, point.y - box.max_y});
+    return dx * dx + dy * dy;
+  }
+
+  [[__nodiscard__]] static box2d merged(const box2d& a, const box2d& b) noexcept {
+    return {std::min(a.min_x, b.min_x), std::min(a.min_y, b.min_y), std::max(a.max_x, b.max_x),
+            std::max(a.max_y, b.max_y)};
+  }
+
+  /** Sorts entries into Sort-Tile-Recursive order, so that runs of @ref node_capacity
+   *  consecutive entries are spatially compact.
+   */
+  template <typename T>
+  static void sort_tile_recursive(std::vector<T>& entries) {
+    const auto center_x = [](const T& a, const T& b) {
+      return a.box.min_x + a.box.max_x < b.box.min_x + b.box.max_x;
+    };
+    const auto center_y = [](const T& a, const T& b) {
+      return a.box.min_y + a.box.max_y < b.box.min_y + b.box.max_y;
+    };
+    const std::size_t node_count = (entries.size() + node_capacity - 1) / node_capacity;
+    const auto slice_count =
+        static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(node_count))));
+    const std::size_t slice_size = slice_count * node_capacity;
+    std::sort(entries.begin(), entries.end(), center_x);
+    for (std::size_t first = 0; first < entries.size(); first += slice_size) {
+      const std::size_t last = std::min(first + slice_size, entries.size());
+      std::sort(entries.begin() + static_cast<std::ptrdiff_t>(first),
+                entries.begin() + static_cast<std::ptrdiff_t>(last), center_y);
+    }
+  }
+
+  /// Packs runs of @ref node_capacity consecutive entries into nodes.
+  template <typename T>
+  static std::vector<node> pack(const std::vector<T>& entries, std::size_t first_index) {
+    std::vector<node> parents;
+    parents.reserve((entries.size() + node_capacity - 1) / node_capacity);
+    for (std::size_t first = 0; first < entries.size(); first += node_capacity) {
+      const std::size_t last = std::min(first + node_capacity, entries.size());
+      box2d box = entries[first].box;
+      for (std::size_t i = first + 1; i < last; ++i) {
+        box = merged(box, entries[i].box);
+      }
+      parents.push_back({box, static_cast<std::uint32_t>(first_index + first),
+                         static_cast<std::uint32_t>(last - first)});
+    }
+    return parents;
+  }
+
+  void build() {
+    if (polygons_.empty()) {
+      return;
+    }
+    std::vector<item> items(polygons_.size());
+    for (std::size_t i = 0; i < polygons_.size(); ++i) {
+      const span<const state_r2> vertices = polygons_[i];
+      box2d box{vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y};
+      for (const state_r2& vertex : vertices) {
+        box.min_x = std::min(box.min_x, vertex.x);
+        box.min_y = std::min(box.min_y, vertex.y);
+        box.max_x = std::max(box.max_x, vertex.x);
+        box.max_y = std::max(box.max_y, vertex.y);
+      }
+      items[i] = {box, static_cast<std::uint32_t>(i)};
+    }
+    sort_tile_recursive(items);
+    item_boxes_.resize(items.size());
+    item_polygons_.resize(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      item_boxes_[i] = items[i].box;
+      item_polygons_[i] = items[i].polygon;
+    }
+
+    // Levels are appended bottom up, the root ends up last.
+    std::vector<node> level = pack(items, 0);
+    leaf_count_ = level.size();
+    nodes_.clear();
+    nodes_.reserve(level.size() + level.size() / (node_capacity - 1) + 1);
+    while (level.size() > 1) {
+      sort_tile_recursive(level);
+      const std::size_t first_index = nodes_.size();
+      nodes_.insert(nodes_.end(), level.begin(), level.end());
+      level = pack(level, first_index);
+    }
+    nodes_.push_back(level.front());
+  }
+
+  /** Traverses the tree depth first.
+   *  @param prune Invoked as <tt>prune(box)</tt> for nodes and polygon bounding boxes, returns
+   *         @c true if the subtree or polygon can be skipped.
+   *  @param visit Invoked as <tt>visit(polygon_index)</tt> for polygons that are not pruned,
+   *         returns @c true to stop the traversal.
+   *  @returns @c true if @p visit stopped the traversal.
+   */
+  template <typename Prune, typename Visit>
+  bool search(Prune&& prune, Visit&& visit) const noexcept {
+    if (nodes_.empty() || prune(nodes_.back().box)) {
+      return false;
+    }
+    std::array<std::uint32_t, stack_capacity> stack;
+    std::size_t top = 0;
+    stack[top++] = static_cast<std::uint32_t>(nodes_.size() - 1);
+    while (top > 0) {
+      const std::uint32_t index = stack[--top];
+      const node& current = nodes_[index];
+      const std::size_t last = std::size_t{current.first} + current.count;
+      if (index < leaf_count_) {
+        for (std::size_t i = current.first; i < last; ++i) {
+          if (!prune(item_boxes_[i]) && visit(item_polygons_[i])) {
+            return true;
+          }
+        }
+        continue;
+      }
+      assert(top + current.count <= stack_capacity);
+      for (std::size_t i = last; i-- > current.first;) {
+        if (!prune(nodes_[i].box)) {
+          stack[top++] = static_cast<std::uint32_t>(i);
+        }
+      }
+    }
+    return false;
+  }
+
+  /** Branch and bound search for the closest polygon. Children are visited closest first, so
+   *  the bound shrinks quickly and most subtrees are pruned.
+   *  @param point The query point.
+   *  @param bound Squared distance beyond which polygons are ignored.
+   *  @returns the squared distance to the closest polygon, at most @p bound.
+   */
+  [[__nodiscard__]] double nearest(const state_r2& point, double bound) const noexcept {
+    struct entry {
+      double squared_distance;
+      std::uint32_t index;
+    };
+    if (nodes_.empty() || squared_box_distance(nodes_.back().box, point) >= bound) {
+      return bound;
+    }
+    std::array<entry, stack_capacity> stack;
+    std::size_t top = 0;
+    stack[top++] = {0.0, static_cast<std::uint32_t>(nodes_.size() - 1)};
+    while (top > 0) {
+      const entry next = stack[--top];
+      if (next.squared_distance >= bound) {
+        continue;
+      }
+      const node& current = nodes_[next.index];
+      const std::size_t last = std::size_t{current.first} + current.count;
+      if (next.index < leaf_count_) {
+        for (std::size_t i = current.first; i < last; ++i) {
+          if (squared_box_distance(item_boxes_[i], point) >= bound) {
+            continue;
+          }
+          const span<const state_r2> vertices = polygons_[item_polygons_[i]];
+          if (polygon_contains(vertices, point)) {
+            return 0.0;
+          }
+          for (std::size_t k = 0, j = vertices.size() - 1; k < vertices.size(); j = k++) {
+            bound = std::min(bound, segment_squared_distance(point, vertices[j], vertices[k]));
+          }
+        }
+        continue;
+      }
+      // Pushes the children farthest first, so that the closest one is popped next.
+      const std::size_t first = top;
+      for (std::size_t i = current.first; i < last; ++i) {
+        const double squared_distance = squared_box_distance(nodes_[i].box, point);
+        if (squared_distance < bound) {
+          stack[top++] = {squared_distance, static_cast<std::uint32_t>(i)};
+        }
+      }
+      std::sort(stack.begin() + static_cast<std::ptrdiff_t>(first),
+                stack.begin() + static_cast<std::ptrdiff_t>(top),
+                [](const entry& a, const entry& b) {
+                  return a.squared_distance > b.squared_distance;
+                });
+    }
+    return bound;
+  }
+
+  /// Vertices of all polygons.
+  ragged_buffer<state_r2> polygons_;
+  /// Bounding boxes of the polygons, in the order of the leaves.
+  std::vector<box2d> item_boxes_;
+  /// Polygon indices, in the order of the leaves.
+  std::vector<std::uint32_t> item_polygons_;
+  /// All nodes, leaves first and the root last.
+  std::vector<node> nodes_;
+  /// Number of leaf nodes.
+  std::size_t leaf_count_{0};
+};
+
+} // namespace trailblaze::env
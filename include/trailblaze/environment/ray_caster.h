@@ -0,0 +1,231 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_traits.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze::env {
+
+/// Result of a ray cast.
+struct ray_hit {
+  /// Distance from the origin to the hit, or the maximum range if nothing was hit.
+  double distance;
+  /// The cell that was hit, it lies outside of the grid if the ray left the grid. Unspecified
+  /// if nothing was hit.
+  cell_index cell;
+  /// @c true if an occupied cell was hit within the maximum range.
+  bool hit;
+};
+
+/** Casts rays and line segments through an occupancy grid.
+ *
+ *  Implements the traversal of Amanatides and Woo ("A fast voxel traversal algorithm for ray
+ *  tracing", 1987): the cells along a ray are visited in order by stepping to the neighbor
+ *  whose boundary the ray crosses next, using one comparison and one addition per cell. The
+ *  traversal stops at the first occupied cell. Cells outside of the grid count as occupied,
+ *  as for @ref occupancy_grid::value.
+ *
+ *  The caster keeps a reference to the grid, which must outlive it.
+ *
+ *  @tparam TCell The cell type of the occupancy grid.
+ */
+template <typename TCell>
+class ray_caster {
+public:
+  /** Constructor
+   *  @param grid The occupancy grid.
+   */
+  explicit ray_caster(const occupancy_grid<TCell>& grid) : grid_(grid) {}
+
+  /** Casts a single ray.
+   *  @param origin Start of the ray.
+   *  @param angle Direction of the ray in [rad].
+   *  @param max_range Maximum length of the ray.
+   *  @returns the first occupied cell along the ray.
+   */
+  [[__nodiscard__]] ray_hit cast(const state_r2& origin, double angle,
+                                 double max_range) const noexcept {
+    return traverse(origin, std::cos(angle), std::sin(angle), max_range);
+  }
+
+  /** Casts rays from a common origin, e.g. the beams of a range sensor.
+   *  @param origin Start of all rays.
+   *  @param angles Directions of the rays in [rad].
+   *  @param max_range Maximum length of the rays.
+   *  @param ranges Receives the distance to the first occupied cell of each ray, or
+   *         @p max_range if there is none. Must have the same size as @p angles.
+   */
+  void cast(const state_r2& origin, span<const double> angles, double max_range,
+            span<double> ranges) const noexcept {
+    assert(ranges.size() == angles.size());
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+      ranges[i] = cast(origin, angles[i], max_range).distance;
+    }
+  }
+
+  /** Casts rays from a common origin in parallel.
+   *  @see cast(const state_r2&, span<const double>, double, span<double>) const
+   *  @param pool The threads to use.
+   *  @param grain Number of rays per task.
+   */
+  void cast(thread_pool& pool, const state_r2& origin, span<const double> angles,
+            double max_range, span<double> ranges, std::size_t grain = 256) const {
+    assert(ranges.size() == angles.size());
+    pool.parallel_for(angles.size(), grain, [&](std::size_t begin, std::size_t end) {
+      cast(origin, angles.subspan(begin, end - begin), max_range,
+           ranges.subspan(begin, end - begin));
+    });
+  }
+
+  /** Checks if a line segment passes through free cells only. Can be used as the collision
+   *  predicate of @ref simplify::shortcut.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param a Start of the segment.
+   *  @param b End of the segment.
+   *  @returns @c true if no cell that the segment passes through is occupied.
+   */
+  template <typename TState>
+  [[__nodiscard__]] bool segment_free(const TState& a, const TState& b) const noexcept {
+    static_assert(has_xy_v<TState>, "ray_caster: TState must have components x & y");
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    const double length = std::hypot(dx, dy);
+    if (length > 0.0) {
+      dx /= length;
+      dy /= length;
+    }
+    return !traverse(state_r2{a.x, a.y}, dx, dy, length).hit;
+  }
+
+  /** Checks pairs of states, e.g. shortcut candidates, see @ref segment_free.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param from Start points of the segments.
+   *  @param to End points of the segments. Must have the same size as @p from.
+   *  @param out Receives 1 for each free segment, else 0. Must have the same size as @p from.
+   */
+  template <typename TState>
+  void segments_free(span<const TState> from, span<const TState> to,
+                     span<std::uint8_t> out) const noexcept {
+    assert(to.size() == from.size() && out.size() == from.size());
+    for (std::size_t i = 0; i < from.size(); ++i) {
+      out[i] = segment_free(from[i], to[i]) ? 1 : 0;
+    }
+  }
+
+  /** Checks pairs of states in parallel.
+   *  @see segments_free(span<const TState>, span<const TState>, span<std::uint8_t>) const
+   *  @param pool The threads to use.
+   *  @param grain Number of segments per task.
+   */
+  template <typename TState>
+  void segments_free(thread_pool& pool, span<const TState> from, span<const TState> to,
+                     span<std::uint8_t> out, std::size_t grain = 256) const {
+    assert(to.size() == from.size() && out.size() == from.size());
+    pool.parallel_for(from.size(), grain, [&](std::size_t begin, std::size_t end) {
+      const std::size_t count = end - begin;
+      segments_free(from.subspan(begin, count), to.subspan(begin, count),
+                    out.subspan(begin, count));
+    });
+  }
+
+  /** Finds the first segment of a polyline that passes through an occupied cell.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The vertices of the polyline.
+   *  @returns 0 if the first point lies in an occupied cell, @c i if the segment from point
+   *           <tt>i - 1</tt> to point @c i is the first blocked one, or @c states.size() if
+   *           the polyline is free.
+   */
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(span<const TState> states) const noexcept {
+    if (states.empty()) {
+      return 0;
+    }
+    if (!segment_free(states[0], states[0])) {
+      return 0;
+    }
+    for (std::size_t i = 1; i < states.size(); ++i) {
+      if (!segment_free(states[i - 1], states[i])) {
+        return i;
+      }
+    }
+    return states.size();
+  }
+
+  /// @see first_intersection(span<const TState>) const
+  template <typename TState>
+  [[__nodiscard__]] std::size_t first_intersection(const path<TState>& states) const noexcept {
+    return first_intersection(states.states());
+  }
+
+private:
+  /// Walks from @p origin in the unit direction (@p dx, @p dy) for at most @p max_range.
+  [[__nodiscard__]] ray_hit traverse(const state_r2& origin, double dx, double dy,
+                                     double max_range) const noexcept {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    const double inverse_resolution = 1.0 / grid_.resolution();
+    // Position and range in cell units.
+    const double fx = (origin.x - grid_.origin().x) * inverse_resolution;
+    const double fy = (origin.y - grid_.origin().y) * inverse_resolution;
+    if (!std::isfinite(fx) || !std::isfinite(fy)) {
+      return {0.0, {-1, -1}, true};
+    }
+    const double max_t = max_range * inverse_resolution;
+    cell_index cell{floor_to_cell(fx), floor_to_cell(fy)};
+
+    const std::int64_t step_x = dx > 0.0 ? 1 : -1;
+    const std::int64_t step_y = dy > 0.0 ? 1 : -1;
+    // Ray parameter at the next cell boundary in x and y and between two boundaries.
+    double next_x = infinity;
+    double next_y = infinity;
+    double delta_x = infinity;
+    double delta_y = infinity;
+    if (dx != 0.0) {
+      delta_x = 1.0 / std::abs(dx);
+      next_x = (dx > 0.0 ? static_cast<double>(cell.x) + 1.0 - fx
+                         : fx - static_cast<double>(cell.x)) *
+               delta_x;
+    }
+    if (dy != 0.0) {
+      delta_y = 1.0 / std::abs(dy);
+      next_y = (dy > 0.0 ? static_cast<double>(cell.y) + 1.0 - fy
+                         : fy - static_cast<double>(cell.y)) *
+               delta_y;
+    }
+
+    double t = 0.0;
+    while (true) {
+      if (grid_.is_occupied_value(grid_.value(cell))) {
+        return {t * grid_.resolution(), cell, true};
+      }
+      if (next_x < next_y) {
+        t = next_x;
+        next_x += delta_x;
+        cell.x += step_x;
+      } else {
+        t = next_y;
+        next_y += delta_y;
+        cell.y += step_y;
+      }
+      if (!(t <= max_t)) {
+        return {max_range, cell, false};
+      }
+    }
+  }
+
+  /// The occupancy grid.
+  const occupancy_grid<TCell>& grid_;
+};
+
+} // namespace trailblaze::env
@@ -4,17 +4,30 @@
  * ------------------------------------------------------------------------- */
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "trailblaze/interval.h"
 #include "trailblaze/path.h"
 #include "trailblaze/sampling.h"
+#include "trailblaze/span.h"
 #include "trailblaze/state_spaces/state_space_r2.h"
 #include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/type_traits.h"
 
 namespace trailblaze::gen {
 
+/// Selects how generators evaluate sine and cosine of evenly spaced angles.
+enum class trig_mode : std::uint8_t {
+  /// @c std::sin and @c std::cos for every sample.
+  exact,
+  /// Rotation recurrence that is re-anchored with exact values every few samples.
+  recurrence
+};
+
 /** @brief Generate a straight line in state_r2 between two points.
  *
  */
@@ -120,29 +133,37 @@ inline std::vector<state_r2> generate_circle_arc_r2(const state_r2& center,
 }
 
 /**
- * Sample a parametric curve P : [t_begin, t_end] → state_r2 at evenly spaced parameters.
+ *  Generate a set of points along a circular arc in R^2, see the overload without
+ *  @p mode.
  *
- * This function generates a path in R^2 by evaluating a parametric curve at a specified
- * number of evenly spaced parameter values in [t_begin, t_end].
+ *  With @ref trig_mode::recurrence, consecutive samples are obtained by rotating the previous
+ *  one by the constant angular step, which costs four multiplications instead of a sine and
+ *  a cosine. Every @p anchor_interval samples and at the last sample the exact values are
+ *  used again, so the rounding drift of the recurrence cannot accumulate. The position error
+ *  is bounded by about <tt>anchor_interval * 5e-16 * radius</tt>, e.g. 1.6e-14 m for a 1 m
+ *  radius and the default interval. The first and last sample are exact.
  *
- * If the sampling policy requests zero samples, an empty vector is returned. If exactly
- * one sample is requested, the curve is evaluated at @p t_begin.
- *
- * @tparam Curve A callable type invocable as <tt>state_r2(double)</tt>.
- * @param curve The parametric curve to sample; called as <tt>curve(t)</tt>.
- * @param t_interval The interval [t_begin, t_end], where t_begin is the start and t_end
- *        is the end of the parameter interval.
- * @param sampling_policy Sampling policy indicating the number of samples to take
- *
- * @returns A vector of sampled states.
+ *  @param center The center of the circle in ℝ².
+ *  @param radius The circle's radius (must be non-negative).
+ *  @param start_angle The starting angle of the arc, in radians.
+ *  @param sweep_angle The total angular extent of the arc, in radians.
+ *  @param sampling_policy Sampling policy determining how many samples to generate.
+ *  @param mode How sine and cosine are evaluated.
+ *  @param anchor_interval Number of samples between exact evaluations, values < 1 are
+ *         treated as 1. Only used with @ref trig_mode::recurrence.
  *
- * @note This function performs no validation on the ordering of @p t_begin and @p t_end.
- *       If @p t_begin > @p t_end, sampling proceeds in decreasing parameter direction.
+ *  @return A vector of 2D states along the arc, evenly spaced by angle.
  */
-template <typename Curve>
-inline std::vector<state_r2>
-sample_parametric_curve_r2(const Curve& curve, const interval<double>& t_interval, double t_end,
-                           sampling::by_count sampling_policy) {
+inline std::vector<state_r2> generate_circle_arc_r2(const state_r2& center,
+                                                    double radius,      // NOLINT
+                                                    double start_angle, // NOLINT
+                                                    double sweep_angle, // NOLINT
+                                                    sampling::by_count sampling_policy,
+                                                    trig_mode mode,
+                                                    std::size_t anchor_interval = 32) {
+  if (mode == trig_mode::exact) {
+    return generate_circle_arc_r2(center, radius, start_angle, sweep_angle, sampling_policy);
+  }
   std::vector<state_r2> samples;
 
   const std::size_t sample_count = sampling_policy.n;
@@ -151,19 +172,108 @@ sample_parametric_curve_r2(const Curve& curve, const interval<double>& t_interva
   }
 
   samples.resize(sample_count);
+  anchor_interval = std::max<std::size_t>(anchor_interval, 1);
 
+  const double step =
+      (sample_count == 1) ? 0.0 : sweep_angle / static_cast<double>(sample_count - 1);
+  const double cos_step = std::cos(step);
+  const double sin_step = std::sin(step);
+
+  double cos_angle = 1.0;
+  double sin_angle = 0.0;
   for (std::size_t i = 0; i < sample_count; ++i) {
+    if (i % anchor_interval == 0 || i + 1 == sample_count) {
+      // Same angle as the exact mode.
+      const double normalized_position =
+          (sample_count == 1) ? 0.0
+                              : static_cast<double>(i) / static_cast<double>(sample_count - 1);
+      const double angle = start_angle + normalized_position * sweep_angle;
+      cos_angle = std::cos(angle);
+      sin_angle = std::sin(angle);
+    } else {
+      const double next_cos = cos_angle * cos_step - sin_angle * sin_step;
+      sin_angle = sin_angle * cos_step + cos_angle * sin_step;
+      cos_angle = next_cos;
+    }
+    samples[i].x = center.x + radius * cos_angle;
+    samples[i].y = center.y + radius * sin_angle;
+  }
+
+  return samples;
+}
+
+/// Maximum number of parameters passed to one call of a batch curve.
+inline constexpr std::size_t parametric_batch_size = 256;
+
+namespace detail {
+
+/** Samples @p curve at <tt>out.size()</tt> evenly spaced parameters of @p t_interval into
+ *  @p out, see @ref sample_parametric_curve_r2.
+ */
+template <typename Curve>
+inline void sample_parametric_curve_r2(const Curve& curve, const interval<double>& t_interval,
+                                       span<state_r2> out) {
+  const std::size_t sample_count = out.size();
+
+  const auto parameter_at = [&](std::size_t i) {
     // Normalized position in [0, 1] across the index range [0, sample_count-1].
     const double normalized_position =
         (sample_count == 1) ? 0.0 : static_cast<double>(i) / static_cast<double>(sample_count - 1);
 
     // Linear interpolation of t between t_begin and t_end.
-    const double parameter_t = (1.0 - normalized_position) * t_interval.lower_bound +
-                               normalized_position * t_interval.upper_bound;
+    return (1.0 - normalized_position) * t_interval.lower_bound +
+           normalized_position * t_interval.upper_bound;
+  };
 
-    samples[i] = curve(parameter_t);
+  if constexpr (is_batch_curve_v<Curve, state_r2>) {
+    // Chunks keep the parameters (and the curve's scratch buffers) in L1 cache.
+    std::array<double, parametric_batch_size> parameters{};
+    for (std::size_t offset = 0; offset < sample_count; offset += parametric_batch_size) {
+      const std::size_t count = std::min(parametric_batch_size, sample_count - offset);
+      for (std::size_t i = 0; i < count; ++i) {
+        parameters[i] = parameter_at(offset + i);
+      }
+      curve(span<const double>(parameters.data(), count),
+            span<state_r2>(out.data() + offset, count));
+    }
+  } else {
+    for (std::size_t i = 0; i < sample_count; ++i) {
+      out[i] = curve(parameter_at(i));
+    }
   }
+}
 
+} // namespace detail
+
+/**
+ * Sample a parametric curve P : [t_begin, t_end] → state_r2 at evenly spaced parameters.
+ *
+ * This function generates a path in R^2 by evaluating a parametric curve at a specified
+ * number of evenly spaced parameter values in [t_begin, t_end].
+ *
+ * If the sampling policy requests zero samples, an empty vector is returned. If exactly
+ * one sample is requested, the curve is evaluated at @p t_begin.
+ *
+ * @tparam Curve A callable type invocable as <tt>state_r2(double)</tt>. If the curve is a
+ *         batch curve (see @ref is_batch_curve_v), it is called with chunks of at most
+ *         @ref parametric_batch_size parameters instead, which lets it use batched math such
+ *         as @ref sincos.
+ * @param curve The parametric curve to sample; called as <tt>curve(t)</tt>.
+ * @param t_interval The interval [t_begin, t_end], where t_begin is the start and t_end
+ *        is the end of the parameter interval.
+ * @param sampling_policy Sampling policy indicating the number of samples to take
+ *
+ * @returns A vector of sampled states.
+ *
+ * @note This function performs no validation on the ordering of @p t_begin and @p t_end.
+ *       If @p t_begin > @p t_end, sampling proceeds in decreasing parameter direction.
+ */
+template <typename Curve>
+inline std::vector<state_r2>
+sample_parametric_curve_r2(const Curve& curve, const interval<double>& t_interval, double t_end,
+                           sampling::by_count sampling_policy) {
+  std::vector<state_r2> samples(sampling_policy.n);
+  detail::sample_parametric_curve_r2(curve, t_interval, span<state_r2>(samples));
   return samples;
 }
 
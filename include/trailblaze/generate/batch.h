@@ -0,0 +1,89 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cstddef>
+
+#include "trailblaze/generate.h"
+#include "trailblaze/interval.h"
+#include "trailblaze/ragged_buffer.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze::gen {
+
+/** Parameters of one candidate for @ref parametric_generator.
+ *  @tparam Curve A parametric curve, see @ref sample_parametric_curve_r2.
+ */
+template <typename Curve>
+struct parametric_candidate {
+  /// The curve to sample.
+  Curve curve;
+  /// The parameter interval [t_begin, t_end].
+  interval<double> range;
+  /// Number of evenly spaced samples.
+  sampling::by_count sampling;
+};
+
+/// Generator for @ref generate_batch that samples @ref parametric_candidate "parametric curves".
+struct parametric_generator {
+  /// @returns the number of samples of @p candidate.
+  template <typename Curve>
+  [[__nodiscard__]] std::size_t sample_count(const parametric_candidate<Curve>& candidate) const {
+    return candidate.sampling.n;
+  }
+
+  /// Samples @p candidate into @p out, see @ref sample_parametric_curve_r2.
+  template <typename Curve>
+  void operator()(const parametric_candidate<Curve>& candidate, span<state_r2> out) const {
+    detail::sample_parametric_curve_r2(candidate.curve, candidate.range, out);
+  }
+};
+
+/** Generates one candidate path per parameter set into a ragged buffer.
+ *
+ *  The sample counts of all candidates are determined first, then @p out is reshaped once and
+ *  every candidate writes its samples directly into its row. Nothing is allocated per
+ *  candidate, and nothing at all once @p out has reached its largest size.
+ *
+ *  @tparam Generator Type with <tt>std::size_t sample_count(const Params&)</tt> and
+ *          <tt>void operator()(const Params&, span<TState>)</tt>, where the span has exactly
+ *          @c sample_count elements. Both are called concurrently and must not modify shared
+ *          state.
+ *  @param generator The generator.
+ *  @param params One parameter set per candidate.
+ *  @param out Receives the samples of candidate @c i in row @c i.
+ */
+template <typename Generator, typename Params, typename TState>
+void generate_batch(const Generator& generator, span<const Params> params,
+                    ragged_buffer<TState>& out) {
+  out.reshape(params.size(), [&](std::size_t i) { return generator.sample_count(params[i]); });
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    generator(params[i], out[i]);
+  }
+}
+
+/** Generates one candidate path per parameter set into a ragged buffer, see the overload
+ *  without @p pool. The candidates are distributed over the threads of @p pool.
+ *
+ *  @param pool The threads that generate the candidates.
+ *  @param generator The generator.
+ *  @param params One parameter set per candidate.
+ *  @param out Receives the samples of candidate @c i in row @c i.
+ *  @param grain Number of candidates that a thread takes at once.
+ */
+template <typename Generator, typename Params, typename TState>
+void generate_batch(thread_pool& pool, const Generator& generator, span<const Params> params,
+                    ragged_buffer<TState>& out, std::size_t grain = 16) {
+  out.reshape(params.size(), [&](std::size_t i) { return generator.sample_count(params[i]); });
+  pool.parallel_for(params.size(), grain, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      generator(params[i], out[i]);
+    }
+  });
+}
+
+} // namespace trailblaze::gen
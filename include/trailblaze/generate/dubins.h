@@ -0,0 +1,198 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "trailblaze/generate/turning_curve.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+/** @file dubins.h
+ *  @brief Shortest forward-only paths with bounded curvature (Dubins curves).
+ *
+ *  The six candidate words LSL, RSR, RSL, LSR, RLR and LRL are evaluated in closed form,
+ *  following Shkel and Lumelsky, "Classification of the Dubins set" (2001).
+ */
+
+namespace trailblaze::gen {
+
+namespace detail {
+
+/// Maps an angle to [0, 2 Pi).
+inline double mod_two_pi(double angle) {
+  const double result = std::fmod(angle, numbers::two_pi);
+  return result < 0.0 ? result + numbers::two_pi : result;
+}
+
+/** Evaluates all Dubins words in the normalized frame and reports each feasible one.
+ *
+ *  @param d Start-goal distance in units of the turning radius.
+ *  @param alpha Start heading relative to the start-goal direction, in [0, 2 Pi).
+ *  @param beta Goal heading relative to the start-goal direction, in [0, 2 Pi).
+ *  @param report Callable as <tt>report(steering, steering, steering, t, p, q)</tt>.
+ */
+template <typename Report>
+void dubins_words(double d, double alpha, double beta, Report&& report) {
+  constexpr double zero = -1e-9;
+  const double ca = std::cos(alpha);
+  const double sa = std::sin(alpha);
+  const double cb = std::cos(beta);
+  const double sb = std::sin(beta);
+  const double cab = ca * cb + sa * sb;
+  const double d2 = d * d;
+
+  // LSL
+  double tmp = 2.0 + d2 - 2.0 * (cab - d * (sa - sb));
+  if (tmp >= zero) {
+    const double theta = std::atan2(cb - ca, d + sa - sb);
+    report(steering::left, steering::straight, steering::left, mod_two_pi(-alpha + theta),
+           std::sqrt(std::max(tmp, 0.0)), mod_two_pi(beta - theta));
+  }
+  // RSR
+  tmp = 2.0 + d2 - 2.0 * (cab - d * (sb - sa));
+  if (tmp >= zero) {
+    const double theta = std::atan2(ca - cb, d - sa + sb);
+    report(steering::right, steering::straight, steering::right, mod_two_pi(alpha - theta),
+           std::sqrt(std::max(tmp, 0.0)), mod_two_pi(-beta + theta));
+  }
+  // RSL
+  tmp = d2 - 2.0 + 2.0 * (cab - d * (sa + sb));
+  if (tmp >= zero) {
+    const double p = std::sqrt(std::max(tmp, 0.0));
+    const double theta = std::atan2(ca + cb, d - sa - sb) - std::atan2(2.0, p);
+    report(steering::right, steering::straight, steering::left, mod_two_pi(alpha - theta), p,
+           mod_two_pi(beta - theta));
+  }
+  // LSR
+  tmp = -2.0 + d2 + 2.0 * (cab + d * (sa + sb));
+  if (tmp >= zero) {
+    const double p = std::sqrt(std::max(tmp, 0.0));
+    const double theta = std::atan2(-ca - cb, d + sa + sb) - std::atan2(-2.0, p);
+    report(steering::left, steering::straight, steering::right, mod_two_pi(-alpha + theta), p,
+           mod_two_pi(-beta + theta));
+  }
+  // RLR
+  tmp = 0.125 * (6.0 - d2 + 2.0 * (cab + d * (sa - sb)));
+  if (std::fabs(tmp) < 1.0) {
+    const double p = numbers::two_pi - std::acos(tmp);
+    const double theta = std::atan2(ca - cb, d - sa + sb);
+    const double t = mod_two_pi(alpha - theta + 0.5 * p);
+    report(steering::right, steering::left, steering::right, t, p,
+           mod_two_pi(alpha - beta - t + p));
+  }
+  // LRL
+  tmp = 0.125 * (6.0 - d2 + 2.0 * (cab - d * (sa - sb)));
+  if (std::fabs(tmp) < 1.0) {
+    const double p = numbers::two_pi - std::acos(tmp);
+    const double theta = std::atan2(-ca + cb, d + sa - sb);
+    const double t = mod_two_pi(-alpha + theta + 0.5 * p);
+    report(steering::left, steering::right, steering::left, t, p,
+           mod_two_pi(beta - alpha - t + p));
+  }
+}
+
+/// Normalized problem parameters, see dubins_words().
+struct dubins_frame {
+  double d;
+  double alpha;
+  double beta;
+};
+
+inline dubins_frame make_dubins_frame(const state_se2& start, const state_se2& goal,
+                                      double radius) {
+  const double dx = goal.x - start.x;
+  const double dy = goal.y - start.y;
+  const double theta = std::atan2(dy, dx);
+  return {std::hypot(dx, dy) / radius, mod_two_pi(start.yaw - theta),
+          mod_two_pi(goal.yaw - theta)};
+}
+
+} // namespace detail
+
+/** Computes the shortest Dubins curve between two states.
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @returns the shortest curve. Use @ref sample or @ref turning_curve::state_at to evaluate
+ *           it from @p start.
+ */
+inline turning_curve dubins_curve(const state_se2& start, const state_se2& goal, double radius) {
+  assert(radius > 0.0);
+  const detail::dubins_frame frame = detail::make_dubins_frame(start, goal, radius);
+  turning_curve best;
+  best.radius = radius;
+  double best_length = std::numeric_limits<double>::infinity();
+  detail::dubins_words(frame.d, frame.alpha, frame.beta,
+                       [&](steering first, steering second, steering third, double t, double p,
+                           double q) {
+                         const double length = t + p + q;
+                         if (length < best_length) {
+                           best_length = length;
+                           best.segments[0] = {first, t};
+                           best.segments[1] = {second, p};
+                           best.segments[2] = {third, q};
+                           best.segment_count = 3;
+                         }
+                       });
+  return best;
+}
+
+/** Computes the length of the shortest Dubins curve between two states.
+ *
+ *  This is the fast path for planners that only need the distance: it evaluates the same
+ *  closed form solutions as @ref dubins_curve, but only keeps the minimum length.
+ *
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @returns the length of the shortest curve.
+ */
+inline double dubins_distance(const state_se2& start, const state_se2& goal, double radius) {
+  assert(radius > 0.0);
+  const detail::dubins_frame frame = detail::make_dubins_frame(start, goal, radius);
+  double best_length = std::numeric_limits<double>::infinity();
+  detail::dubins_words(
+      frame.d, frame.alpha, frame.beta,
+      [&best_length](steering, steering, steering, double t, double p, double q) {
+        best_length = std::min(best_length, t + p + q);
+      });
+  return radius * best_length;
+}
+
+/** Computes Dubins distances from one start to many goals.
+ *  @param start The start state.
+ *  @param goals The goal states.
+ *  @param radius The minimum turning radius, > 0.
+ *  @param out Receives one distance per goal. Must hold at least @c goals.size() values.
+ */
+inline void dubins_distance(const state_se2& start, span<const state_se2> goals, double radius,
+                            span<double> out) {
+  assert(out.size() >= goals.size());
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    out[i] = dubins_distance(start, goals[i], radius);
+  }
+}
+
+/** Generates the shortest Dubins path between two states.
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @param policy Sampling policy, see @ref sample.
+ *  @returns the sampled path.
+ */
+template <typename Policy>
+path<state_se2> dubins(const state_se2& start, const state_se2& goal, double radius,
+                       Policy policy) {
+  return sample(dubins_curve(start, goal, radius), start, policy);
+}
+
+} // namespace trailblaze::gen
@@ -0,0 +1,464 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+
+#include "trailblaze/generate/turning_curve.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+/** @file reeds_shepp.h
+ *  @brief Shortest paths with bounded curvature that may drive forwards and backwards
+ *         (Reeds-Shepp curves).
+ *
+ *  The candidate words are evaluated with the closed form solutions of Reeds and Shepp,
+ *  "Optimal paths for a car that goes both forwards and backwards" (1990), sections 8.1 to
+ *  8.11, including the corrections that are commonly applied to the formulas of the paper.
+ *  Each formula is combined with the time-flip, reflection and backwards symmetries.
+ */
+
+namespace trailblaze::gen {
+
+namespace detail {
+
+/// Tolerance used when checking the sign conditions of the Reeds-Shepp formulas.
+inline constexpr double rs_zero = 10.0 * std::numeric_limits<double>::epsilon();
+
+/// Maps an angle to [-Pi, Pi].
+inline double rs_mod_pi(double angle) {
+  double result = std::fmod(angle, numbers::two_pi);
+  if (result < -numbers::pi) {
+    result += numbers::two_pi;
+  } else if (result > numbers::pi) {
+    result -= numbers::two_pi;
+  }
+  return result;
+}
+
+inline void rs_polar(double x, double y, double& radius, double& angle) {
+  radius = std::sqrt(x * x + y * y);
+  angle = std::atan2(y, x);
+}
+
+inline void rs_tau_omega(double u, double v, double xi, double eta, double phi, double& tau,
+                         double& omega) {
+  const double delta = rs_mod_pi(u - v);
+  const double a = std::sin(u) - std::sin(delta);
+  const double b = std::cos(u) - std::cos(delta) - 1.0;
+  const double t1 = std::atan2(eta * a - xi * b, xi * a + eta * b);
+  const double t2 = 2.0 * (std::cos(delta) - std::cos(v) - std::cos(u)) + 3.0;
+  tau = (t2 < 0.0) ? rs_mod_pi(t1 + numbers::pi) : rs_mod_pi(t1);
+  omega = rs_mod_pi(tau - u + v - phi);
+}
+
+// formula 8.1
+inline bool rs_lp_sp_lp(double x, double y, double phi, double& t, double& u, double& v) {
+  rs_polar(x - std::sin(phi), y - 1.0 + std::cos(phi), u, t);
+  if (t >= -rs_zero) {
+    v = rs_mod_pi(phi - t);
+    return v >= -rs_zero;
+  }
+  return false;
+}
+
+// formula 8.2
+inline bool rs_lp_sp_rp(double x, double y, double phi, double& t, double& u, double& v) {
+  double t1 = 0.0;
+  double u1 = 0.0;
+  rs_polar(x + std::sin(phi), y - 1.0 - std::cos(phi), u1, t1);
+  u1 = u1 * u1;
+  if (u1 >= 4.0) {
+    u = std::sqrt(u1 - 4.0);
+    const double theta = std::atan2(2.0, u);
+    t = rs_mod_pi(t1 + theta);
+    v = rs_mod_pi(t - phi);
+    return t >= -rs_zero && v >= -rs_zero;
+  }
+  return false;
+}
+
+// formula 8.3 / 8.4
+inline bool rs_lp_rm_l(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x - std::sin(phi);
+  const double eta = y - 1.0 + std::cos(phi);
+  double u1 = 0.0;
+  double theta = 0.0;
+  rs_polar(xi, eta, u1, theta);
+  if (u1 <= 4.0) {
+    u = -2.0 * std::asin(0.25 * u1);
+    t = rs_mod_pi(theta + 0.5 * u + numbers::pi);
+    v = rs_mod_pi(phi - t + u);
+    return t >= -rs_zero && u <= rs_zero;
+  }
+  return false;
+}
+
+// formula 8.7
+inline bool rs_lp_rup_lum_rm(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x + std::sin(phi);
+  const double eta = y - 1.0 - std::cos(phi);
+  const double rho = 0.25 * (2.0 + std::sqrt(xi * xi + eta * eta));
+  if (rho <= 1.0) {
+    u = std::acos(rho);
+    rs_tau_omega(u, -u, xi, eta, phi, t, v);
+    return t >= -rs_zero && v <= rs_zero;
+  }
+  return false;
+}
+
+// formula 8.8
+inline bool rs_lp_rum_lum_rp(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x + std::sin(phi);
+  const double eta = y - 1.0 - std::cos(phi);
+  const double rho = (20.0 - xi * xi - eta * eta) / 16.0;
+  if (rho >= 0.0 && rho <= 1.0) {
+    u = -std::acos(rho);
+    if (u >= -0.5 * numbers::pi) {
+      rs_tau_omega(u, u, xi, eta, phi, t, v);
+      return t >= -rs_zero && v >= -rs_zero;
+    }
+  }
+  return false;
+}
+
+// formula 8.9
+inline bool rs_lp_rm_sm_lm(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x - std::sin(phi);
+  const double eta = y - 1.0 + std::cos(phi);
+  double rho = 0.0;
+  double theta = 0.0;
+  rs_polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    const double r = std::sqrt(rho * rho - 4.0);
+    u = 2.0 - r;
+    t = rs_mod_pi(theta + std::atan2(r, -2.0));
+    v = rs_mod_pi(phi - 0.5 * numbers::pi - t);
+    return t >= -rs_zero && u <= rs_zero && v <= rs_zero;
+  }
+  return false;
+}
+
+// formula 8.10
+inline bool rs_lp_rm_sm_rm(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x + std::sin(phi);
+  const double eta = y - 1.0 - std::cos(phi);
+  double rho = 0.0;
+  double theta = 0.0;
+  rs_polar(-eta, xi, rho, theta);
+  if (rho >= 2.0) {
+    t = theta;
+    u = 2.0 - rho;
+    v = rs_mod_pi(t + 0.5 * numbers::pi - phi);
+    return t >= -rs_zero && u <= rs_zero && v <= rs_zero;
+  }
+  return false;
+}
+
+// formula 8.11
+inline bool rs_lp_rm_s_lm_rp(double x, double y, double phi, double& t, double& u, double& v) {
+  const double xi = x + std::sin(phi);
+  const double eta = y - 1.0 - std::cos(phi);
+  double rho = 0.0;
+  double theta = 0.0;
+  rs_polar(xi, eta, rho, theta);
+  if (rho >= 2.0) {
+    u = 4.0 - std::sqrt(rho * rho - 4.0);
+    if (u <= rs_zero) {
+      t = rs_mod_pi(std::atan2((4.0 - u) * xi - 2.0 * eta, -2.0 * xi + (u - 4.0) * eta));
+      v = rs_mod_pi(t - phi);
+      return t >= -rs_zero && v >= -rs_zero;
+    }
+  }
+  return false;
+}
+
+/// Keeps the shortest candidate word found so far.
+struct rs_search {
+  turning_curve best;
+  double best_length{std::numeric_limits<double>::infinity()};
+
+  /** Offers a candidate.
+   *  @param types The steering commands of the word.
+   *  @param lengths The signed segment lengths, same size as @p types.
+   */
+  void offer(std::initializer_list<steering> types, std::initializer_list<double> lengths) {
+    double length = 0.0;
+    for (const double segment : lengths) {
+      length += std::fabs(segment);
+    }
+    if (length >= best_length) {
+      return;
+    }
+    best_length = length;
+    best.segment_count = types.size();
+    const auto* type = types.begin();
+    const auto* segment = lengths.begin();
+    for (std::size_t i = 0; i < types.size(); ++i, ++type, ++segment) {
+      best.segments[i] = {*type, *segment};
+    }
+  }
+};
+
+constexpr steering rs_l = steering::left;
+constexpr steering rs_r = steering::right;
+constexpr steering rs_s = steering::straight;
+
+inline void rs_csc(double x, double y, double phi, rs_search& search) {
+  double t = 0.0;
+  double u = 0.0;
+  double v = 0.0;
+  if (rs_lp_sp_lp(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_s, rs_l}, {t, u, v});
+  }
+  if (rs_lp_sp_lp(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_s, rs_l}, {-t, -u, -v});
+  }
+  if (rs_lp_sp_lp(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_s, rs_r}, {t, u, v});
+  }
+  if (rs_lp_sp_lp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_s, rs_r}, {-t, -u, -v});
+  }
+  if (rs_lp_sp_rp(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_s, rs_r}, {t, u, v});
+  }
+  if (rs_lp_sp_rp(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_s, rs_r}, {-t, -u, -v});
+  }
+  if (rs_lp_sp_rp(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_s, rs_l}, {t, u, v});
+  }
+  if (rs_lp_sp_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_s, rs_l}, {-t, -u, -v});
+  }
+}
+
+inline void rs_ccc(double x, double y, double phi, rs_search& search) {
+  double t = 0.0;
+  double u = 0.0;
+  double v = 0.0;
+  if (rs_lp_rm_l(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_l}, {t, u, v});
+  }
+  if (rs_lp_rm_l(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_l}, {-t, -u, -v});
+  }
+  if (rs_lp_rm_l(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_r}, {t, u, v});
+  }
+  if (rs_lp_rm_l(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_r}, {-t, -u, -v});
+  }
+
+  // backwards
+  const double xb = x * std::cos(phi) + y * std::sin(phi);
+  const double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (rs_lp_rm_l(xb, yb, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_l}, {v, u, t});
+  }
+  if (rs_lp_rm_l(-xb, yb, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_l}, {-v, -u, -t});
+  }
+  if (rs_lp_rm_l(xb, -yb, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_r}, {v, u, t});
+  }
+  if (rs_lp_rm_l(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_r}, {-v, -u, -t});
+  }
+}
+
+inline void rs_cccc(double x, double y, double phi, rs_search& search) {
+  double t = 0.0;
+  double u = 0.0;
+  double v = 0.0;
+  if (rs_lp_rup_lum_rm(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_l, rs_r}, {t, u, -u, v});
+  }
+  if (rs_lp_rup_lum_rm(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_l, rs_r}, {-t, -u, u, -v});
+  }
+  if (rs_lp_rup_lum_rm(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_r, rs_l}, {t, u, -u, v});
+  }
+  if (rs_lp_rup_lum_rm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_r, rs_l}, {-t, -u, u, -v});
+  }
+
+  if (rs_lp_rum_lum_rp(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_l, rs_r}, {t, u, u, v});
+  }
+  if (rs_lp_rum_lum_rp(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_l, rs_r}, {-t, -u, -u, -v});
+  }
+  if (rs_lp_rum_lum_rp(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_r, rs_l}, {t, u, u, v});
+  }
+  if (rs_lp_rum_lum_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_r, rs_l}, {-t, -u, -u, -v});
+  }
+}
+
+inline void rs_ccsc(double x, double y, double phi, rs_search& search) {
+  constexpr double half_pi = 0.5 * numbers::pi;
+  double t = 0.0;
+  double u = 0.0;
+  double v = 0.0;
+  if (rs_lp_rm_sm_lm(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_s, rs_l}, {t, -half_pi, u, v});
+  }
+  if (rs_lp_rm_sm_lm(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_s, rs_l}, {-t, half_pi, -u, -v});
+  }
+  if (rs_lp_rm_sm_lm(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_s, rs_r}, {t, -half_pi, u, v});
+  }
+  if (rs_lp_rm_sm_lm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_s, rs_r}, {-t, half_pi, -u, -v});
+  }
+
+  if (rs_lp_rm_sm_rm(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_s, rs_r}, {t, -half_pi, u, v});
+  }
+  if (rs_lp_rm_sm_rm(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_s, rs_r}, {-t, half_pi, -u, -v});
+  }
+  if (rs_lp_rm_sm_rm(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_s, rs_l}, {t, -half_pi, u, v});
+  }
+  if (rs_lp_rm_sm_rm(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_s, rs_l}, {-t, half_pi, -u, -v});
+  }
+
+  // backwards
+  const double xb = x * std::cos(phi) + y * std::sin(phi);
+  const double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (rs_lp_rm_sm_lm(xb, yb, phi, t, u, v)) {
+    search.offer({rs_l, rs_s, rs_r, rs_l}, {v, u, -half_pi, t});
+  }
+  if (rs_lp_rm_sm_lm(-xb, yb, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_s, rs_r, rs_l}, {-v, -u, half_pi, -t});
+  }
+  if (rs_lp_rm_sm_lm(xb, -yb, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_s, rs_l, rs_r}, {v, u, -half_pi, t});
+  }
+  if (rs_lp_rm_sm_lm(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_s, rs_l, rs_r}, {-v, -u, half_pi, -t});
+  }
+
+  if (rs_lp_rm_sm_rm(xb, yb, phi, t, u, v)) {
+    search.offer({rs_r, rs_s, rs_r, rs_l}, {v, u, -half_pi, t});
+  }
+  if (rs_lp_rm_sm_rm(-xb, yb, -phi, t, u, v)) { // timeflip
+    search.offer({rs_r, rs_s, rs_r, rs_l}, {-v, -u, half_pi, -t});
+  }
+  if (rs_lp_rm_sm_rm(xb, -yb, -phi, t, u, v)) { // reflect
+    search.offer({rs_l, rs_s, rs_l, rs_r}, {v, u, -half_pi, t});
+  }
+  if (rs_lp_rm_sm_rm(-xb, -yb, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_l, rs_s, rs_l, rs_r}, {-v, -u, half_pi, -t});
+  }
+}
+
+inline void rs_ccscc(double x, double y, double phi, rs_search& search) {
+  constexpr double half_pi = 0.5 * numbers::pi;
+  double t = 0.0;
+  double u = 0.0;
+  double v = 0.0;
+  if (rs_lp_rm_s_lm_rp(x, y, phi, t, u, v)) {
+    search.offer({rs_l, rs_r, rs_s, rs_l, rs_r}, {t, -half_pi, u, -half_pi, v});
+  }
+  if (rs_lp_rm_s_lm_rp(-x, y, -phi, t, u, v)) { // timeflip
+    search.offer({rs_l, rs_r, rs_s, rs_l, rs_r}, {-t, half_pi, -u, half_pi, -v});
+  }
+  if (rs_lp_rm_s_lm_rp(x, -y, -phi, t, u, v)) { // reflect
+    search.offer({rs_r, rs_l, rs_s, rs_r, rs_l}, {t, -half_pi, u, -half_pi, v});
+  }
+  if (rs_lp_rm_s_lm_rp(-x, -y, phi, t, u, v)) { // timeflip + reflect
+    search.offer({rs_r, rs_l, rs_s, rs_r, rs_l}, {-t, half_pi, -u, half_pi, -v});
+  }
+}
+
+/// Runs all word families on the normalized problem (start at the origin, yaw 0, radius 1).
+inline rs_search reeds_shepp_search(const state_se2& start, const state_se2& goal,
+                                    double radius) {
+  const double dx = goal.x - start.x;
+  const double dy = goal.y - start.y;
+  const double c = std::cos(start.yaw);
+  const double s = std::sin(start.yaw);
+  const double x = (c * dx + s * dy) / radius;
+  const double y = (-s * dx + c * dy) / radius;
+  const double phi = goal.yaw - start.yaw;
+
+  rs_search search;
+  search.best.radius = radius;
+  rs_csc(x, y, phi, search);
+  rs_ccc(x, y, phi, search);
+  rs_cccc(x, y, phi, search);
+  rs_ccsc(x, y, phi, search);
+  rs_ccscc(x, y, phi, search);
+  return search;
+}
+
+} // namespace detail
+
+/** Computes the shortest Reeds-Shepp curve between two states.
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @returns the shortest curve. Segments with negative length are driven backwards.
+ */
+inline turning_curve reeds_shepp_curve(const state_se2& start, const state_se2& goal,
+                                       double radius) {
+  assert(radius > 0.0);
+  return detail::reeds_shepp_search(start, goal, radius).best;
+}
+
+/** Computes the length of the shortest Reeds-Shepp curve between two states.
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @returns the length of the shortest curve.
+ */
+inline double reeds_shepp_distance(const state_se2& start, const state_se2& goal,
+                                   double radius) {
+  assert(radius > 0.0);
+  return radius * detail::reeds_shepp_search(start, goal, radius).best_length;
+}
+
+/** Computes Reeds-Shepp distances from one start to many goals.
+ *  @param start The start state.
+ *  @param goals The goal states.
+ *  @param radius The minimum turning radius, > 0.
+ *  @param out Receives one distance per goal. Must hold at least @c goals.size() values.
+ */
+inline void reeds_shepp_distance(const state_se2& start, span<const state_se2> goals,
+                                 double radius, span<double> out) {
+  assert(out.size() >= goals.size());
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    out[i] = reeds_shepp_distance(start, goals[i], radius);
+  }
+}
+
+/** Generates the shortest Reeds-Shepp path between two states.
+ *  @param start The start state.
+ *  @param goal The goal state.
+ *  @param radius The minimum turning radius, > 0.
+ *  @param policy Sampling policy, see @ref sample.
+ *  @returns the sampled path.
+ */
+template <typename Policy>
+path<state_se2> reeds_shepp(const state_se2& start, const state_se2& goal, double radius,
+                            Policy policy) {
+  return sample(reeds_shepp_curve(start, goal, radius), start, policy);
+}
+
+} // namespace trailblaze::gen
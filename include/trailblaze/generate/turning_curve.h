@@ -0,0 +1,140 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "trailblaze/math/angle.h"
+#include "trailblaze/path.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze::gen {
+
+/// Steering command of one segment of a turning curve.
+enum class steering : std::uint8_t { left, straight, right };
+
+/// One segment of a turning curve.
+struct curve_segment {
+  /// The steering command.
+  steering type{steering::straight};
+  /// Segment length in units of the turning radius. Negative lengths drive backwards.
+  double length{0.};
+};
+
+/** A curve made of circular arcs with a fixed turning radius and straight lines.
+ *
+ *  This is the common result type of the Dubins and Reeds-Shepp generators. The curve does
+ *  not store its start state; it is passed to the evaluation functions instead, so the same
+ *  curve can be placed anywhere.
+ */
+struct turning_curve {
+  /// The segments, only the first @ref segment_count are used.
+  std::array<curve_segment, 5> segments{};
+  /// The number of used segments.
+  std::size_t segment_count{0};
+  /// The turning radius.
+  double radius{1.};
+
+  /// @returns the length of the curve.
+  [[__nodiscard__]] double length() const {
+    double total = 0.0;
+    for (std::size_t i = 0; i < segment_count; ++i) {
+      total += std::fabs(segments[i].length);
+    }
+    return radius * total;
+  }
+
+  /** Evaluates the curve.
+   *  @param start The start state of the curve.
+   *  @param arc_length Distance travelled along the curve, clamped to [0, length()].
+   *  @returns the state at @p arc_length. The yaw is the heading of the vehicle, which does
+   *           not flip while driving backwards.
+   */
+  [[__nodiscard__]] state_se2 state_at(const state_se2& start, double arc_length) const {
+    // Integrate in unit-radius coordinates, then scale.
+    double remaining = (arc_length > 0.0 ? arc_length : 0.0) / radius;
+    double x = 0.0;
+    double y = 0.0;
+    double yaw = start.yaw;
+    for (std::size_t i = 0; i < segment_count && remaining > 0.0; ++i) {
+      const double length = segments[i].length;
+      const double magnitude = std::min(std::fabs(length), remaining);
+      const double step = length < 0.0 ? -magnitude : magnitude;
+      remaining -= magnitude;
+      switch (segments[i].type) {
+      case steering::left:
+        x += std::sin(yaw + step) - std::sin(yaw);
+        y += -std::cos(yaw + step) + std::cos(yaw);
+        yaw += step;
+        break;
+      case steering::right:
+        x += -std::sin(yaw - step) + std::sin(yaw);
+        y += std::cos(yaw - step) - std::cos(yaw);
+        yaw -= step;
+        break;
+      case steering::straight:
+        x += step * std::cos(yaw);
+        y += step * std::sin(yaw);
+        break;
+      }
+    }
+    return {start.x + radius * x, start.y + radius * y, normalized(yaw)};
+  }
+};
+
+/** Samples a turning curve at evenly spaced arc lengths.
+ *  @param curve The curve.
+ *  @param start The start state of the curve.
+ *  @param policy The number of samples. The first and last samples are the curve ends.
+ *  @returns the sampled states.
+ */
+inline path<state_se2> sample(const turning_curve& curve, const state_se2& start,
+                              sampling::by_count policy) {
+  path<state_se2> out;
+  if (policy.n == 0) {
+    return out;
+  }
+  out.resize(policy.n);
+  const double length = curve.length();
+  for (std::size_t i = 0; i < policy.n; ++i) {
+    const double ratio =
+        (policy.n == 1) ? 0.0 : static_cast<double>(i) / static_cast<double>(policy.n - 1);
+    out[i] = curve.state_at(start, ratio * length);
+  }
+  return out;
+}
+
+/** Samples a turning curve with a fixed arc length step.
+ *  @param curve The curve.
+ *  @param start The start state of the curve.
+ *  @param policy The step between samples. The curve end is always added as last sample.
+ *  @returns the sampled states.
+ */
+inline path<state_se2> sample(const turning_curve& curve, const state_se2& start,
+                              sampling::by_step policy) {
+  const double length = curve.length();
+  if (policy.step <= 0.0 || length <= 0.0) {
+    path<state_se2> out;
+    out.push_back(curve.state_at(start, 0.0));
+    if (length > 0.0) {
+      out.push_back(curve.state_at(start, length));
+    }
+    return out;
+  }
+  const auto steps = static_cast<std::size_t>(std::ceil(length / policy.step - 1e-9));
+  path<state_se2> out;
+  out.resize(steps + 1);
+  for (std::size_t i = 0; i < steps; ++i) {
+    out[i] = curve.state_at(start, static_cast<double>(i) * policy.step);
+  }
+  out[steps] = curve.state_at(start, length);
+  return out;
+}
+
+} // namespace trailblaze::gen
@@ -3,9 +3,30 @@
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
 #pragma once
+#include <cassert>
+#include <cstddef>
+
+#include "trailblaze/detail/type_traits.h"
+#include "trailblaze/span.h"
 
 namespace trailblaze {
 
+namespace detail {
+
+/// Runs a piece on a whole batch, falling back to per-ratio calls if it has no batch version.
+template <typename Piece, typename T>
+void apply_piece_batch(const T& a, const T& b, span<const double> ratios, span<T> out) {
+  if constexpr (has_apply_batch<Piece, T>::value) {
+    Piece::apply_batch(a, b, ratios, out);
+  } else {
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      Piece::apply(a, b, ratios[i], out[i]);
+    }
+  }
+}
+
+} // namespace detail
+
 /** Composition of interpolation functions.
  *
  *  In case a state space is a composite, state interpolation will usually also be a
@@ -15,6 +36,14 @@ namespace trailblaze {
  *  @code
  *   static void apply(const S& a, const S& b, double ratio, S& out);
  *  @endcode
+ *
+ *  Pieces may additionally provide a batch version that interpolates one segment at many
+ *  ratios. It should be written as a plain loop over @p ratios so the compiler can
+ *  vectorize it. Pieces without it are driven through @c apply once per ratio.
+ *
+ *  @code
+ *   static void apply_batch(const S& a, const S& b, span<const double> ratios, span<S> out);
+ *  @endcode
  */
 template <typename... Pieces>
 struct interpolation_composition {
@@ -25,6 +54,22 @@ struct interpolation_composition {
     (Pieces::apply(a, b, ratio, out), ...);
     return out;
   }
+
+  /** Interpolates between @p a and @p b at each of the given ratios.
+   *  @param a The segment start.
+   *  @param b The segment end.
+   *  @param ratios The interpolation ratios, see the single ratio overload.
+   *  @param out Receives one state per ratio. Must hold at least @c ratios.size() states.
+   */
+  template <typename T>
+  void operator()(const T& a, const T& b, span<const double> ratios, span<T> out) const {
+    assert(out.size() >= ratios.size());
+    // copy target layout, then overwrite touched components
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      out[i] = b;
+    }
+    (detail::apply_piece_batch<Pieces>(a, b, ratios, out), ...);
+  }
 };
 
 } // namespace trailblaze
@@ -0,0 +1,372 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "trailblaze/kinematics/kinematic_model.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_traits.h"
+
+/** @file feasibility.h
+ *  @brief Checks paths against the constraints of a @ref kinematic_model.
+ *
+ *  The curvature at a state is the discrete (Menger) curvature of the circle through the
+ *  state and its two neighbors, which is exact for states sampled from an arc. The curvature
+ *  rate between two states is the difference of their curvatures divided by their distance.
+ *  A turn of more than 90 degrees at a state is a cusp, which is feasible only for models that
+ *  may drive backwards. The curvature rate is not checked across cusps and repeated states,
+ *  where the vehicle stops.
+ *
+ *  The states are processed in blocks: each block is checked by branch free loops over
+ *  arrays of coordinates, and the first violation is searched only in a block that has one.
+ *  Paths stored as separate coordinate arrays are read in place, other paths are copied to
+ *  such arrays block by block.
+ */
+
+namespace trailblaze {
+
+/// The constraint that a path violates.
+enum class feasibility_violation {
+  none,
+  /// Two consecutive states at the same position, for models that cannot turn in place.
+  repeated_state,
+  /// The yaw deviates from the direction of motion.
+  heading,
+  /// The curvature is too large, or a cusp for models that cannot drive backwards.
+  curvature,
+  /// The curvature changes too fast.
+  curvature_rate
+};
+
+/// Result of a feasibility check.
+struct feasibility_report {
+  /// Index of the first state that violates a constraint, or the number of states.
+  std::size_t index;
+  /// The violated constraint, @c none if the path is feasible.
+  feasibility_violation violation;
+  /// The violating curvature [1/m] (infinite for cusps), curvature rate [1/m^2] or heading
+  /// error [rad], else 0.
+  double value;
+
+  /// @returns @c true if no constraint is violated.
+  [[__nodiscard__]] bool feasible() const noexcept {
+    return violation == feasibility_violation::none;
+  }
+};
+
+namespace detail {
+
+/// Number of states that are checked per block.
+constexpr std::size_t feasibility_block_size = 256;
+
+/// Checks consecutive blocks of a path, keeping the curvature at the end of the last block.
+class feasibility_pass {
+public:
+  /** Constructor
+   *  @param model The constraints.
+   *  @param state_count The number of states of the path.
+   */
+  feasibility_pass(const kinematic_model& model, std::size_t state_count) noexcept
+      : max_squared_curvature_(square(model.max_curvature * (1.0 + slack))),
+        max_squared_curvature_rate_(square(model.max_curvature_rate)),
+        min_heading_cos_(model.max_heading_error < numbers::pi
+                             ? std::cos(model.max_heading_error)
+                             : -1.0),
+        squared_heading_cos_(square(min_heading_cos_)),
+        check_heading_(model.max_heading_error < numbers::pi),
+        check_rate_(model.max_curvature_rate < std::numeric_limits<double>::infinity()),
+        reverse_(model.reverse), turn_in_place_(model.turn_in_place),
+        state_count_(state_count) {}
+
+  /** Checks the states with indices [@p begin, @p end), the block after the previous one.
+   *  @param x The x coordinates of the states from <tt>begin - 1</tt> to @p end, or to
+   *         <tt>end - 1</tt> for the last block.
+   *  @param y The y coordinates of the same states.
+   *  @param yaw The yaw angles of the same states, or @c nullptr to skip the heading check.
+   *  @param report Receives the first violation of the block.
+   *  @returns @c true if the block violates a constraint.
+   */
+  bool check(const double* x, const double* y, const double* yaw, std::size_t begin,
+             std::size_t end, feasibility_report& report) noexcept {
+    assert(begin > 0 && begin < end && end <= state_count_ &&
+           end - begin <= feasibility_block_size);
+    const std::size_t count = end - begin;
+    // States with two neighbors.
+    const std::size_t vertex_count = std::min(end, state_count_ - 1) - begin;
+    // Local copies, so that the compiler does not reload them after every store of a flag.
+    const bool repeated_allowed = turn_in_place_;
+    const bool cusp_allowed = reverse_;
+    const double max_squared_curvature = max_squared_curvature_;
+    const double max_squared_curvature_rate = max_squared_curvature_rate_;
+    double* const squared_lengths = squared_lengths_.data();
+    double* const squared_curvatures = squared_curvatures_.data();
+    double* const curvatures = curvatures_.data();
+    double* const flags = flags_.data();
+
+    // The segments that end at the states.
+    for (std::size_t k = 0; k < count; ++k) {
+      const double ax = x[k + 1] - x[k];
+      const double ay = y[k + 1] - y[k];
+      const double la = ax * ax + ay * ay;
+      squared_lengths[k] = la;
+      flags[k] = (la == 0.0) & !repeated_allowed ? repeated_flag : 0.0;
+    }
+    if (yaw != nullptr && check_heading_) {
+      double* const yaw_cos = yaw_cos_.data();
+      double* const yaw_sin = yaw_sin_.data();
+      for (std::size_t k = 0; k <= count; ++k) {
+        yaw_cos[k] = std::cos(yaw[k]);
+        yaw_sin[k] = std::sin(yaw[k]);
+      }
+      const bool positive_cos = min_heading_cos_ >= 0.0;
+      const bool negative_cos = !positive_cos;
+      const double squared_cos = squared_heading_cos_;
+      // along >= cos(max_heading_error) * length, without the square root of the length.
+      const auto along = [&](double length_along, double squared_length) {
+        const bool ahead = length_along >= 0.0;
+        const double squared_along = length_along * length_along;
+        const double squared_limit = squared_cos * squared_length;
+        return (positive_cos & ahead & (squared_along >= squared_limit)) |
+               (negative_cos & (ahead | (squared_along <= squared_limit)));
+      };
+      for (std::size_t k = 0; k < count; ++k) {
+        const double ax = x[k + 1] - x[k];
+        const double ay = y[k + 1] - y[k];
+        const double along_a = ax * yaw_cos[k] + ay * yaw_sin[k];
+        const double along_b = ax * yaw_cos[k + 1] + ay * yaw_sin[k + 1];
+        const double la = squared_lengths[k];
+        const bool forwards = along(along_a, la) & along(along_b, la);
+        const bool backwards = cusp_allowed & along(-along_a, la) & along(-along_b, la);
+        flags[k] += forwards | backwards ? 0.0 : heading_flag;
+      }
+    }
+    // The curvatures at the states, compared squared to avoid the square root.
+    for (std::size_t k = 0; k < vertex_count; ++k) {
+      const double ax = x[k + 1] - x[k];
+      const double ay = y[k + 1] - y[k];
+      const double bx = x[k + 2] - x[k + 1];
+      const double by = y[k + 2] - y[k + 1];
+      const double la = squared_lengths[k];
+      const double lb = bx * bx + by * by;
+      const double dot = ax * bx + ay * by;
+      const double cross = 2.0 * (ax * by - ay * bx);
+      // |a + b|^2 is the squared length of the third side of the triangle.
+      const double product = la * lb * (la + lb + 2.0 * dot);
+      // A negative dot product implies that both segments have a length.
+      const bool cusp = dot < 0.0;
+      const bool stop = cusp | (la == 0.0) | (lb == 0.0);
+      const bool too_curved = !stop & (cross * cross > max_squared_curvature * product);
+      const double squared_curvature = cross * std::abs(cross) / product;
+      // Added rather than selected: a conditional division would not be vectorized.
+      squared_curvatures[k] = squared_curvature + (stop ? not_a_number : 0.0);
+      flags[k] += too_curved | (cusp & !cusp_allowed) ? curvature_flag : 0.0;
+    }
+    if (check_rate_ && vertex_count > 0) {
+      // The only loop with square roots, kept minimal since it is not vectorized.
+      for (std::size_t k = 0; k < vertex_count; ++k) {
+        curvatures[k] = std::copysign(std::sqrt(std::abs(squared_curvatures[k])),
+                                      squared_curvatures[k]);
+      }
+      // Comparisons with the NaN curvature of a stop are false.
+      const auto rate_check = [&](std::size_t k, double previous) {
+        const double change = curvatures[k] - previous;
+        const double limit = max_squared_curvature_rate * squared_lengths[k] +
+                             slack * (curvatures[k] * curvatures[k] + previous * previous);
+        flags[k] += change * change > limit ? rate_flag : 0.0;
+      };
+      rate_check(0, previous_curvature_);
+      for (std::size_t k = 1; k < vertex_count; ++k) {
+        rate_check(k, curvatures[k - 1]);
+      }
+    }
+
+    std::size_t k = 0;
+    while (k < count && flags[k] == 0.0) {
+      ++k;
+    }
+    if (k == count) {
+      if (check_rate_ && vertex_count > 0) {
+        previous_curvature_ = curvatures[vertex_count - 1];
+      }
+      return false;
+    }
+    const auto violations = static_cast<unsigned>(flags[k]);
+    report.index = begin + k;
+    report.value = 0.0;
+    if ((violations & 1U) != 0) {
+      report.violation = feasibility_violation::repeated_state;
+    } else if ((violations & 2U) != 0) {
+      report.violation = feasibility_violation::heading;
+      report.value = heading_error(x[k + 1] - x[k], y[k + 1] - y[k], yaw[k], yaw[k + 1]);
+    } else if ((violations & 4U) != 0) {
+      report.violation = feasibility_violation::curvature;
+      report.value = std::isnan(squared_curvatures[k])
+                         ? std::numeric_limits<double>::infinity()
+                         : std::sqrt(std::abs(squared_curvatures[k]));
+    } else {
+      report.violation = feasibility_violation::curvature_rate;
+      const double previous = k > 0 ? curvatures[k - 1] : previous_curvature_;
+      report.value = std::abs(curvatures[k] - previous) / std::sqrt(squared_lengths[k]);
+    }
+    return true;
+  }
+
+private:
+  /// Relative tolerance of the limits, so that exactly sampled arcs are feasible.
+  static constexpr double slack = 1e-9;
+  /// Bits of the violation flags. The flags are doubles, as wide as the coordinates, so that
+  /// the loops vectorize without narrowing comparison masks, and bits are set by addition.
+  static constexpr double repeated_flag = 1.0;
+  static constexpr double heading_flag = 2.0;
+  static constexpr double curvature_flag = 4.0;
+  static constexpr double rate_flag = 8.0;
+  static constexpr double not_a_number = std::numeric_limits<double>::quiet_NaN();
+
+  [[__nodiscard__]] static double square(double value) noexcept {
+    return value * value;
+  }
+
+  /// @returns the larger angle between the segment (@p dx, @p dy) and the yaw angles.
+  [[__nodiscard__]] double heading_error(double dx, double dy, double yaw_a,
+                                         double yaw_b) const noexcept {
+    const double length = std::hypot(dx, dy);
+    const auto error = [&](double yaw) {
+      const double along = (dx * std::cos(yaw) + dy * std::sin(yaw)) / length;
+      return std::acos(std::clamp(along, -1.0, 1.0));
+    };
+    const double forwards = std::max(error(yaw_a), error(yaw_b));
+    return reverse_ ? std::min(forwards, numbers::pi - std::min(error(yaw_a), error(yaw_b)))
+                    : forwards;
+  }
+
+  double max_squared_curvature_;
+  double max_squared_curvature_rate_;
+  /// Cosine of the largest heading error, -1 if any heading is allowed.
+  double min_heading_cos_;
+  double squared_heading_cos_;
+  bool check_heading_;
+  bool check_rate_;
+  bool reverse_;
+  bool turn_in_place_;
+  std::size_t state_count_;
+  /// Curvature of the last state of the previous block, NaN for a stop.
+  double previous_curvature_{not_a_number};
+  std::array<double, feasibility_block_size> squared_lengths_{};
+  /// Signed squared curvatures, NaN where the vehicle stops.
+  std::array<double, feasibility_block_size> squared_curvatures_{};
+  std::array<double, feasibility_block_size> curvatures_{};
+  std::array<double, feasibility_block_size + 1> yaw_cos_{};
+  std::array<double, feasibility_block_size + 1> yaw_sin_{};
+  /// Sum of the flags of the violations per state.
+  std::array<double, feasibility_block_size> flags_{};
+};
+
+/// Checks a path given as coordinate arrays, @p yaw may be @c nullptr.
+[[__nodiscard__]] inline feasibility_report check_feasibility(const double* x, const double* y,
+                                                              const double* yaw,
+                                                              std::size_t count,
+                                                              const kinematic_model& model) {
+  feasibility_report report{count, feasibility_violation::none, 0.0};
+  feasibility_pass pass(model, count);
+  for (std::size_t begin = 1; begin < count; begin += feasibility_block_size) {
+    const std::size_t end = std::min(begin + feasibility_block_size, count);
+    if (pass.check(x + begin - 1, y + begin - 1, yaw == nullptr ? nullptr : yaw + begin - 1,
+                   begin, end, report)) {
+      return report;
+    }
+  }
+  return report;
+}
+
+} // namespace detail
+
+/** Checks a path against the constraints of a vehicle.
+ *  @tparam TState State type. Must satisfy the predicate @e has_xy_v. The heading is checked
+ *          if it also satisfies @e has_yaw_v.
+ *  @param states The states of the path.
+ *  @param model The constraints.
+ *  @returns the first violation.
+ */
+template <typename TState>
+[[__nodiscard__]] feasibility_report check_feasibility(span<const TState> states,
+                                                       const kinematic_model& model) {
+  static_assert(has_xy_v<TState>, "check_feasibility: TState must have components x & y");
+  constexpr std::size_t block_size = detail::feasibility_block_size;
+  const std::size_t count = states.size();
+  feasibility_report report{count, feasibility_violation::none, 0.0};
+  detail::feasibility_pass pass(model, count);
+  std::array<double, block_size + 2> x;
+  std::array<double, block_size + 2> y;
+  std::array<double, block_size + 2> yaw;
+  for (std::size_t begin = 1; begin < count; begin += block_size) {
+    const std::size_t end = std::min(begin + block_size, count);
+    const std::size_t last = std::min(end + 1, count);
+    for (std::size_t i = begin - 1; i < last; ++i) {
+      x[i + 1 - begin] = states[i].x;
+      y[i + 1 - begin] = states[i].y;
+      if constexpr (has_yaw_v<TState>) {
+        yaw[i + 1 - begin] = states[i].yaw;
+      }
+    }
+    if (pass.check(x.data(), y.data(), has_yaw_v<TState> ? yaw.data() : nullptr, begin, end,
+                   report)) {
+      return report;
+    }
+  }
+  return report;
+}
+
+/// @see check_feasibility(span<const TState>, const kinematic_model&)
+template <typename TState>
+[[__nodiscard__]] feasibility_report check_feasibility(const path<TState>& states,
+                                                       const kinematic_model& model) {
+  return check_feasibility(states.states(), model);
+}
+
+/** Checks a path stored as coordinate arrays, without copying.
+ *  @param x The x coordinates of the states.
+ *  @param y The y coordinates of the states. Must have the same size as @p x.
+ *  @param model The constraints.
+ *  @returns the first violation.
+ */
+[[__nodiscard__]] inline feasibility_report check_feasibility(span<const double> x,
+                                                              span<const double> y,
+                                                              const kinematic_model& model) {
+  assert(y.size() == x.size());
+  return detail::check_feasibility(x.data(), y.data(), nullptr, x.size(), model);
+}
+
+/** Checks a path with yaw stored as coordinate arrays, without copying.
+ *  @see check_feasibility(span<const double>, span<const double>, const kinematic_model&)
+ *  @param yaw The yaw angles of the states. Must have the same size as @p x.
+ */
+[[__nodiscard__]] inline feasibility_report check_feasibility(span<const double> x,
+                                                              span<const double> y,
+                                                              span<const double> yaw,
+                                                              const kinematic_model& model) {
+  assert(y.size() == x.size() && yaw.size() == x.size());
+  return detail::check_feasibility(x.data(), y.data(), yaw.data(), x.size(), model);
+}
+
+/// @returns @c true if the path satisfies all constraints of @p model.
+template <typename TState>
+[[__nodiscard__]] bool is_feasible(span<const TState> states, const kinematic_model& model) {
+  return check_feasibility(states, model).feasible();
+}
+
+/// @see is_feasible(span<const TState>, const kinematic_model&)
+template <typename TState>
+[[__nodiscard__]] bool is_feasible(const path<TState>& states, const kinematic_model& model) {
+  return is_feasible(states.states(), model);
+}
+
+} // namespace trailblaze
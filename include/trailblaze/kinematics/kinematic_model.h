@@ -0,0 +1,70 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "trailblaze/math/numbers.h"
+
+namespace trailblaze {
+
+/** Geometric motion constraints of a vehicle, checked by @ref check_feasibility.
+ *
+ *  Limits that are not set are infinite, i.e. not checked.
+ */
+struct kinematic_model {
+  /// Largest absolute curvature in [1/m], the inverse of the minimum turning radius.
+  double max_curvature{std::numeric_limits<double>::infinity()};
+  /// Largest change of curvature per distance travelled in [1/m^2].
+  double max_curvature_rate{std::numeric_limits<double>::infinity()};
+  /// Largest angle in [rad] between the yaw of a state and the direction of the segments that
+  /// start or end at it. Only checked for states with yaw.
+  double max_heading_error{std::numeric_limits<double>::infinity()};
+  /// Whether the vehicle may drive backwards, which allows cusps.
+  bool reverse{true};
+  /// Whether the vehicle may rotate on the spot, which allows repeated positions.
+  bool turn_in_place{false};
+};
+
+/** Creates the model of a differential drive, which may turn on the spot and drive in both
+ *  directions, but not sideways.
+ *  @param max_heading_error Tolerance of the heading. The chord of a sampled arc deviates
+ *         from the tangent by half of the turning angle between the samples.
+ */
+[[__nodiscard__]] inline kinematic_model differential_drive_model(double max_heading_error = 0.1) {
+  return {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+          max_heading_error, true, true};
+}
+
+/** Creates the model of a car-like vehicle with Ackermann steering.
+ *  @param wheelbase Distance between the front and the rear axle in [m].
+ *  @param max_steering_angle Largest steering angle in [rad].
+ *  @param max_steering_rate Largest change of the steering angle per distance travelled in
+ *         [rad/m]. It is converted to a curvature rate at straight steering, which is the
+ *         smallest one, so the limit is conservative for large steering angles.
+ *  @param reverse Whether the vehicle may drive backwards.
+ *  @param max_heading_error Tolerance of the heading, see @ref differential_drive_model.
+ *  @throws std::invalid_argument if @p wheelbase is not positive, @p max_steering_angle is
+ *          not in (0, pi/2) or @p max_steering_rate is negative.
+ */
+[[__nodiscard__]] inline kinematic_model ackermann_model(
+    double wheelbase, double max_steering_angle,
+    double max_steering_rate = std::numeric_limits<double>::infinity(), bool reverse = true,
+    double max_heading_error = 0.1) {
+  if (!(wheelbase > 0.0)) {
+    throw std::invalid_argument("ackermann_model: wheelbase must be positive!");
+  }
+  if (!(max_steering_angle > 0.0 && max_steering_angle < numbers::pi_2)) {
+    throw std::invalid_argument("ackermann_model: steering angle must be in (0, pi/2)!");
+  }
+  if (!(max_steering_rate >= 0.0)) {
+    throw std::invalid_argument("ackermann_model: steering rate must not be negative!");
+  }
+  return {std::tan(max_steering_angle) / wheelbase, max_steering_rate / wheelbase,
+          max_heading_error, reverse, false};
+}
+
+} // namespace trailblaze
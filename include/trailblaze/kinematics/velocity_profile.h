@@ -0,0 +1,296 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_traits.h"
+
+/** @file velocity_profile.h
+ *  @brief Time optimal speeds along a geometric path.
+ *
+ *  The speed at each state is bounded by the maximum speed and by the lateral acceleration in
+ *  the curve through the state and its neighbors. Between two states the vehicle accelerates
+ *  or decelerates uniformly, so the squared speed changes by at most 2 * a * distance. A
+ *  forward pass applies the acceleration limit from the start, a backward pass the
+ *  deceleration limit from the goal, and the speed is the smaller of both. This is the time
+ *  optimal profile for these constraints and takes linear time. The timestamps use the
+ *  fastest motion between the speeds at both ends of each segment: accelerate, cruise at
+ *  most at the maximum speed, brake.
+ *
+ *  All passes work on squared speeds, so only segment lengths, curvatures and the final
+ *  speeds need square roots.
+ */
+
+namespace trailblaze {
+
+/// Limits of the speed along a path, all magnitudes.
+struct velocity_limits {
+  /// Largest speed in [m/s].
+  double max_speed{1.0};
+  /// Largest acceleration along the path in [m/s^2].
+  double max_acceleration{1.0};
+  /// Largest deceleration along the path in [m/s^2].
+  double max_deceleration{1.0};
+  /// Largest lateral acceleration in [m/s^2], infinite to ignore the curvature.
+  double max_lateral_acceleration{std::numeric_limits<double>::infinity()};
+  /// Speed at the first state in [m/s].
+  double start_speed{0.0};
+  /// Speed at the last state in [m/s].
+  double end_speed{0.0};
+};
+
+/** Time optimal speed profile along a path, stored as a speed and a timestamp column.
+ *
+ *  The profile keeps the intermediate columns of its passes, so that after a replan that only
+ *  changes the tail of the path @ref update recomputes the suffix instead of the whole path.
+ *  The columns are reused, so recomputing a path of the same or a smaller size does not
+ *  allocate.
+ *
+ *  A cusp (a turn of more than 90 degrees) forces a stop. Repeated states have the same
+ *  timestamp.
+ */
+class velocity_profile {
+public:
+  /** Constructor
+   *  @param limits The speed limits.
+   *  @throws std::invalid_argument if a limit is not positive, the maximum speed or an
+   *          acceleration is infinite, or the start or end speed is negative.
+   */
+  explicit velocity_profile(const velocity_limits& limits)
+      : limits_(limits),
+        max_squared_speed_(limits.max_speed * limits.max_speed),
+        double_acceleration_(2.0 * limits.max_acceleration),
+        double_deceleration_(2.0 * limits.max_deceleration) {
+    const auto finite_positive = [](double value) {
+      return value > 0.0 && value < std::numeric_limits<double>::infinity();
+    };
+    if (!finite_positive(limits.max_speed) || !finite_positive(limits.max_acceleration) ||
+        !finite_positive(limits.max_deceleration)) {
+      throw std::invalid_argument(
+          "velocity_profile: speed and acceleration limits must be positive and finite!");
+    }
+    if (!(limits.max_lateral_acceleration > 0.0)) {
+      throw std::invalid_argument(
+          "velocity_profile: lateral acceleration limit must be positive!");
+    }
+    if (!(limits.start_speed >= 0.0 && limits.end_speed >= 0.0)) {
+      throw std::invalid_argument("velocity_profile: start and end speed must not be negative!");
+    }
+  }
+
+  [[__nodiscard__]] const velocity_limits& limits() const noexcept {
+    return limits_;
+  }
+
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return speeds_.size();
+  }
+
+  /// @returns the speed column in [m/s], one entry per state.
+  [[__nodiscard__]] span<const double> speeds() const noexcept {
+    return {speeds_.data(), speeds_.size()};
+  }
+
+  /// @returns the timestamp column in [s], starting at 0.
+  [[__nodiscard__]] span<const double> times() const noexcept {
+    return {times_.data(), times_.size()};
+  }
+
+  /// @returns the time to traverse the path in [s].
+  [[__nodiscard__]] double duration() const noexcept {
+    return times_.empty() ? 0.0 : times_.back();
+  }
+
+  /** Computes the profile of a path.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states of the path.
+   */
+  template <typename TState>
+  void compute(span<const TState> states) {
+    resize(states.size());
+    if (!states.empty()) {
+      recompute(states, 0);
+    }
+  }
+
+  /// @see compute(span<const TState>)
+  template <typename TState>
+  void compute(const path<TState>& states) {
+    compute(states.states());
+  }
+
+  /** Updates the profile after the states from @p first_changed on have changed.
+   *
+   *  The limits and the forward pass are recomputed from the changed states on. The backward
+   *  pass is recomputed for the changed states and continues towards the start only while its
+   *  result differs from the previous one, which usually ends within the braking distance.
+   *  Speeds and timestamps are then recomputed from the first changed speed on.
+   *
+   *  @param states The states of the path, the first @p first_changed of which are the same
+   *         as in the previous call to @ref compute or @ref update. The size may differ.
+   *  @param first_changed Index of the first changed state.
+   *  @returns the index of the first state whose speed or timestamp may have changed.
+   *  @throws std::out_of_range if @p first_changed exceeds the sizes of the old or new path.
+   */
+  template <typename TState>
+  std::size_t update(span<const TState> states, std::size_t first_changed) {
+    if (first_changed > states.size() || first_changed > size()) {
+      throw std::out_of_range("velocity_profile::update: first changed state " +
+                              std::to_string(first_changed) + " is out of range!");
+    }
+    resize(states.size());
+    if (states.empty()) {
+      return 0;
+    }
+    return recompute(states, first_changed);
+  }
+
+  /// @see update(span<const TState>, std::size_t)
+  template <typename TState>
+  std::size_t update(const path<TState>& states, std::size_t first_changed) {
+    return update(states.states(), first_changed);
+  }
+
+private:
+  void resize(std::size_t count) {
+    lengths_.resize(count);
+    forwards_.resize(count);
+    squared_speeds_.resize(count);
+    speeds_.resize(count);
+    times_.resize(count);
+  }
+
+  template <typename TState>
+  std::size_t recompute(span<const TState> states, std::size_t first_changed) {
+    static_assert(has_xy_v<TState>, "velocity_profile: TState must have components x & y");
+    const std::size_t count = states.size();
+    // The state before a changed one has a changed neighbor, so its limit changes as well.
+    const std::size_t first = first_changed > 0 ? first_changed - 1 : 0;
+    double* const lengths = lengths_.data();
+    double* const forwards = forwards_.data();
+    double* const squared_speeds = squared_speeds_.data();
+
+    // One pass computes the segment lengths and the forward pass, which limits the squared
+    // speed by v^2 <= a_lat / curvature, with the Menger curvature 2 |a x b| / (|a| |b| |a + b|)
+    // of the segments a and b that end and start at a state. The values of the previous state
+    // are carried in registers, since the stores may alias the states.
+    const double lateral = limits_.max_lateral_acceleration;
+    const double max_squared_speed = max_squared_speed_;
+    const double acceleration = double_acceleration_;
+    const double deceleration = double_deceleration_;
+    if (first == 0) {
+      forwards[0] = std::min(limits_.start_speed * limits_.start_speed, max_squared_speed);
+    }
+    if (count > 1) {
+      // The limit of the state before the first changed one changes with its neighbor.
+      std::size_t i = std::max<std::size_t>(first, 1);
+      double ax = states[i].x - states[i - 1].x;
+      double ay = states[i].y - states[i - 1].y;
+      double length = first == 0 ? std::sqrt(ax * ax + ay * ay) : lengths[i - 1];
+      double forward = forwards[i - 1];
+      lengths[i - 1] = length;
+      for (; i + 1 < count; ++i) {
+        const double bx = states[i + 1].x - states[i].x;
+        const double by = states[i + 1].y - states[i].y;
+        const double next_length = std::sqrt(bx * bx + by * by);
+        const double third = std::sqrt((ax + bx) * (ax + bx) + (ay + by) * (ay + by));
+        const double cross = std::abs(ax * by - ay * bx);
+        const double limit = lateral * length * next_length * third / (2.0 * cross);
+        // A cusp needs a stop. Straight lines divide by zero to infinity, repeated states to
+        // NaN, which std::min ignores as its second argument.
+        const bool cusp = ax * bx + ay * by < 0.0;
+        const double squared_speed = cusp ? 0.0 : std::min(max_squared_speed, limit);
+        forward = std::min(squared_speed, forward + acceleration * length);
+        forwards[i] = forward;
+        lengths[i] = next_length;
+        length = next_length;
+        ax = bx;
+        ay = by;
+      }
+      forwards[count - 1] = std::min(max_squared_speed, forward + acceleration * length);
+    }
+    lengths[count - 1] = 0.0;
+
+    // Backward pass from the goal. Since the forward pass is below the limits, bounding it by
+    // the braking distance gives the squared speeds. It continues into the unchanged states
+    // until it meets the previous result, from where on the result is the same as before.
+    // The square roots and segment durations are computed alongside, off the dependency chain
+    // of the pass, and the durations are summed up to timestamps afterwards.
+    const double inverse_sum = 1.0 / acceleration + 1.0 / deceleration;
+    // A segment takes the time of the fastest motion between the speeds at its ends: accelerate
+    // to the peak speed, cruise, brake. Without cruising, the peak satisfies
+    // (peak^2 - v0^2) / 2a + (peak^2 - v1^2) / 2d = length, and it is bounded by the maximum
+    // speed. acceleration and deceleration hold 2a and 2d.
+    const auto segment_time = [&](double length, double v0, double squared_v0, double v1,
+                                  double squared_v1) {
+      if (!(length > 0.0)) {
+        return 0.0;
+      }
+      double squared_peak = (length + squared_v0 / acceleration + squared_v1 / deceleration) /
+                            inverse_sum;
+      // The end speeds are reachable from each other, the bounds only catch rounding.
+      squared_peak = std::max({std::min(squared_peak, max_squared_speed), squared_v0, squared_v1});
+      const double peak = std::sqrt(squared_peak);
+      const double cruise = length - (squared_peak - squared_v0) / acceleration -
+                            (squared_peak - squared_v1) / deceleration;
+      return 2.0 * (peak - v0) / acceleration + 2.0 * (peak - v1) / deceleration +
+             std::max(cruise, 0.0) / peak;
+    };
+    double* const speeds = speeds_.data();
+    double* const times = times_.data();
+    double squared_speed = std::min(limits_.end_speed * limits_.end_speed, forwards[count - 1]);
+    double speed = std::sqrt(squared_speed);
+    squared_speeds[count - 1] = squared_speed;
+    speeds[count - 1] = speed;
+    std::size_t changed = count - 1;
+    while (changed > 0) {
+      const std::size_t i = changed - 1;
+      const double next_speed = speed;
+      const double next_squared_speed = squared_speed;
+      squared_speed = std::min(forwards[i], squared_speed + deceleration * lengths[i]);
+      const bool unchanged = i < first && squared_speed == squared_speeds[i];
+      speed = unchanged ? speeds[i] : std::sqrt(squared_speed);
+      times[i + 1] =
+          segment_time(lengths[i], speed, squared_speed, next_speed, next_squared_speed);
+      if (unchanged) {
+        break;
+      }
+      squared_speeds[i] = squared_speed;
+      speeds[i] = speed;
+      changed = i;
+    }
+    if (changed == 0) {
+      times[0] = 0.0;
+    }
+    for (std::size_t i = std::max<std::size_t>(changed, 1); i < count; ++i) {
+      times[i] += times[i - 1];
+    }
+    return changed;
+  }
+
+  velocity_limits limits_;
+  double max_squared_speed_;
+  double double_acceleration_;
+  double double_deceleration_;
+  /// Segment lengths, from each state to the next one.
+  std::vector<double> lengths_;
+  /// Squared speeds of the forward pass.
+  std::vector<double> forwards_;
+  /// Squared speeds of the backward pass, the result.
+  std::vector<double> squared_speeds_;
+  std::vector<double> speeds_;
+  std::vector<double> times_;
+};
+
+} // namespace trailblaze
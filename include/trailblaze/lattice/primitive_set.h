@@ -0,0 +1,460 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "trailblaze/component_access.h"
+#include "trailblaze/generate/dubins.h"
+#include "trailblaze/generate/turning_curve.h"
+#include "trailblaze/math/angle.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/state_traits.h"
+
+/** @file primitive_set.h
+ *  @brief Precomputed motion primitives of a state lattice.
+ *
+ *  Lattice states are grid cells (i, j) at position (i * cell_size, j * cell_size) combined
+ *  with one of @c heading_count evenly spaced heading bins; bin h has the yaw
+ *  <tt>h * 2 Pi / heading_count</tt>. A motion primitive connects a lattice state at cell
+ *  (0, 0) with another lattice state. Primitives are stored relative to their start cell and
+ *  are translated to any other start cell on lookup.
+ */
+
+namespace trailblaze::lattice {
+
+/// Parameters of a @ref primitive_set.
+struct primitive_set_config {
+  /// Number of heading bins, e.g. 16 or 72.
+  std::size_t heading_count{16};
+  /// Edge length of a lattice cell.
+  double cell_size{1.0};
+  /// Minimum turning radius of the vehicle.
+  double turning_radius{1.0};
+  /** Nominal primitive lengths. For every start heading and length, a left turn, a straight
+   *  motion and a right turn of that length are generated. Their end states are snapped to
+   *  the lattice and connected with the shortest Dubins curve.
+   */
+  std::vector<double> lengths{1.0, 2.0};
+  /// Primitives whose Dubins curve is longer than this factor times the nominal length are
+  /// dropped, they contain loops caused by snapping.
+  double max_length_ratio{1.5};
+  /// Arc length between the stored samples of a primitive.
+  double sample_step{0.1};
+};
+
+/// Read-only view of one primitive, positions are relative to the start cell.
+struct primitive_view {
+  /// Heading bin of the first sample.
+  std::size_t start_heading;
+  /// Heading bin of the last sample.
+  std::size_t end_heading;
+  /// End cell offset in x direction.
+  std::int32_t end_dx;
+  /// End cell offset in y direction.
+  std::int32_t end_dy;
+  /// Arc length of the primitive.
+  double length;
+  /// Sample x coordinates.
+  span<const double> x;
+  /// Sample y coordinates.
+  span<const double> y;
+  /// Sample yaw angles.
+  span<const double> yaw;
+
+  /// @returns the number of samples.
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return x.size();
+  }
+};
+
+/** A table of motion primitives for every start heading of a state lattice.
+ *
+ *  All samples of all primitives live in one arena with one array per component (x, y and
+ *  yaw), and per-primitive data is stored in parallel arrays as well. Offset tables give the
+ *  primitives of a heading and the samples of a primitive in O(1).
+ */
+class primitive_set {
+public:
+  /// Binary file format identification, see @ref save.
+  static constexpr std::array<char, 4> file_magic{'T', 'B', 'P', 'S'};
+  /// Binary file format version, see @ref save.
+  static constexpr std::uint32_t file_version = 1;
+
+  /// Creates an empty set, e.g. to @ref load into.
+  primitive_set() = default;
+
+  /** Generates the primitives of all start headings.
+   *  @param config The lattice and primitive parameters.
+   *  @throws std::invalid_argument if the heading count is zero or a length, the cell size,
+   *          the turning radius or the sample step is not positive.
+   */
+  explicit primitive_set(const primitive_set_config& config)
+      : heading_count_(config.heading_count), cell_size_(config.cell_size),
+        turning_radius_(config.turning_radius) {
+    if (config.heading_count == 0) {
+      throw std::invalid_argument("primitive_set: heading_count must be > 0");
+    }
+    if (!(config.cell_size > 0.0) || !(config.turning_radius > 0.0) ||
+        !(config.sample_step > 0.0)) {
+      throw std::invalid_argument(
+          "primitive_set: cell_size, turning_radius and sample_step must be > 0");
+    }
+    if (std::any_of(config.lengths.begin(), config.lengths.end(),
+                    [](double length) { return !(length > 0.0); })) {
+      throw std::invalid_argument("primitive_set: primitive lengths must be > 0");
+    }
+
+    heading_offsets_.reserve(heading_count_ + 1);
+    heading_offsets_.push_back(0);
+    sample_offsets_.push_back(0);
+    for (std::size_t heading = 0; heading < heading_count_; ++heading) {
+      generate_heading(config, heading);
+      heading_offsets_.push_back(length_.size());
+    }
+  }
+
+  /// @returns the number of heading bins.
+  [[__nodiscard__]] std::size_t heading_count() const noexcept {
+    return heading_count_;
+  }
+
+  /// @returns the edge length of a lattice cell.
+  [[__nodiscard__]] double cell_size() const noexcept {
+    return cell_size_;
+  }
+
+  /// @returns the turning radius used to generate the primitives.
+  [[__nodiscard__]] double turning_radius() const noexcept {
+    return turning_radius_;
+  }
+
+  /// @returns the yaw of a heading bin, in [-Pi, Pi).
+  [[__nodiscard__]] double heading_yaw(std::size_t heading) const {
+    return normalized(static_cast<double>(heading) * numbers::two_pi /
+                      static_cast<double>(heading_count_));
+  }
+
+  /// @returns the number of primitives of all headings.
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return length_.size();
+  }
+
+  /// @returns the number of samples of all primitives.
+  [[__nodiscard__]] std::size_t sample_count() const noexcept {
+    return x_.size();
+  }
+
+  /** @returns the index of the first primitive that starts with @p heading. The primitives
+   *           of a heading are the indices [first_primitive(h), first_primitive(h + 1)).
+   */
+  [[__nodiscard__]] std::size_t first_primitive(std::size_t heading) const {
+    assert(heading <= heading_count_);
+    return static_cast<std::size_t>(heading_offsets_[heading]);
+  }
+
+  /// @returns the number of primitives that start with @p heading.
+  [[__nodiscard__]] std::size_t primitive_count(std::size_t heading) const {
+    assert(heading < heading_count_);
+    return static_cast<std::size_t>(heading_offsets_[heading + 1] - heading_offsets_[heading]);
+  }
+
+  /// @returns the primitive with the given global index.
+  [[__nodiscard__]] primitive_view primitive(std::size_t index) const {
+    assert(index < size());
+    const auto first = static_cast<std::size_t>(sample_offsets_[index]);
+    const auto count = static_cast<std::size_t>(sample_offsets_[index + 1]) - first;
+    return {start_heading_[index],
+            end_heading_[index],
+            end_dx_[index],
+            end_dy_[index],
+            length_[index],
+            span<const double>(x_.data() + first, count),
+            span<const double>(y_.data() + first, count),
+            span<const double>(yaw_.data() + first, count)};
+  }
+
+  /// @returns the @p i-th primitive that starts with @p heading.
+  [[__nodiscard__]] primitive_view primitive(std::size_t heading, std::size_t i) const {
+    assert(i < primitive_count(heading));
+    return primitive(first_primitive(heading) + i);
+  }
+
+  /** Writes the samples of a primitive placed at a start cell.
+   *  @tparam TState Output state with x, y and yaw components.
+   *  @param index Global primitive index.
+   *  @param cell_x Start cell index in x direction.
+   *  @param cell_y Start cell index in y direction.
+   *  @param out Receives the samples, must hold at least @c primitive(index).size() states.
+   */
+  template <typename TState>
+  void translate(std::size_t index, std::int64_t cell_x, std::int64_t cell_y,
+                 span<TState> out) const {
+    static_assert(has_xy_v<TState> && has_yaw_v<TState>,
+                  "translate: TState must have components x, y & yaw");
+    const primitive_view view = primitive(index);
+    assert(out.size() >= view.size());
+    const double offset_x = static_cast<double>(cell_x) * cell_size_;
+    const double offset_y = static_cast<double>(cell_y) * cell_size_;
+    for (std::size_t i = 0; i < view.size(); ++i) {
+      comp::x(out[i]) = view.x[i] + offset_x;
+      comp::y(out[i]) = view.y[i] + offset_y;
+      comp::yaw(out[i]) = view.yaw[i];
+    }
+  }
+
+  /** Writes the table in a binary format.
+   *
+   *  Layout: magic "TBPS", version (uint32), heading count, primitive count and sample count
+   *  (uint64), cell size and turning radius (double), followed by the raw arrays. Values are
+   *  stored in native byte order.
+   *
+   *  @param stream The output stream, opened in binary mode.
+   *  @throws std::runtime_error if writing fails.
+   */
+  void save(std::ostream& stream) const {
+    stream.write(file_magic.data(), file_magic.size());
+    write_value(stream, file_version);
+    write_value(stream, static_cast<std::uint64_t>(heading_count_));
+    write_value(stream, static_cast<std::uint64_t>(size()));
+    write_value(stream, static_cast<std::uint64_t>(sample_count()));
+    write_value(stream, cell_size_);
+    write_value(stream, turning_radius_);
+    write_array(stream, heading_offsets_);
+    write_array(stream, sample_offsets_);
+    write_array(stream, start_heading_);
+    write_array(stream, end_heading_);
+    write_array(stream, end_dx_);
+    write_array(stream, end_dy_);
+    write_array(stream, length_);
+    write_array(stream, x_);
+    write_array(stream, y_);
+    write_array(stream, yaw_);
+    if (!stream) {
+      throw std::runtime_error("primitive_set: writing the table failed");
+    }
+  }
+
+  /** Writes the table to a file, see @ref save(std::ostream&) const.
+   *  @param filename The file path.
+   *  @throws std::runtime_error if the file cannot be written.
+   */
+  void save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("primitive_set: cannot open '" + filename + "' for writing");
+    }
+    save(file);
+  }
+
+  /** Reads a table written by @ref save.
+   *  @param stream The input stream, opened in binary mode.
+   *  @returns the table.
+   *  @throws std::runtime_error if the data is truncated, has the wrong magic or version, or
+   *          is inconsistent.
+   */
+  static primitive_set load(std::istream& stream) {
+    std::array<char, 4> magic{};
+    stream.read(magic.data(), magic.size());
+    if (!stream || magic != file_magic) {
+      throw std::runtime_error("primitive_set: not a primitive table");
+    }
+    if (read_value<std::uint32_t>(stream) != file_version) {
+      throw std::runtime_error("primitive_set: unsupported file version");
+    }
+    primitive_set out;
+    out.heading_count_ = read_count(stream);
+    const std::size_t primitive_count = read_count(stream);
+    const std::size_t sample_count = read_count(stream);
+    out.cell_size_ = read_value<double>(stream);
+    out.turning_radius_ = read_value<double>(stream);
+    read_array(stream, out.heading_offsets_, out.heading_count_ + 1);
+    read_array(stream, out.sample_offsets_, primitive_count + 1);
+    read_array(stream, out.start_heading_, primitive_count);
+    read_array(stream, out.end_heading_, primitive_count);
+    read_array(stream, out.end_dx_, primitive_count);
+    read_array(stream, out.end_dy_, primitive_count);
+    read_array(stream, out.length_, primitive_count);
+    read_array(stream, out.x_, sample_count);
+    read_array(stream, out.y_, sample_count);
+    read_array(stream, out.yaw_, sample_count);
+
+    const bool consistent =
+        out.heading_offsets_.front() == 0 && out.heading_offsets_.back() == primitive_count &&
+        std::is_sorted(out.heading_offsets_.begin(), out.heading_offsets_.end()) &&
+        out.sample_offsets_.front() == 0 && out.sample_offsets_.back() == sample_count &&
+        std::is_sorted(out.sample_offsets_.begin(), out.sample_offsets_.end()) &&
+        std::all_of(out.start_heading_.begin(), out.start_heading_.end(),
+                    [&out](std::uint32_t h) { return h < out.heading_count_; }) &&
+        std::all_of(out.end_heading_.begin(), out.end_heading_.end(),
+                    [&out](std::uint32_t h) { return h < out.heading_count_; });
+    if (!consistent) {
+      throw std::runtime_error("primitive_set: inconsistent tables");
+    }
+    // Each primitive lies in the range of its start heading.
+    for (std::size_t heading = 0; heading < out.heading_count_; ++heading) {
+      for (auto i = static_cast<std::size_t>(out.heading_offsets_[heading]);
+           i < out.heading_offsets_[heading + 1]; ++i) {
+        if (out.start_heading_[i] != heading) {
+          throw std::runtime_error("primitive_set: inconsistent tables");
+        }
+      }
+    }
+    return out;
+  }
+
+  /** Reads a table from a file, see @ref load(std::istream&).
+   *  @param filename The file path.
+   *  @returns the table.
+   *  @throws std::runtime_error if the file cannot be read or is invalid.
+   */
+  static primitive_set load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("primitive_set: cannot open '" + filename + "' for reading");
+    }
+    return load(file);
+  }
+
+private:
+  void generate_heading(const primitive_set_config& config, std::size_t heading) {
+    const double heading_step = numbers::two_pi / static_cast<double>(heading_count_);
+    const state_se2 start{0.0, 0.0, heading_yaw(heading)};
+    std::set<std::tuple<std::int32_t, std::int32_t, std::size_t>> seen;
+
+    for (const double length : config.lengths) {
+      for (const gen::steering steering :
+           {gen::steering::left, gen::steering::straight, gen::steering::right}) {
+        // Drive the nominal motion, then snap its end state to the lattice.
+        gen::turning_curve nominal;
+        nominal.radius = config.turning_radius;
+        nominal.segments[0] = {steering, length / config.turning_radius};
+        nominal.segment_count = 1;
+        const state_se2 end = nominal.state_at(start, length);
+
+        const auto dx = static_cast<std::int32_t>(std::lround(end.x / cell_size_));
+        const auto dy = static_cast<std::int32_t>(std::lround(end.y / cell_size_));
+        const auto bins = static_cast<std::int64_t>(std::lround(end.yaw / heading_step));
+        const auto count = static_cast<std::int64_t>(heading_count_);
+        const auto end_heading = static_cast<std::size_t>(((bins % count) + count) % count);
+        if ((dx == 0 && dy == 0) || !seen.insert({dx, dy, end_heading}).second) {
+          continue;
+        }
+
+        const state_se2 goal{dx * cell_size_, dy * cell_size_, heading_yaw(end_heading)};
+        const gen::turning_curve curve = gen::dubins_curve(start, goal, config.turning_radius);
+        const double curve_length = curve.length();
+        if (curve_length > config.max_length_ratio * length) {
+          continue;
+        }
+        const path<state_se2> samples =
+            gen::sample(curve, start, sampling::by_step{config.sample_step});
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+          // The last sample is set to the exact lattice state.
+          const state_se2& sample = (i + 1 == samples.size()) ? goal : samples[i];
+          x_.push_back(sample.x);
+          y_.push_back(sample.y);
+          yaw_.push_back(sample.yaw);
+        }
+        sample_offsets_.push_back(x_.size());
+        start_heading_.push_back(static_cast<std::uint32_t>(heading));
+        end_heading_.push_back(static_cast<std::uint32_t>(end_heading));
+        end_dx_.push_back(dx);
+        end_dy_.push_back(dy);
+        length_.push_back(curve_length);
+      }
+    }
+  }
+
+  template <typename T>
+  static void write_value(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T)); // NOLINT
+  }
+
+  template <typename T>
+  static void write_array(std::ostream& stream, const std::vector<T>& values) {
+    stream.write(reinterpret_cast<const char*>(values.data()), // NOLINT
+                 static_cast<std::streamsize>(values.size() * sizeof(T)));
+  }
+
+  template <typename T>
+  static T read_value(std::istream& stream) {
+    T value{};
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T)); // NOLINT
+    if (!stream) {
+      throw std::runtime_error("primitive_set: unexpected end of data");
+    }
+    return value;
+  }
+
+  /// Reads an array size, which is small enough that adding 1 and multiplying by the element
+  /// size does not overflow.
+  static std::size_t read_count(std::istream& stream) {
+    constexpr std::uint64_t max_count = std::uint64_t(1) << 40;
+    const auto count = read_value<std::uint64_t>(stream);
+    if (count > max_count) {
+      throw std::runtime_error("primitive_set: invalid table size");
+    }
+    return static_cast<std::size_t>(count);
+  }
+
+  template <typename T>
+  static void read_array(std::istream& stream, std::vector<T>& values, std::size_t count) {
+    // Grows the array in chunks as the data arrives, so that a corrupted size runs into the end
+    // of the data instead of allocating memory for it.
+    constexpr std::size_t chunk_size = std::size_t(1) << 16;
+    values.clear();
+    while (values.size() < count) {
+      const std::size_t begin = values.size();
+      values.resize(begin + std::min(count - begin, chunk_size));
+      stream.read(reinterpret_cast<char*>(values.data() + begin), // NOLINT
+                  static_cast<std::streamsize>((values.size() - begin) * sizeof(T)));
+      if (!stream) {
+        throw std::runtime_error("primitive_set: unexpected end of data");
+      }
+    }
+  }
+
+  std::size_t heading_count_{0};
+  double cell_size_{1.0};
+  double turning_radius_{1.0};
+
+  // Fixed width types, the arrays are written to files as they are.
+
+  /// First primitive of each heading, plus the total primitive count.
+  std::vector<std::uint64_t> heading_offsets_;
+  /// First sample of each primitive, plus the total sample count.
+  std::vector<std::uint64_t> sample_offsets_;
+
+  // per primitive
+  std::vector<std::uint32_t> start_heading_;
+  std::vector<std::uint32_t> end_heading_;
+  std::vector<std::int32_t> end_dx_;
+  std::vector<std::int32_t> end_dy_;
+  std::vector<double> length_;
+
+  // sample arena
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> yaw_;
+};
+
+} // namespace trailblaze::lattice
@@ -4,10 +4,15 @@
  * ------------------------------------------------------------------------- */
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "trailblaze/math/numbers.h"
+#include "trailblaze/span.h"
 
 namespace trailblaze {
 
@@ -36,6 +41,149 @@ inline T normalized(const T angle) {
   return x - static_cast<T>(numbers::pi);
 }
 
+/** Normalizes an angle that lies within [-3 Pi, 3 Pi) to the range [-Pi, Pi).
+ *
+ *  This is a cheaper variant of @ref normalized for angles that are known to be at most one
+ *  turn away from the target range, e.g. the sum of a normalized angle and a shortest
+ *  angular difference. It avoids @c std::fmod and its branches compile to selects, so loops
+ *  using it can be vectorized.
+ *
+ *  @tparam T Any floating point type
+ *  @param angle Angle value in [rad], within [-3 Pi, 3 Pi).
+ *  @returns the normalized angle
+ */
+template <typename T>
+inline T normalized_near(const T angle) {
+  static_assert(std::is_floating_point_v<T>, "normalized_near requires floating-point T");
+  constexpr T pi = static_cast<T>(numbers::pi);
+  constexpr T two_pi = static_cast<T>(2.0) * pi;
+
+  T x = angle;
+  x += (x < -pi) ? two_pi : static_cast<T>(0);
+  x -= (x >= pi) ? two_pi : static_cast<T>(0);
+  return x;
+}
+
+/** Polynomial approximation of @c std::atan2.
+ *
+ *  atan on [0, 1] is evaluated with the degree-15 odd polynomial from Abramowitz and Stegun,
+ *  formula 4.4.49, and mapped to the other octants. The maximum absolute error is 3.8e-8 rad,
+ *  documented as 1e-7 rad to leave room for rounding.
+ *
+ *  The octant corrections are written as multiplications with 0/1 masks instead of branches
+ *  or conditional arithmetic, so loops calling this function are vectorized by the compiler
+ *  even without @c -fno-trapping-math.
+ *
+ *  @param y The y coordinate.
+ *  @param x The x coordinate.
+ *  @returns the angle of (x, y) in [-Pi, Pi), 0 for the origin. Unlike @c std::atan2, the
+ *           negative x axis maps to -Pi regardless of the sign of a zero @p y.
+ */
+inline double fast_atan2(double y, double x) {
+  const double ax = std::fabs(x);
+  const double ay = std::fabs(y);
+  const double hi = std::max(ax, ay);
+  const double lo = std::min(ax, ay);
+  const double a = lo / (hi + static_cast<double>(hi == 0.0));
+  const double s = a * a;
+  double r = -0.0040540580;
+  r = r * s + 0.0218612288;
+  r = r * s - 0.0559098861;
+  r = r * s + 0.0964200441;
+  r = r * s - 0.1390853351;
+  r = r * s + 0.1994653599;
+  r = r * s - 0.3332985605;
+  r = r * s + 0.9999993329;
+  r *= a;
+  r += static_cast<double>(ay > ax) * (numbers::pi_2 - 2.0 * r);
+  r += static_cast<double>(x < 0.0) * (numbers::pi - 2.0 * r);
+  const bool negative = (y < 0.0) | ((y == 0.0) & (x < 0.0));
+  return negative ? -r : r;
+}
+
+/// Largest angle magnitude for which @ref fast_sincos keeps its documented accuracy.
+inline constexpr double fast_sincos_range = 1e5;
+
+/** Polynomial approximation of sine and cosine.
+ *
+ *  The angle is reduced to [-Pi/4, Pi/4] with a three part Cody-Waite reduction and
+ *  evaluated with the fdlibm kernel polynomials. For |angle| <= @ref fast_sincos_range the
+ *  absolute error is below 4e-16 (2.3e-16 measured). As in @ref fast_atan2 the quadrant is
+ *  applied with 0/1 mask arithmetic so that loops calling this function vectorize.
+ *  Larger, infinite or NaN angles give unspecified results, but no undefined behavior.
+ *
+ *  @param angle Angle in [rad], |angle| <= @ref fast_sincos_range.
+ *  @param sine Receives the sine of @p angle.
+ *  @param cosine Receives the cosine of @p angle.
+ */
+inline void fast_sincos(double angle, double& sine, double& cosine) {
+  constexpr double two_over_pi = 6.36619772367581382433e-01;
+  // Pi/2 split into parts whose products with the quadrant index are exact.
+  constexpr double pi_2_part1 = 1.57079632673412561417e+00;
+  constexpr double pi_2_part2 = 6.07710050630396597660e-11;
+  constexpr double pi_2_part3 = 2.02226624871116645580e-21;
+  // Adding and subtracting 1.5 * 2^52 rounds to the nearest integer.
+  constexpr double round_magic = 6755399441055744.0;
+
+  const double shifted = angle * two_over_pi + round_magic;
+  const double k = shifted - round_magic;
+  const double r = ((angle - k * pi_2_part1) - k * pi_2_part2) - k * pi_2_part3;
+  const double z = r * r;
+
+  const double sin_poly =
+      -1.66666666666666324348e-01 +
+      z * (8.33333333332248946124e-03 +
+           z * (-1.98412698298579493134e-04 +
+                z * (2.75573137070700676789e-06 +
+                     z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10))));
+  const double cos_poly =
+      4.16666666666666019037e-02 +
+      z * (-1.38888888888741095749e-03 +
+           z * (2.48015872894767294178e-05 +
+                z * (-2.75573143513906633035e-07 +
+                     z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11))));
+  const double s = r + r * z * sin_poly;
+  const double c = 1.0 - 0.5 * z + z * z * cos_poly;
+
+  // The low mantissa bits of `shifted` hold k modulo 4. Unlike a conversion of k they are
+  // defined for any angle, including huge, infinite and NaN ones.
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &shifted, sizeof(bits));
+  const auto quadrant = static_cast<std::int32_t>(bits & 3U);
+  const double swap = static_cast<double>(quadrant & 1);
+  const double sine_sign = 1.0 - 2.0 * static_cast<double>((quadrant >> 1) & 1);
+  const double cosine_sign = 1.0 - 2.0 * static_cast<double>(((quadrant + 1) >> 1) & 1);
+  // One of the two products is an exact zero, so the sums are exact selections.
+  sine = sine_sign * (s * (1.0 - swap) + c * swap);
+  cosine = cosine_sign * (c * (1.0 - swap) + s * swap);
+}
+
+/** Computes sine and cosine for many angles.
+ *
+ *  Uses @ref fast_sincos in a vectorizable loop. Angles outside of
+ *  @ref fast_sincos_range are recomputed with @c std::sin and @c std::cos afterwards.
+ *
+ *  @param angles The angles in [rad].
+ *  @param sines Receives the sines, must hold at least @c angles.size() values.
+ *  @param cosines Receives the cosines, must hold at least @c angles.size() values.
+ */
+inline void sincos(span<const double> angles, span<double> sines, span<double> cosines) {
+  const std::size_t n = angles.size();
+  const double* in = angles.data();
+  double* sin_out = sines.data();
+  double* cos_out = cosines.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    fast_sincos(in[i], sin_out[i], cos_out[i]);
+  }
+  // Kept out of the loop above, the branch would prevent its vectorization.
+  for (std::size_t i = 0; i < n; ++i) {
+    if (std::fabs(in[i]) > fast_sincos_range) {
+      sin_out[i] = std::sin(in[i]);
+      cos_out[i] = std::cos(in[i]);
+    }
+  }
+}
+
 /** Normalizes an angle to the range [-Pi, Pi)
  *  @tparam T Any floating point type
  *  @param angle Angle that is normalized, in [rad]
@@ -5,12 +5,15 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 
 #include "trailblaze/constants.h"
 #include "trailblaze/math/angle.h"
 #include "trailblaze/math/util.h"
 #include "trailblaze/quaternion.h"
+#include "trailblaze/span.h"
 
 namespace trailblaze {
 
@@ -93,4 +96,115 @@ inline quaternion interpolate_quaternion(const quaternion& a, quaternion b, doub
   return out;
 }
 
+namespace detail {
+
+/** Approximates sin(x) for x in [0, Pi/2] with its Taylor polynomial of degree 15.
+ *
+ *  The truncation error is below 7e-12 on that interval. The function is branch-free, so
+ *  loops calling it can be vectorized.
+ */
+inline double sin_quarter_turn(double x) {
+  const double x2 = x * x;
+  return x * (1.0 +
+              x2 * (-1.0 / 6.0 +
+                    x2 * (1.0 / 120.0 +
+                          x2 * (-1.0 / 5040.0 +
+                                x2 * (1.0 / 362880.0 +
+                                      x2 * (-1.0 / 39916800.0 +
+                                            x2 * (1.0 / 6227020800.0 +
+                                                  x2 * (-1.0 / 1307674368000.0))))))));
+}
+
+} // namespace detail
+
+/** Spherical linear interpolation on one fixed pair of quaternions.
+ *
+ *  Produces the same results as @ref interpolate_quaternion, but the setup that only
+ *  depends on the two quaternions (sign correction, the angle theta between them and
+ *  1 / sin(theta)) is done once at construction. This pays off whenever a segment is
+ *  evaluated at several ratios, e.g. when resampling orientation tracks.
+ *
+ *  The batch call additionally replaces @c std::sin by a polynomial and is written as a
+ *  vectorizable loop. For ratios in [0, 1] its results deviate from
+ *  @ref interpolate_quaternion by less than 1e-11 per component.
+ */
+class quaternion_slerp {
+public:
+  /** Constructor
+   *  @param a The quaternion at ratio 0.
+   *  @param b The quaternion at ratio 1.
+   */
+  quaternion_slerp(const quaternion& a, const quaternion& b) : a_(a), b_(b) {
+    double dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    if (dot < 0.0) {
+      b_ = -1.0 * b_;
+      dot = -dot;
+    }
+    linear_ = dot > 1.0 - constants::quaternion_interpolation_epsilon;
+    if (!linear_) {
+      theta_ = std::acos(std::max(-1.0, std::min(1.0, dot)));
+      inverse_sin_theta_ = 1.0 / std::sin(theta_);
+    }
+  }
+
+  /** Interpolates at a single ratio.
+   *  @param t The ratio, see @ref interpolate_quaternion.
+   *  @returns the normalized interpolated quaternion.
+   */
+  [[__nodiscard__]] quaternion operator()(double t) const {
+    if (linear_) {
+      return combine(1.0 - t, t);
+    }
+    return combine(std::sin((1.0 - t) * theta_) * inverse_sin_theta_,
+                   std::sin(t * theta_) * inverse_sin_theta_);
+  }
+
+  /** Interpolates at many ratios.
+   *  @param ratios The ratios, see @ref interpolate_quaternion.
+   *  @param out Receives one normalized quaternion per ratio. Must hold at least
+   *         @c ratios.size() quaternions.
+   */
+  void operator()(span<const double> ratios, span<quaternion> out) const {
+    assert(out.size() >= ratios.size());
+    bool in_unit_interval = true;
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      in_unit_interval = in_unit_interval && ratios[i] >= 0.0 && ratios[i] <= 1.0;
+    }
+    if (linear_ || !in_unit_interval) {
+      for (std::size_t i = 0; i < ratios.size(); ++i) {
+        out[i] = (*this)(ratios[i]);
+      }
+      return;
+    }
+    // theta is in [0, Pi/2] after the sign correction, so are both sine arguments.
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      const double t = ratios[i];
+      out[i] = combine(detail::sin_quarter_turn((1.0 - t) * theta_) * inverse_sin_theta_,
+                       detail::sin_quarter_turn(t * theta_) * inverse_sin_theta_);
+    }
+  }
+
+private:
+  /// Weighted sum of both quaternions, normalized.
+  [[__nodiscard__]] quaternion combine(double weight_a, double weight_b) const {
+    const double x = a_.x * weight_a + b_.x * weight_b;
+    const double y = a_.y * weight_a + b_.y * weight_b;
+    const double z = a_.z * weight_a + b_.z * weight_b;
+    const double w = a_.w * weight_a + b_.w * weight_b;
+    const double inverse_norm = 1.0 / std::sqrt(square(x) + square(y) + square(z) + square(w));
+    return {x * inverse_norm, y * inverse_norm, z * inverse_norm, w * inverse_norm};
+  }
+
+  /// The quaternion at ratio 0.
+  quaternion a_;
+  /// The quaternion at ratio 1, negated if needed to take the shorter arc.
+  quaternion b_;
+  /// If the quaternions are nearly identical, interpolation falls back to a linear blend.
+  bool linear_{false};
+  /// The angle between both quaternions.
+  double theta_{0.};
+  /// 1 / sin(theta)
+  double inverse_sin_theta_{0.};
+};
+
 } // namespace trailblaze
@@ -0,0 +1,186 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+
+/** @file polygon.h
+ *  @brief Basic geometric predicates for simple polygons given as vertex sequences. The last
+ *         vertex is implicitly connected with the first one.
+ */
+
+namespace trailblaze {
+
+/// An axis aligned box.
+struct box2d {
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+};
+
+/** Checks if a point lies inside a polygon (even-odd rule).
+ *  @param polygon The polygon vertices.
+ *  @param point The point.
+ *  @returns @c true if @p point lies inside of @p polygon. Points exactly on an edge may be
+ *           reported either way.
+ */
+inline bool polygon_contains(span<const state_r2> polygon, const state_r2& point) noexcept {
+  bool inside = false;
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const state_r2& a = polygon[i];
+    const state_r2& b = polygon[j];
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/** Computes the squared distance of a point to a line segment.
+ *  @param point The point.
+ *  @param a The start of the segment.
+ *  @param b The end of the segment.
+ *  @returns the squared Euclidean distance.
+ */
+inline double segment_squared_distance(const state_r2& point, const state_r2& a,
+                                       const state_r2& b) noexcept {
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  const double length_squared = dx * dx + dy * dy;
+  double t = 0.0;
+  if (length_squared > 0.0) {
+    t = std::clamp(((point.x - a.x) * dx + (point.y - a.y) * dy) / length_squared, 0.0, 1.0);
+  }
+  const double ex = point.x - (a.x + t * dx);
+  const double ey = point.y - (a.y + t * dy);
+  return ex * ex + ey * ey;
+}
+
+/** Computes the distance of a point to a line segment.
+ *  @param point The point.
+ *  @param a The start of the segment.
+ *  @param b The end of the segment.
+ *  @returns the Euclidean distance.
+ */
+inline double segment_distance(const state_r2& point, const state_r2& a,
+                               const state_r2& b) noexcept {
+  return std::sqrt(segment_squared_distance(point, a, b));
+}
+
+/** Checks if two line segments have a point in common.
+ *  @param a The start of the first segment.
+ *  @param b The end of the first segment.
+ *  @param c The start of the second segment.
+ *  @param d The end of the second segment.
+ *  @returns @c true if the segments cross or touch, including collinear overlaps.
+ */
+inline bool segments_intersect(const state_r2& a, const state_r2& b, const state_r2& c,
+                               const state_r2& d) noexcept {
+  // Orientation of r relative to the line through p and q.
+  const auto orientation = [](const state_r2& p, const state_r2& q, const state_r2& r) {
+    const double cross = (q.x - p.x) * (r.y - p.y) - (q.y - p.y) * (r.x - p.x);
+    return (cross > 0.0) - (cross < 0.0);
+  };
+  // Checks if r lies in the bounding box of p and q, for collinear points only.
+  const auto within = [](const state_r2& p, const state_r2& q, const state_r2& r) {
+    return std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x) && std::min(p.y, q.y) <= r.y &&
+           r.y <= std::max(p.y, q.y);
+  };
+  const int o1 = orientation(a, b, c);
+  const int o2 = orientation(a, b, d);
+  const int o3 = orientation(c, d, a);
+  const int o4 = orientation(c, d, b);
+  if (o1 * o2 < 0 && o3 * o4 < 0) {
+    return true;
+  }
+  return (o1 == 0 && within(a, b, c)) || (o2 == 0 && within(a, b, d)) ||
+         (o3 == 0 && within(c, d, a)) || (o4 == 0 && within(c, d, b));
+}
+
+/** Checks if a line segment intersects an axis aligned box (Liang-Barsky clipping).
+ *  @param a The start of the segment.
+ *  @param b The end of the segment.
+ *  @param box The box, boundaries included.
+ *  @returns @c true if any point of the segment lies inside of the box.
+ */
+inline bool segment_intersects_box(const state_r2& a, const state_r2& b,
+                                   const box2d& box) noexcept {
+  double t_enter = 0.0;
+  double t_exit = 1.0;
+  const auto clip = [&](double direction, double start, double lower, double upper) {
+    if (direction == 0.0) {
+      return start >= lower && start <= upper;
+    }
+    double t0 = (lower - start) / direction;
+    double t1 = (upper - start) / direction;
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    t_enter = std::max(t_enter, t0);
+    t_exit = std::min(t_exit, t1);
+    return t_enter <= t_exit;
+  };
+  return clip(b.x - a.x, a.x, box.min_x, box.max_x) && clip(b.y - a.y, a.y, box.min_y, box.max_y);
+}
+
+/** Checks if a polygon and an axis aligned box overlap.
+ *  @param polygon The polygon vertices.
+ *  @param box The box, boundaries included.
+ *  @returns @c true if the areas of @p polygon and @p box have a point in common.
+ */
+inline bool polygon_intersects_box(span<const state_r2> polygon, const box2d& box) noexcept {
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    if (segment_intersects_box(polygon[j], polygon[i], box)) {
+      return true;
+    }
+  }
+  // No edge touches the box, so either the box lies completely inside the polygon or the
+  // two are disjoint.
+  return polygon_contains(polygon,
+                          {0.5 * (box.min_x + box.max_x), 0.5 * (box.min_y + box.max_y)});
+}
+
+/** Checks if a polygon and a line segment overlap.
+ *  @param polygon The polygon vertices.
+ *  @param a The start of the segment.
+ *  @param b The end of the segment.
+ *  @returns @c true if the area of @p polygon and the segment have a point in common.
+ */
+inline bool polygon_intersects_segment(span<const state_r2> polygon, const state_r2& a,
+                                       const state_r2& b) noexcept {
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    if (segments_intersect(a, b, polygon[j], polygon[i])) {
+      return true;
+    }
+  }
+  // No edge is crossed, so the segment lies either completely inside or outside.
+  return polygon_contains(polygon, a);
+}
+
+/** Computes the distance of a point to the area of a polygon.
+ *  @param polygon The polygon vertices.
+ *  @param point The point.
+ *  @returns 0 if @p point lies inside of @p polygon, else the distance to its boundary.
+ */
+inline double polygon_distance(span<const state_r2> polygon, const state_r2& point) noexcept {
+  if (polygon_contains(polygon, point)) {
+    return 0.0;
+  }
+  double squared = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    squared = std::min(squared, segment_squared_distance(point, polygon[j], polygon[i]));
+  }
+  return std::sqrt(squared);
+}
+
+} // namespace trailblaze
@@ -76,7 +76,7 @@ public:
   }
 
   void clear() noexcept {
-    storage_.Clear();
+    storage_.clear();
   }
 
   [[__nodiscard__]] TState& start() {
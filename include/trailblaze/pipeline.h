@@ -0,0 +1,416 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "trailblaze/algorithm/annotate.h"
+#include "trailblaze/component_access.h"
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_space.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/state_traits.h"
+
+/** @file pipeline.h
+ *  @brief Lazy, pull based path processing.
+ *
+ *  A pipeline is a chain of stages that hand states downstream one at a time, so no stage
+ *  materializes a full path:
+ *  @code
+ *    using namespace trailblaze::pipeline;
+ *    const double length = length_xy(states(input) | resampled(0.1) | yaw_from_chord() |
+ *                                    transformed(to_world));
+ *  @endcode
+ *
+ *  Every source and stage provides
+ *  @code
+ *    using value_type = ...;
+ *    bool next(value_type& out); // false once exhausted
+ *  @endcode
+ *  and holds at most a few states, independent of the path length. Stages own their
+ *  upstream by value; sources over existing data only hold a view, which has to outlive the
+ *  pipeline.
+ */
+
+namespace trailblaze::pipeline {
+
+// ---------------------- sources ----------------------
+
+/// Source that reads the states of a span.
+template <typename TState>
+class span_source {
+public:
+  using value_type = std::remove_const_t<TState>;
+
+  explicit span_source(span<TState> states) : states_(states) {}
+
+  bool next(value_type& out) {
+    if (index_ >= states_.size()) {
+      return false;
+    }
+    out = states_[index_++];
+    return true;
+  }
+
+private:
+  span<TState> states_;
+  std::size_t index_{0};
+};
+
+/** Starts a pipeline from the states of a span.
+ *  @param states The states, must outlive the pipeline.
+ */
+template <typename TState>
+span_source<TState> states(span<TState> states) {
+  return span_source<TState>(states);
+}
+
+/** Starts a pipeline from the states of a path.
+ *  @param input The path, must outlive the pipeline.
+ */
+template <typename TState>
+span_source<const TState> states(const path<TState>& input) {
+  return span_source<const TState>(input.states());
+}
+
+// ---------------------- stages ----------------------
+
+/** Lazy counterpart of @ref resample with a sample density.
+ *
+ *  Emits the same states as the eager algorithm, including the first and last state of
+ *  the upstream.
+ */
+template <typename TSource, typename TMetric, typename TInterpolation>
+class resample_stage {
+public:
+  using value_type = typename TSource::value_type;
+
+  resample_stage(TSource source, double sample_density, TMetric metric,
+                 TInterpolation interpolator)
+      : source_(std::move(source)), sample_density_(sample_density), metric_(std::move(metric)),
+        interpolator_(std::move(interpolator)) {}
+
+  bool next(value_type& out) {
+    if (!started_) {
+      started_ = true;
+      if (!source_.next(previous_)) {
+        return false;
+      }
+      out = previous_;
+      return true;
+    }
+    if (sample_density_ <= 0.0) {
+      // Only the first and last state.
+      while (source_.next(current_)) {
+        has_second_ = true;
+      }
+      return emit_last(out, current_);
+    }
+    while (true) {
+      if (remaining_length_ > 0.0 && carried_distance_ + remaining_length_ >= sample_density_) {
+        const double t_along_segment =
+            1.0 - (remaining_length_ - (sample_density_ - carried_distance_)) / segment_length_;
+        remaining_length_ -= (sample_density_ - carried_distance_);
+        carried_distance_ = 0.0;
+        out = interpolator_(previous_, current_, t_along_segment);
+        return true;
+      }
+      if (remaining_length_ > 0.0) {
+        carried_distance_ += remaining_length_;
+        remaining_length_ = 0.0;
+      }
+      if (has_second_) {
+        previous_ = current_;
+      }
+      if (!source_.next(current_)) {
+        return emit_last(out, previous_);
+      }
+      has_second_ = true;
+      const double length = metric_(previous_, current_);
+      if (length > std::numeric_limits<double>::epsilon()) {
+        segment_length_ = length;
+        remaining_length_ = length;
+      }
+    }
+  }
+
+private:
+  bool emit_last(value_type& out, const value_type& last) {
+    if (!has_second_ || finished_) {
+      return false;
+    }
+    finished_ = true;
+    out = last;
+    return true;
+  }
+
+  TSource source_;
+  double sample_density_;
+  TMetric metric_;
+  TInterpolation interpolator_;
+  value_type previous_{};
+  value_type current_{};
+  double segment_length_{0.};
+  double remaining_length_{0.};
+  double carried_distance_{0.};
+  bool started_{false};
+  bool has_second_{false};
+  bool finished_{false};
+};
+
+/** Lazy counterpart of @ref annotate::yaw_chord.
+ *
+ *  States that have a yaw component keep their type and get the yaw overwritten, other
+ *  states are turned into @c state_se2. Holds one state of look-ahead.
+ */
+template <typename TSource>
+class yaw_chord_stage {
+public:
+  using input_type = typename TSource::value_type;
+  using value_type = std::conditional_t<has_yaw_v<input_type>, input_type, state_se2>;
+
+  yaw_chord_stage(TSource source, annotate::yaw_precision precision)
+      : source_(std::move(source)), precision_(precision) {}
+
+  bool next(value_type& out) {
+    if (!primed_) {
+      primed_ = true;
+      has_current_ = source_.next(current_);
+      has_ahead_ = has_current_ && source_.next(ahead_);
+    }
+    if (!has_current_) {
+      return false;
+    }
+    if (has_ahead_) {
+      // forward chord; the last state reuses the chord of its predecessor
+      yaw_ = precision_ == annotate::yaw_precision::fast
+                 ? annotate::detail::chord_heading<annotate::yaw_precision::fast>(current_, ahead_)
+                 : annotate::detail::chord_heading<annotate::yaw_precision::exact>(current_,
+                                                                                   ahead_);
+    }
+    if constexpr (std::is_same_v<value_type, input_type>) {
+      out = current_;
+    }
+    annotate::detail::assign(out, current_, yaw_);
+    if (has_ahead_) {
+      current_ = ahead_;
+      has_ahead_ = source_.next(ahead_);
+    } else {
+      has_current_ = false;
+    }
+    return true;
+  }
+
+private:
+  TSource source_;
+  annotate::yaw_precision precision_;
+  input_type current_{};
+  input_type ahead_{};
+  double yaw_{0.};
+  bool primed_{false};
+  bool has_current_{false};
+  bool has_ahead_{false};
+};
+
+/// Applies a callable to every state.
+template <typename TSource, typename TFunction>
+class transform_stage {
+public:
+  using input_type = typename TSource::value_type;
+  using value_type = std::decay_t<std::invoke_result_t<TFunction&, const input_type&>>;
+
+  transform_stage(TSource source, TFunction function)
+      : source_(std::move(source)), function_(std::move(function)) {}
+
+  bool next(value_type& out) {
+    if (!source_.next(input_)) {
+      return false;
+    }
+    out = function_(static_cast<const input_type&>(input_));
+    return true;
+  }
+
+private:
+  TSource source_;
+  TFunction function_;
+  input_type input_{};
+};
+
+// ---------------------- adaptors ----------------------
+
+namespace detail {
+
+/// Base of all objects that can appear on the right hand side of @c operator|.
+struct adaptor {};
+
+template <typename T>
+inline constexpr bool is_adaptor_v = std::is_base_of_v<adaptor, std::decay_t<T>>;
+
+template <typename T, typename = void>
+struct is_source : std::false_type {};
+
+template <typename T>
+struct is_source<T, std::void_t<decltype(std::declval<T&>().next(
+                        std::declval<typename T::value_type&>()))>> : std::true_type {};
+
+/// Checks for the source interface, i.e. @c value_type and @c next(value_type&).
+template <typename T>
+inline constexpr bool is_source_v = is_source<std::decay_t<T>>::value;
+
+} // namespace detail
+
+/// See @ref resampled.
+template <typename TMetric, typename TInterpolation>
+struct resampled_adaptor : detail::adaptor {
+  double sample_density;
+  TMetric metric;
+  TInterpolation interpolator;
+
+  template <typename TSource>
+  auto operator()(TSource source) const {
+    return resample_stage<TSource, TMetric, TInterpolation>(std::move(source), sample_density,
+                                                            metric, interpolator);
+  }
+};
+
+/// Uses the metric and interpolation of the state space, see @ref resampled.
+struct resampled_default_adaptor : detail::adaptor {
+  double sample_density;
+
+  template <typename TSource>
+  auto operator()(TSource source) const {
+    using state_type = typename TSource::value_type;
+    using metric = typename state_space<state_type>::metric_type;
+    using interpolation = typename state_space<state_type>::interpolation_type;
+    return resample_stage<TSource, metric, interpolation>(std::move(source), sample_density,
+                                                          metric{}, interpolation{});
+  }
+};
+
+/** Resamples the stream at approximately uniform spatial intervals, see @ref resample.
+ *  @param sample_density Desired distance between consecutive samples.
+ */
+inline resampled_default_adaptor resampled(double sample_density) {
+  return resampled_default_adaptor{{}, sample_density};
+}
+
+/** Resamples the stream with a custom metric and interpolation, see @ref resample.
+ *  @param sample_density Desired distance between consecutive samples.
+ *  @param metric Distance between two states.
+ *  @param interpolator Interpolates between two states.
+ */
+template <typename TMetric, typename TInterpolation>
+resampled_adaptor<TMetric, TInterpolation> resampled(double sample_density, TMetric metric,
+                                                     TInterpolation interpolator) {
+  return {{}, sample_density, std::move(metric), std::move(interpolator)};
+}
+
+/// See @ref yaw_from_chord.
+struct yaw_from_chord_adaptor : detail::adaptor {
+  annotate::yaw_precision precision;
+
+  template <typename TSource>
+  auto operator()(TSource source) const {
+    return yaw_chord_stage<TSource>(std::move(source), precision);
+  }
+};
+
+/** Annotates yaw from the forward chord, see @ref annotate::yaw_chord.
+ *  @param precision How the angles are computed.
+ */
+inline yaw_from_chord_adaptor
+yaw_from_chord(annotate::yaw_precision precision = annotate::yaw_precision::exact) {
+  return yaw_from_chord_adaptor{{}, precision};
+}
+
+/// See @ref transformed.
+template <typename TFunction>
+struct transformed_adaptor : detail::adaptor {
+  TFunction function;
+
+  template <typename TSource>
+  auto operator()(TSource source) const {
+    return transform_stage<TSource, TFunction>(std::move(source), function);
+  }
+};
+
+/** Applies @p function to every state of the stream.
+ *  @param function Callable with one state argument, returns the new state.
+ */
+template <typename TFunction>
+transformed_adaptor<TFunction> transformed(TFunction function) {
+  return {{}, std::move(function)};
+}
+
+/** Attaches a stage to a source.
+ *  @param source A source or stage.
+ *  @param stage_adaptor The adaptor describing the next stage.
+ *  @returns the new stage.
+ */
+template <typename TSource, typename TAdaptor,
+          typename = std::enable_if_t<detail::is_source_v<TSource> &&
+                                      detail::is_adaptor_v<TAdaptor>>>
+auto operator|(TSource source, const TAdaptor& stage_adaptor) {
+  return stage_adaptor(std::move(source));
+}
+
+// ---------------------- sinks ----------------------
+
+/** Pulls all states and passes them to @p function.
+ *  @param source A source or stage.
+ *  @param function Callable with one state argument.
+ *  @returns the number of states.
+ */
+template <typename TSource, typename TFunction,
+          typename = std::enable_if_t<detail::is_source_v<TSource>>>
+std::size_t for_each(TSource&& source, TFunction&& function) {
+  typename std::decay_t<TSource>::value_type state{};
+  std::size_t count = 0;
+  while (source.next(state)) {
+    function(static_cast<const decltype(state)&>(state));
+    ++count;
+  }
+  return count;
+}
+
+/** Pulls all states into a path.
+ *  @param source A source or stage.
+ *  @returns the materialized states.
+ */
+template <typename TSource, typename = std::enable_if_t<detail::is_source_v<TSource>>>
+path<typename std::decay_t<TSource>::value_type> collect(TSource&& source) {
+  path<typename std::decay_t<TSource>::value_type> out;
+  for_each(source, [&out](const auto& state) { out.push_back(state); });
+  return out;
+}
+
+/** Computes the xy length of the stream, see @ref trailblaze::length_xy.
+ *  @param source A source or stage whose states have x and y components.
+ *  @returns the length.
+ */
+template <typename TSource, typename = std::enable_if_t<detail::is_source_v<TSource>>>
+double length_xy(TSource&& source) {
+  using state_type = typename std::decay_t<TSource>::value_type;
+  static_assert(has_xy_v<state_type>, "length_xy: states must have components x & y");
+  double length = 0.0;
+  bool first = true;
+  double x = 0.0;
+  double y = 0.0;
+  for_each(source, [&](const state_type& state) {
+    if (!first) {
+      length += std::hypot(comp::x(state) - x, comp::y(state) - y);
+    }
+    first = false;
+    x = comp::x(state);
+    y = comp::y(state);
+  });
+  return length;
+}
+
+} // namespace trailblaze::pipeline
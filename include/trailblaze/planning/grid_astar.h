@@ -0,0 +1,363 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+
+/** @file grid_astar.h
+ *  @brief A* search on the cells of an occupancy grid.
+ *
+ *  The search moves between the centers of free cells, to the 4 or 8 neighbors of a cell.
+ *  Diagonal moves must not cut the corner of an occupied cell, i.e. both cells that share an
+ *  edge with the two cells of the move have to be free. The heuristic is the Manhattan or
+ *  octile distance, which is consistent, so the first path that reaches the goal is shortest.
+ *
+ *  All memory of a search lives in a @ref search_workspace sized to the grid: a flat array of
+ *  per cell nodes and the open list. Instead of clearing the nodes, every search has a new
+ *  generation number and nodes of older generations count as unvisited, so a search only
+ *  touches the cells it visits.
+ */
+
+namespace trailblaze::planning {
+
+/// Parameters of @ref grid_astar.
+struct grid_search_options {
+  /// Whether to move to the 8 neighbors of a cell, else to the 4 edge neighbors.
+  bool diagonal{true};
+  /** Factor of the heuristic. Values above 1 expand fewer cells, the cost of the resulting
+   *  path is then at most this factor times the optimum.
+   */
+  double heuristic_weight{1.0};
+};
+
+namespace detail {
+
+/// Cost of a diagonal move relative to an edge move.
+inline constexpr double diagonal_factor = 1.4142135623730951;
+
+} // namespace detail
+
+class search_workspace;
+
+template <typename TCell>
+bool grid_astar(const env::occupancy_grid<TCell>& grid, const state_r2& start,
+                const state_r2& goal, search_workspace& workspace, path<state_r2>& out,
+                const grid_search_options& options = {});
+
+/** Reusable memory of @ref grid_astar for grids of one size.
+ *
+ *  Holds one node of 16 bytes per cell, a parent direction byte per cell and an open list
+ *  with room for every cell, so searches never allocate. The open list is a 4-ary heap of
+ *  16 byte entries, which is half as deep as a binary heap and keeps the children of an entry
+ *  in 64 contiguous bytes. Each node knows its position in the heap for decrease-key.
+ */
+class search_workspace {
+public:
+  /** Constructor
+   *  @param width Number of cells of the grids in x direction.
+   *  @param height Number of cells of the grids in y direction.
+   *  @throws std::invalid_argument if the grid has 2^32 or more cells.
+   */
+  search_workspace(std::size_t width, std::size_t height) : width_(width), height_(height) {
+    if (height != 0 && width >= std::numeric_limits<std::uint32_t>::max() / height) {
+      throw std::invalid_argument("search_workspace: grid has too many cells!");
+    }
+    nodes_.resize(width * height);
+    parents_.resize(width * height);
+    heap_.reserve(width * height);
+  }
+
+  /** Creates a workspace for the size of @p grid.
+   *  @param grid The occupancy grid.
+   */
+  template <typename TCell>
+  explicit search_workspace(const env::occupancy_grid<TCell>& grid)
+      : search_workspace(grid.width(), grid.height()) {}
+
+  [[__nodiscard__]] std::size_t width() const noexcept {
+    return width_;
+  }
+
+  [[__nodiscard__]] std::size_t height() const noexcept {
+    return height_;
+  }
+
+  /// @returns the number of cells expanded by the last search.
+  [[__nodiscard__]] std::size_t expanded_count() const noexcept {
+    return expanded_count_;
+  }
+
+  /// @returns the cost of the path found by the last search, infinity if there is none.
+  [[__nodiscard__]] double path_cost() const noexcept {
+    return path_cost_;
+  }
+
+  template <typename TCell>
+  friend bool grid_astar(const env::occupancy_grid<TCell>& grid, const state_r2& start,
+                         const state_r2& goal, search_workspace& workspace, path<state_r2>& out,
+                         const grid_search_options& options);
+
+private:
+  /// Heap position of nodes that have been expanded.
+  static constexpr std::uint32_t closed = std::numeric_limits<std::uint32_t>::max();
+
+  struct node {
+    /// Cost from the start, valid if @ref generation is the current one.
+    double g;
+    std::uint32_t generation;
+    /// Position in the heap, or @ref closed.
+    std::uint32_t heap_index;
+  };
+
+  struct heap_entry {
+    double f;
+    /// Heuristic, breaks ties of @ref f towards the goal.
+    float h;
+    std::uint32_t cell;
+  };
+
+  static constexpr std::size_t arity = 4;
+
+  [[__nodiscard__]] static bool less(const heap_entry& a, const heap_entry& b) noexcept {
+    return a.f < b.f || (a.f == b.f && a.h < b.h);
+  }
+
+  /// Starts a new search, which invalidates all nodes.
+  void begin_search() {
+    if (++generation_ == 0) {
+      // After 2^32 searches: reset the generations once.
+      for (node& n : nodes_) {
+        n.generation = 0;
+      }
+      generation_ = 1;
+    }
+    heap_.clear();
+    expanded_count_ = 0;
+    path_cost_ = std::numeric_limits<double>::infinity();
+  }
+
+  void push(const heap_entry& entry) {
+    heap_.push_back(entry);
+    sift_up(heap_.size() - 1);
+  }
+
+  heap_entry pop() {
+    const heap_entry top = heap_.front();
+    nodes_[top.cell].heap_index = closed;
+    const heap_entry last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_.front() = last;
+      sift_down(0);
+    }
+    return top;
+  }
+
+  void sift_up(std::size_t position) {
+    const heap_entry entry = heap_[position];
+    while (position > 0) {
+      const std::size_t parent = (position - 1) / arity;
+      if (!less(entry, heap_[parent])) {
+        break;
+      }
+      heap_[position] = heap_[parent];
+      nodes_[heap_[position].cell].heap_index = static_cast<std::uint32_t>(position);
+      position = parent;
+    }
+    heap_[position] = entry;
+    nodes_[entry.cell].heap_index = static_cast<std::uint32_t>(position);
+  }
+
+  void sift_down(std::size_t position) {
+    const heap_entry entry = heap_[position];
+    const std::size_t size = heap_.size();
+    while (true) {
+      const std::size_t first_child = position * arity + 1;
+      if (first_child >= size) {
+        break;
+      }
+      const std::size_t last_child = std::min(first_child + arity, size);
+      std::size_t best = first_child;
+      for (std::size_t child = first_child + 1; child < last_child; ++child) {
+        if (less(heap_[child], heap_[best])) {
+          best = child;
+        }
+      }
+      if (!less(heap_[best], entry)) {
+        break;
+      }
+      heap_[position] = heap_[best];
+      nodes_[heap_[position].cell].heap_index = static_cast<std::uint32_t>(position);
+      position = best;
+    }
+    heap_[position] = entry;
+    nodes_[entry.cell].heap_index = static_cast<std::uint32_t>(position);
+  }
+
+  std::size_t width_;
+  std::size_t height_;
+  std::uint32_t generation_{0};
+  std::size_t expanded_count_{0};
+  double path_cost_{std::numeric_limits<double>::infinity()};
+  /// Nodes of the cells in row-major order.
+  std::vector<node> nodes_;
+  /// Index into the neighbor offsets of the move that reached each cell.
+  std::vector<std::uint8_t> parents_;
+  /// The open list.
+  std::vector<heap_entry> heap_;
+};
+
+/** Searches the shortest path between two positions on an occupancy grid.
+ *
+ *  Does not allocate, except to grow @p out.
+ *
+ *  @tparam TCell The cell type of the occupancy grid.
+ *  @param grid The occupancy grid.
+ *  @param start The start position.
+ *  @param goal The goal position.
+ *  @param workspace Memory of the search, must have the size of @p grid.
+ *  @param out Receives the centers of the cells along the path, from the cell of @p start to
+ *         the cell of @p goal. Cleared if there is no path.
+ *  @param options Parameters of the search.
+ *  @returns @c true if a path was found. There is none if the start or goal cell is occupied
+ *           or outside of the grid, or if they are not connected.
+ *  @throws std::invalid_argument if @p workspace does not have the size of @p grid.
+ */
+template <typename TCell>
+bool grid_astar(const env::occupancy_grid<TCell>& grid, const state_r2& start,
+                const state_r2& goal, search_workspace& workspace, path<state_r2>& out,
+                const grid_search_options& options) {
+  using heap_entry = search_workspace::heap_entry;
+  if (workspace.width() != grid.width() || workspace.height() != grid.height()) {
+    throw std::invalid_argument("grid_astar: workspace does not have the size of the grid!");
+  }
+  workspace.begin_search();
+  out.clear();
+  const env::cell_index start_cell = grid.cell_of(start.x, start.y);
+  const env::cell_index goal_cell = grid.cell_of(goal.x, goal.y);
+  const auto is_free = [&](std::int64_t x, std::int64_t y) {
+    return !grid.is_occupied_value(grid.value({x, y}));
+  };
+  if (!is_free(start_cell.x, start_cell.y) || !is_free(goal_cell.x, goal_cell.y)) {
+    return false;
+  }
+
+  // Moves: the 4 edge neighbors first, then the diagonals, whose corners are the two moves
+  // that share a component with them.
+  static constexpr std::array<int, 8> dx{1, 0, -1, 0, 1, -1, -1, 1};
+  static constexpr std::array<int, 8> dy{0, 1, 0, -1, 1, 1, -1, -1};
+  const std::size_t move_count = options.diagonal ? 8 : 4;
+  const auto width = static_cast<std::int64_t>(grid.width());
+  const double resolution = grid.resolution();
+  const double diagonal_cost = detail::diagonal_factor * resolution;
+  const double weight = options.heuristic_weight * resolution;
+  const double diagonal_weight = options.diagonal ? detail::diagonal_factor - 2.0 : 0.0;
+  // Octile distance: max + (sqrt(2) - 1) * min = ax + ay + (sqrt(2) - 2) * min.
+  const auto heuristic = [&](std::int64_t x, std::int64_t y) {
+    const auto ax = static_cast<double>(std::abs(x - goal_cell.x));
+    const auto ay = static_cast<double>(std::abs(y - goal_cell.y));
+    return weight * (ax + ay + diagonal_weight * std::min(ax, ay));
+  };
+
+  std::vector<search_workspace::node>& nodes = workspace.nodes_;
+  std::vector<std::uint8_t>& parents = workspace.parents_;
+  const std::uint32_t generation = workspace.generation_;
+  const auto start_index = static_cast<std::uint32_t>(start_cell.y * width + start_cell.x);
+  const auto goal_index = static_cast<std::uint32_t>(goal_cell.y * width + goal_cell.x);
+  nodes[start_index] = {0.0, generation, 0};
+  const double start_h = heuristic(start_cell.x, start_cell.y);
+  workspace.push({start_h, static_cast<float>(start_h), start_index});
+
+  while (!workspace.heap_.empty()) {
+    const heap_entry current = workspace.pop();
+    if (current.cell == goal_index) {
+      break;
+    }
+    ++workspace.expanded_count_;
+    const std::int64_t x = static_cast<std::int64_t>(current.cell) % width;
+    const std::int64_t y = static_cast<std::int64_t>(current.cell) / width;
+    const double g = nodes[current.cell].g;
+    std::array<bool, 8> free{};
+    for (std::size_t move = 0; move < move_count; ++move) {
+      free[move] = is_free(x + dx[move], y + dy[move]);
+      // Diagonal move k connects the edge moves k - 4 and k - 3 (mod 4).
+      if (move >= 4 && !(free[move - 4] && free[(move - 3) % 4])) {
+        continue;
+      }
+      if (!free[move]) {
+        continue;
+      }
+      const std::int64_t nx = x + dx[move];
+      const std::int64_t ny = y + dy[move];
+      const auto index = static_cast<std::uint32_t>(ny * width + nx);
+      search_workspace::node& neighbor = nodes[index];
+      const double new_g = g + (move < 4 ? resolution : diagonal_cost);
+      if (neighbor.generation != generation) {
+        neighbor = {new_g, generation, 0};
+        parents[index] = static_cast<std::uint8_t>(move);
+        const double h = heuristic(nx, ny);
+        workspace.push({new_g + h, static_cast<float>(h), index});
+      } else if (neighbor.heap_index != search_workspace::closed && new_g < neighbor.g) {
+        heap_entry& entry = workspace.heap_[neighbor.heap_index];
+        entry.f += new_g - neighbor.g;
+        neighbor.g = new_g;
+        parents[index] = static_cast<std::uint8_t>(move);
+        workspace.sift_up(neighbor.heap_index);
+      }
+    }
+  }
+  if (nodes[goal_index].generation != generation ||
+      nodes[goal_index].heap_index != search_workspace::closed) {
+    return false;
+  }
+
+  // Walk the parents back to the start twice: to count the cells, then to write them.
+  workspace.path_cost_ = nodes[goal_index].g;
+  std::size_t count = 1;
+  for (env::cell_index cell = goal_cell; cell.x != start_cell.x || cell.y != start_cell.y;
+       ++count) {
+    const std::uint8_t move = parents[static_cast<std::size_t>(cell.y * width + cell.x)];
+    cell = {cell.x - dx[move], cell.y - dy[move]};
+  }
+  out.resize(count);
+  env::cell_index cell = goal_cell;
+  for (std::size_t i = count; i-- > 0;) {
+    out[i] = grid.cell_center(cell);
+    if (i > 0) {
+      const std::uint8_t move = parents[static_cast<std::size_t>(cell.y * width + cell.x)];
+      cell = {cell.x - dx[move], cell.y - dy[move]};
+    }
+  }
+  return true;
+}
+
+/** Searches the shortest path between two positions on an occupancy grid.
+ *  @see grid_astar(const env::occupancy_grid<TCell>&, const state_r2&, const state_r2&,
+ *       search_workspace&, path<state_r2>&, const grid_search_options&)
+ *  @returns the centers of the cells along the path, empty if there is none.
+ */
+template <typename TCell>
+[[__nodiscard__]] path<state_r2> grid_astar(const env::occupancy_grid<TCell>& grid,
+                                            const state_r2& start, const state_r2& goal,
+                                            search_workspace& workspace,
+                                            const grid_search_options& options = {}) {
+  path<state_r2> out;
+  grid_astar(grid, start, goal, workspace, out, options);
+  return out;
+}
+
+} // namespace trailblaze::planning
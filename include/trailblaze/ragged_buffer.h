@@ -0,0 +1,99 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "trailblaze/span.h"
+
+namespace trailblaze {
+
+/** Rows of varying length stored back to back in one contiguous block.
+ *
+ *  Row @c i occupies <tt>data()[offsets()[i], offsets()[i + 1])</tt>. Reshaping the buffer
+ *  keeps the allocated capacity, so a buffer that is reused e.g. once per planning cycle
+ *  stops allocating once it has seen its largest batch.
+ *
+ *  @tparam T The element type.
+ */
+template <typename T>
+class ragged_buffer {
+public:
+  /// @returns the number of rows.
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return offsets_.size() - 1;
+  }
+
+  /// @returns @c true if the buffer has no rows.
+  [[__nodiscard__]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// @returns the number of elements in all rows.
+  [[__nodiscard__]] std::size_t element_count() const noexcept {
+    return data_.size();
+  }
+
+  /// @returns the elements of row @p index.
+  [[__nodiscard__]] span<T> operator[](std::size_t index) noexcept {
+    assert(index < size());
+    return span<T>(data_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  /// @returns the elements of row @p index.
+  [[__nodiscard__]] span<const T> operator[](std::size_t index) const noexcept {
+    assert(index < size());
+    return span<const T>(data_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  /// @returns all elements, row after row.
+  [[__nodiscard__]] span<const T> data() const noexcept {
+    return span<const T>(data_);
+  }
+
+  /// @returns the row offsets into @ref data, with @ref size() + 1 entries.
+  [[__nodiscard__]] span<const std::size_t> offsets() const noexcept {
+    return span<const std::size_t>(offsets_);
+  }
+
+  /// Removes all rows, the capacity is kept.
+  void clear() noexcept {
+    data_.clear();
+    offsets_.resize(1);
+  }
+
+  /** Sets the number of rows and their lengths. The element values are unspecified
+   *  afterwards and are expected to be overwritten row by row.
+   *
+   *  @param row_count The number of rows.
+   *  @param row_size Callable invoked as <tt>row_size(i)</tt> that returns the length of
+   *         row @c i.
+   */
+  template <typename RowSize>
+  void reshape(std::size_t row_count, RowSize&& row_size) {
+    offsets_.resize(row_count + 1);
+    for (std::size_t i = 0; i < row_count; ++i) {
+      offsets_[i + 1] = offsets_[i] + row_size(i);
+    }
+    data_.resize(offsets_.back());
+  }
+
+  /** Appends a row.
+   *  @param row The elements of the new row.
+   */
+  void push_back(span<const T> row) {
+    data_.insert(data_.end(), row.begin(), row.end());
+    offsets_.push_back(data_.size());
+  }
+
+private:
+  /// All elements.
+  std::vector<T> data_;
+  /// Start offsets of the rows followed by the total element count.
+  std::vector<std::size_t> offsets_{0};
+};
+
+} // namespace trailblaze
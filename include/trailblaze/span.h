@@ -57,6 +57,12 @@ public:
   explicit constexpr span(const C& container) noexcept
       : ptr_(container.data()), len_(static_cast<size_type>(container.size())) {}
 
+  /// Converts e.g. a span<T> into a span<const T>.
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>> // NOLINT
+  constexpr span(const span<U>& other) noexcept // NOLINT(google-explicit-constructor)
+      : ptr_(other.data()), len_(other.size()) {}
+
   [[__nodiscard__]] constexpr pointer data() const noexcept {
     return ptr_;
   }
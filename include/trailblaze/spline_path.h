@@ -0,0 +1,333 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/state_traits.h"
+
+namespace trailblaze {
+
+/// The kind of cubic spline that is fitted through the states of a path.
+enum class spline_type {
+  /// Interpolating C2 spline with zero curvature at both ends.
+  natural,
+  /// Interpolating C2 spline with prescribed end tangents. The tangent directions are taken
+  /// from the yaw of the first and last state if available, otherwise from the end chords.
+  clamped,
+  /// Uniform Catmull-Rom spline (C1, local support).
+  catmull_rom,
+  /// Centripetal Catmull-Rom spline (C1, local support, no cusps or self-intersections
+  /// within a segment).
+  centripetal
+};
+
+/** A path representation as a piecewise cubic curve in the plane.
+ *
+ *  The spline interpolates the x and y components of the input states. Each segment between
+ *  two consecutive states is a cubic polynomial in a local parameter t in [0, 1]. The
+ *  coefficients are computed once at construction and stored per component in separate
+ *  arrays (structure of arrays), so that batch evaluation streams through memory.
+ *
+ *  Curves are evaluated at a global parameter s in [0, segment_count()], where the integer
+ *  part selects the segment and the fractional part is the local parameter. The state with
+ *  index i is located at s = i. Parameters outside of the range extrapolate the first or last
+ *  segment, a NaN parameter gives NaN results.
+ *
+ *  The interpolating variants (natural, clamped) use chord length knot spacing and are fitted
+ *  with a linear-time tridiagonal solve.
+ */
+class spline_path {
+public:
+  /** Fits a spline through states.
+   *  @tparam TState State type. Must satisfy the predicate @e has_xy_v.
+   *  @param states The states to interpolate. Consecutive states must have distinct positions.
+   *  @param type The kind of spline.
+   *  @throws std::invalid_argument if fewer than two states are given or two consecutive
+   *          states have the same position.
+   */
+  template <typename TState>
+  spline_path(span<const TState> states, spline_type type) : type_(type) {
+    static_assert(has_xy_v<TState>, "spline_path: TState must have components x & y");
+    if (states.size() < 2) {
+      throw std::invalid_argument("spline_path requires at least two states");
+    }
+    for (std::size_t i = 0; i + 1 < states.size(); ++i) {
+      if (states[i].x == states[i + 1].x && states[i].y == states[i + 1].y) {
+        throw std::invalid_argument("spline_path: states " + std::to_string(i) + " and " +
+                                    std::to_string(i + 1) + " have the same position");
+      }
+    }
+    const std::size_t segments = states.size() - 1;
+    for (auto* column : {&ax_, &bx_, &cx_, &dx_, &ay_, &by_, &cy_, &dy_}) {
+      column->resize(segments);
+    }
+    if (type == spline_type::natural || type == spline_type::clamped) {
+      fit_interpolating(states);
+    } else {
+      fit_catmull_rom(states, type == spline_type::centripetal ? 0.5 : 0.0);
+    }
+  }
+
+  /// @see spline_path(span<const TState>, spline_type)
+  template <typename TState>
+  spline_path(const path<TState>& input, spline_type type)
+      : spline_path(input.states(), type) {}
+
+  [[__nodiscard__]] spline_type type() const noexcept {
+    return type_;
+  }
+
+  /// @returns the number of cubic segments, i.e. the upper bound of the parameter range.
+  [[__nodiscard__]] std::size_t segment_count() const noexcept {
+    return ax_.size();
+  }
+
+  /// @returns the position at parameter @p s.
+  [[__nodiscard__]] state_r2 position(double s) const {
+    const auto [i, t] = locate(s);
+    return {horner(ax_[i], bx_[i], cx_[i], dx_[i], t), horner(ay_[i], by_[i], cy_[i], dy_[i], t)};
+  }
+
+  /// @returns the position at parameter @p s and the yaw of the tangent at that point.
+  [[__nodiscard__]] state_se2 state(double s) const {
+    const auto [i, t] = locate(s);
+    return {horner(ax_[i], bx_[i], cx_[i], dx_[i], t), horner(ay_[i], by_[i], cy_[i], dy_[i], t),
+            std::atan2(first_derivative(by_[i], cy_[i], dy_[i], t),
+                       first_derivative(bx_[i], cx_[i], dx_[i], t))};
+  }
+
+  /// @returns the signed curvature at parameter @p s (positive for left turns).
+  [[__nodiscard__]] double curvature(double s) const {
+    const auto [i, t] = locate(s);
+    return curvature_at(i, t);
+  }
+
+  /** Evaluates positions at many parameters.
+   *  @param params The parameters.
+   *  @param out Receives one position per parameter. Must hold at least @c params.size()
+   *         states.
+   */
+  void positions(span<const double> params, span<state_r2> out) const {
+    assert(out.size() >= params.size());
+    for (std::size_t k = 0; k < params.size(); ++k) {
+      const auto [i, t] = locate(params[k]);
+      out[k].x = horner(ax_[i], bx_[i], cx_[i], dx_[i], t);
+      out[k].y = horner(ay_[i], by_[i], cy_[i], dy_[i], t);
+    }
+  }
+
+  /** Evaluates positions and tangent-derived yaw angles at many parameters.
+   *  @param params The parameters.
+   *  @param out Receives one state per parameter. Must hold at least @c params.size() states.
+   */
+  void states(span<const double> params, span<state_se2> out) const {
+    assert(out.size() >= params.size());
+    for (std::size_t k = 0; k < params.size(); ++k) {
+      const auto [i, t] = locate(params[k]);
+      out[k].x = horner(ax_[i], bx_[i], cx_[i], dx_[i], t);
+      out[k].y = horner(ay_[i], by_[i], cy_[i], dy_[i], t);
+      out[k].yaw = std::atan2(first_derivative(by_[i], cy_[i], dy_[i], t),
+                              first_derivative(bx_[i], cx_[i], dx_[i], t));
+    }
+  }
+
+  /** Evaluates signed curvatures at many parameters.
+   *  @param params The parameters.
+   *  @param out Receives one curvature per parameter. Must hold at least @c params.size()
+   *         values.
+   */
+  void curvatures(span<const double> params, span<double> out) const {
+    assert(out.size() >= params.size());
+    for (std::size_t k = 0; k < params.size(); ++k) {
+      const auto [i, t] = locate(params[k]);
+      out[k] = curvature_at(i, t);
+    }
+  }
+
+private:
+  /// A segment index and the local parameter within that segment.
+  struct location {
+    std::size_t segment;
+    double t;
+  };
+
+  [[__nodiscard__]] location locate(double s) const {
+    const double last = static_cast<double>(segment_count() - 1);
+    // NaN fails both comparisons and selects the first segment, the result is NaN then.
+    const double clamped = s > last ? last : (s >= 0.0 ? std::floor(s) : 0.0);
+    return {static_cast<std::size_t>(clamped), s - clamped};
+  }
+
+  static double horner(double a, double b, double c, double d, double t) {
+    return a + t * (b + t * (c + t * d));
+  }
+
+  static double first_derivative(double b, double c, double d, double t) {
+    return b + t * (2.0 * c + t * 3.0 * d);
+  }
+
+  static double second_derivative(double c, double d, double t) {
+    return 2.0 * c + 6.0 * d * t;
+  }
+
+  [[__nodiscard__]] double curvature_at(std::size_t i, double t) const {
+    const double x1 = first_derivative(bx_[i], cx_[i], dx_[i], t);
+    const double y1 = first_derivative(by_[i], cy_[i], dy_[i], t);
+    const double x2 = second_derivative(cx_[i], dx_[i], t);
+    const double y2 = second_derivative(cy_[i], dy_[i], t);
+    const double speed_sq = x1 * x1 + y1 * y1;
+    if (speed_sq <= 0.0) {
+      return 0.0;
+    }
+    return (x1 * y2 - y1 * x2) / (speed_sq * std::sqrt(speed_sq));
+  }
+
+  /** Fits the natural or clamped C2 spline.
+   *
+   *  Solves for the second derivatives M_i with respect to the chord length parameter u using
+   *  the Thomas algorithm. Both components share the same matrix, so the elimination is done
+   *  once for both right-hand sides. Segment polynomials are then rescaled to t = u / h.
+   */
+  template <typename TState>
+  void fit_interpolating(span<const TState> states) {
+    const std::size_t n = states.size();
+    const std::size_t segments = n - 1;
+    std::vector<double> h(segments);
+    for (std::size_t i = 0; i < segments; ++i) {
+      h[i] = std::hypot(states[i + 1].x - states[i].x, states[i + 1].y - states[i].y);
+    }
+    const auto slope_x = [&](std::size_t i) { return (states[i + 1].x - states[i].x) / h[i]; };
+    const auto slope_y = [&](std::size_t i) { return (states[i + 1].y - states[i].y) / h[i]; };
+
+    // Tridiagonal system: lower[i] M[i-1] + diag[i] M[i] + upper[i] M[i+1] = rhs[i]
+    std::vector<double> lower(n, 0.0);
+    std::vector<double> diag(n, 1.0);
+    std::vector<double> upper(n, 0.0);
+    std::vector<double> mx(n, 0.0);
+    std::vector<double> my(n, 0.0);
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+      lower[i] = h[i - 1];
+      diag[i] = 2.0 * (h[i - 1] + h[i]);
+      upper[i] = h[i];
+      mx[i] = 6.0 * (slope_x(i) - slope_x(i - 1));
+      my[i] = 6.0 * (slope_y(i) - slope_y(i - 1));
+    }
+    if (type_ == spline_type::clamped) {
+      const auto [start_x, start_y] = end_tangent(states, 0);
+      const auto [end_x, end_y] = end_tangent(states, segments);
+      diag[0] = 2.0 * h[0];
+      upper[0] = h[0];
+      mx[0] = 6.0 * (slope_x(0) - start_x);
+      my[0] = 6.0 * (slope_y(0) - start_y);
+      lower[n - 1] = h[segments - 1];
+      diag[n - 1] = 2.0 * h[segments - 1];
+      mx[n - 1] = 6.0 * (end_x - slope_x(segments - 1));
+      my[n - 1] = 6.0 * (end_y - slope_y(segments - 1));
+    }
+    // natural: first and last rows stay M = 0
+
+    // Thomas algorithm, forward sweep
+    for (std::size_t i = 1; i < n; ++i) {
+      const double factor = lower[i] / diag[i - 1];
+      diag[i] -= factor * upper[i - 1];
+      mx[i] -= factor * mx[i - 1];
+      my[i] -= factor * my[i - 1];
+    }
+    // back substitution
+    mx[n - 1] /= diag[n - 1];
+    my[n - 1] /= diag[n - 1];
+    for (std::size_t i = n - 1; i-- > 0;) {
+      mx[i] = (mx[i] - upper[i] * mx[i + 1]) / diag[i];
+      my[i] = (my[i] - upper[i] * my[i + 1]) / diag[i];
+    }
+
+    for (std::size_t i = 0; i < segments; ++i) {
+      const double hi = h[i];
+      ax_[i] = states[i].x;
+      bx_[i] = (slope_x(i) - hi * (2.0 * mx[i] + mx[i + 1]) / 6.0) * hi;
+      cx_[i] = 0.5 * mx[i] * hi * hi;
+      dx_[i] = (mx[i + 1] - mx[i]) / 6.0 * hi * hi;
+      ay_[i] = states[i].y;
+      by_[i] = (slope_y(i) - hi * (2.0 * my[i] + my[i + 1]) / 6.0) * hi;
+      cy_[i] = 0.5 * my[i] * hi * hi;
+      dy_[i] = (my[i + 1] - my[i]) / 6.0 * hi * hi;
+    }
+  }
+
+  /// Unit tangent at the first or last state for the clamped spline.
+  template <typename TState>
+  static state_r2 end_tangent(span<const TState> states, std::size_t index) {
+    if constexpr (has_yaw_v<TState>) {
+      return {std::cos(states[index].yaw), std::sin(states[index].yaw)};
+    } else {
+      const TState& a = states[index == 0 ? 0 : index - 1];
+      const TState& b = states[index == 0 ? 1 : index];
+      const double length = std::hypot(b.x - a.x, b.y - a.y);
+      return {(b.x - a.x) / length, (b.y - a.y) / length};
+    }
+  }
+
+  /** Fits a Catmull-Rom spline with knot exponent @p alpha (0 uniform, 0.5 centripetal).
+   *
+   *  The tangents follow the non-uniform formulation by Barry and Goldman, scaled to the
+   *  local parameter of each segment. Missing neighbors at the ends are mirrored.
+   */
+  template <typename TState>
+  void fit_catmull_rom(span<const TState> states, double alpha) {
+    const std::size_t n = states.size();
+    const auto point = [&](std::size_t i) { return state_r2{states[i].x, states[i].y}; };
+    const auto knot_distance = [alpha](const state_r2& a, const state_r2& b) {
+      const double distance = std::pow(std::hypot(b.x - a.x, b.y - a.y), alpha);
+      return distance > 1e-12 ? distance : 1e-12;
+    };
+
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+      const state_r2 p1 = point(i);
+      const state_r2 p2 = point(i + 1);
+      const state_r2 p0 = i > 0 ? point(i - 1) : state_r2{2.0 * p1.x - p2.x, 2.0 * p1.y - p2.y};
+      const state_r2 p3 =
+          i + 2 < n ? point(i + 2) : state_r2{2.0 * p2.x - p1.x, 2.0 * p2.y - p1.y};
+
+      const double t01 = knot_distance(p0, p1);
+      const double t12 = knot_distance(p1, p2);
+      const double t23 = knot_distance(p2, p3);
+      const auto tangent = [t12](double q0, double q1, double q2, double d01, double d12) {
+        return t12 * ((q1 - q0) / d01 - (q2 - q0) / (d01 + d12) + (q2 - q1) / d12);
+      };
+      const double m1x = tangent(p0.x, p1.x, p2.x, t01, t12);
+      const double m1y = tangent(p0.y, p1.y, p2.y, t01, t12);
+      const double m2x = tangent(p1.x, p2.x, p3.x, t12, t23);
+      const double m2y = tangent(p1.y, p2.y, p3.y, t12, t23);
+
+      // Hermite form to monomial coefficients.
+      ax_[i] = p1.x;
+      bx_[i] = m1x;
+      cx_[i] = 3.0 * (p2.x - p1.x) - 2.0 * m1x - m2x;
+      dx_[i] = 2.0 * (p1.x - p2.x) + m1x + m2x;
+      ay_[i] = p1.y;
+      by_[i] = m1y;
+      cy_[i] = 3.0 * (p2.y - p1.y) - 2.0 * m1y - m2y;
+      dy_[i] = 2.0 * (p1.y - p2.y) + m1y + m2y;
+    }
+  }
+
+  /// The kind of spline.
+  spline_type type_;
+  /// Per segment polynomial coefficients x(t) = ax + bx t + cx t^2 + dx t^3.
+  std::vector<double> ax_, bx_, cx_, dx_;
+  /// Per segment polynomial coefficients y(t) = ay + by t + cy t^2 + dy t^3.
+  std::vector<double> ay_, by_, cy_, dy_;
+};
+
+} // namespace trailblaze
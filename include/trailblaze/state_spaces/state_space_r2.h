@@ -4,11 +4,13 @@
  * ------------------------------------------------------------------------- */
 #pragma once
 #include <cmath>
+#include <cstddef>
 #include <ostream>
 
 #include "trailblaze/interpolation_composition.h"
 #include "trailblaze/math/interpolation.h"
 #include "trailblaze/metrics/euclidean_distance.h"
+#include "trailblaze/span.h"
 
 namespace trailblaze {
 
@@ -31,6 +33,17 @@ struct interpolate_r2 {
     out.x = scalar_interpolator::linear(a.x, b.x, ratio);
     out.y = scalar_interpolator::linear(a.y, b.y, ratio);
   }
+
+  template <typename StateR2>
+  static void apply_batch(const StateR2& a, const StateR2& b, span<const double> ratios,
+                          span<StateR2> out) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      out[i].x = a.x + ratios[i] * dx;
+      out[i].y = a.y + ratios[i] * dy;
+    }
+  }
 };
 
 template <typename TState>
@@ -5,11 +5,14 @@
 #pragma once
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <ostream>
 
 #include "trailblaze/interpolation_composition.h"
 #include "trailblaze/math/interpolation.h"
+#include "trailblaze/math/angle.h"
 #include "trailblaze/metrics/euclidean_distance.h"
+#include "trailblaze/span.h"
 
 namespace trailblaze {
 
@@ -33,12 +36,47 @@ struct interpolate_position_se2 {
     out.x = scalar_interpolator::linear(a.x, b.x, ratio);
     out.y = scalar_interpolator::linear(a.y, b.y, ratio);
   }
+
+  static void apply_batch(const state_se2& a, const state_se2& b, span<const double> ratios,
+                          span<state_se2> out) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      out[i].x = a.x + ratios[i] * dx;
+      out[i].y = a.y + ratios[i] * dy;
+    }
+  }
 };
 
 struct interpolate_orientation_se2 {
   static void apply(const state_se2& a, const state_se2& b, double ratio, state_se2& out) {
     out.yaw = interpolate_angle_shortest(a.yaw, b.yaw, ratio);
   }
+
+  static void apply_batch(const state_se2& a, const state_se2& b, span<const double> ratios,
+                          span<state_se2> out) {
+    // The shortest difference is shared by all ratios of the segment.
+    const double start = normalized(a.yaw);
+    const double dist = normalized(b.yaw - a.yaw);
+
+    // For ratios in [0, 1] the result is at most one turn off the target range, which allows
+    // the cheap normalization that keeps the loop vectorizable.
+    double min_ratio = 0.0;
+    double max_ratio = 0.0;
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      min_ratio = std::min(min_ratio, ratios[i]);
+      max_ratio = std::max(max_ratio, ratios[i]);
+    }
+    if (min_ratio < 0.0 || max_ratio > 1.0) {
+      for (std::size_t i = 0; i < ratios.size(); ++i) {
+        out[i].yaw = normalized(start + ratios[i] * dist);
+      }
+      return;
+    }
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      out[i].yaw = normalized_near(start + ratios[i] * dist);
+    }
+  }
 };
 
 template <typename TState>
@@ -0,0 +1,186 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace trailblaze {
+
+/** A fixed set of worker threads that execute index ranges in parallel.
+ *
+ *  The pool runs one @ref parallel_for at a time. The calling thread takes part in the work,
+ *  so a pool of size 1 has no worker threads and runs everything inline. Submitting work
+ *  does not allocate.
+ *
+ *  @note @ref parallel_for must not be called from inside a body that is executed by the
+ *        same pool.
+ */
+class thread_pool {
+public:
+  /** Constructor
+   *  @param thread_count The number of threads that execute work, including the calling
+   *         thread. 0 selects @c std::thread::hardware_concurrency().
+   */
+  explicit thread_pool(std::size_t thread_count = 0) {
+    if (thread_count == 0) {
+      thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    workers_.reserve(thread_count - 1);
+    for (std::size_t i = 0; i + 1 < thread_count; ++i) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+  thread_pool(thread_pool&&) = delete;
+  thread_pool& operator=(thread_pool&&) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /// @returns the number of threads that execute work, including the calling thread.
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return workers_.size() + 1;
+  }
+
+  /** Calls @p body for consecutive chunks of [0, count) and blocks until all are done.
+   *
+   *  Chunks are handed out dynamically, so uneven work per index is balanced across threads.
+   *  If a call of @p body throws, the remaining chunks are skipped and the first exception
+   *  is rethrown in the calling thread.
+   *
+   *  @param count The number of indices.
+   *  @param grain The number of indices per chunk, values < 1 are treated as 1.
+   *  @param body Callable invoked as <tt>body(begin, end)</tt> for a half-open index range.
+   */
+  template <typename Body>
+  void parallel_for(std::size_t count, std::size_t grain, Body&& body) {
+    grain = std::max<std::size_t>(grain, 1);
+    if (count == 0) {
+      return;
+    }
+    if (workers_.empty() || count <= grain) {
+      body(std::size_t{0}, count);
+      return;
+    }
+
+    using body_type = std::remove_reference_t<Body>;
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_.invoke = [](void* context, std::size_t begin, std::size_t end) {
+        (*static_cast<body_type*>(context))(begin, end);
+      };
+      job_.context = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+      job_.count = count;
+      job_.grain = grain;
+      next_.store(0, std::memory_order_relaxed);
+      error_ = nullptr;
+      active_ = workers_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+private:
+  /// Type erased body of the current @ref parallel_for.
+  struct job {
+    void (*invoke)(void*, std::size_t, std::size_t){nullptr};
+    void* context{nullptr};
+    std::size_t count{0};
+    std::size_t grain{1};
+  };
+
+  void worker_loop() {
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+        if (stop_) {
+          return;
+        }
+        seen_generation = generation_;
+      }
+      run_chunks();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0) {
+          done_.notify_one();
+        }
+      }
+    }
+  }
+
+  void run_chunks() {
+    for (;;) {
+      const std::size_t begin = next_.fetch_add(job_.grain, std::memory_order_relaxed);
+      if (begin >= job_.count) {
+        return;
+      }
+      const std::size_t end = std::min(job_.count, begin + job_.grain);
+      try {
+        job_.invoke(job_.context, begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        next_.store(job_.count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Worker threads, the calling thread is not included.
+  std::vector<std::thread> workers_;
+  /// Serializes concurrent calls of @ref parallel_for.
+  std::mutex submit_mutex_;
+  /// Protects the job state below.
+  std::mutex mutex_;
+  /// Signals a new job or shutdown to the workers.
+  std::condition_variable wake_;
+  /// Signals that all workers finished the current job.
+  std::condition_variable done_;
+  /// The current job.
+  job job_;
+  /// Incremented for each job, workers compare it with the last job they executed.
+  std::uint64_t generation_{0};
+  /// Number of workers that have not finished the current job.
+  std::size_t active_{0};
+  /// Start index of the next chunk to hand out.
+  std::atomic<std::size_t> next_{0};
+  /// First exception thrown by the current job.
+  std::exception_ptr error_;
+  /// Set on destruction.
+  bool stop_{false};
+};
+
+} // namespace trailblaze
@@ -0,0 +1,310 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "trailblaze/path.h"
+#include "trailblaze/span.h"
+#include "trailblaze/state_space.h"
+#include "trailblaze/type_traits.h"
+
+namespace trailblaze {
+
+namespace detail {
+
+/** Finds the segment [times[i], times[i + 1]) that contains @p time.
+ *
+ *  The search first checks the segment at @p hint and its successor, which makes
+ *  monotonic query sequences O(1) per query, and falls back to a binary search otherwise.
+ *  Times before the first or after the last timestamp map to the first or last segment.
+ *
+ *  @param times Strictly increasing timestamps, at least two.
+ *  @param time The queried time.
+ *  @param hint Index of a segment that is likely to contain @p time.
+ *  @returns the segment index in [0, times.size() - 2].
+ */
+inline std::size_t find_time_segment(span<const double> times, double time, std::size_t hint) {
+  assert(times.size() >= 2);
+  const std::size_t last_segment = times.size() - 2;
+  if (hint > last_segment) {
+    hint = last_segment;
+  }
+  if (times[hint] <= time) {
+    if (time < times[hint + 1] || hint == last_segment) {
+      return hint;
+    }
+    if (hint + 1 == last_segment || time < times[hint + 2]) {
+      return hint + 1;
+    }
+  } else if (hint == 0) {
+    return 0;
+  }
+  const auto upper = std::upper_bound(times.begin(), times.end(), time);
+  if (upper == times.begin()) {
+    return 0;
+  }
+  const auto index = static_cast<std::size_t>(upper - times.begin()) - 1;
+  return std::min(index, last_segment);
+}
+
+struct trajectory_access;
+
+} // namespace detail
+
+/** A trajectory is a path whose states are annotated with timestamps.
+ *
+ *  The states are kept in a @ref path and the timestamps in a separate column, so that the
+ *  geometric part can be passed to all path algorithms unchanged. Timestamps are strictly
+ *  increasing.
+ *
+ *  @tparam TState The state type.
+ */
+template <typename TState>
+class trajectory {
+public:
+  using value_type = TState;
+
+  [[__nodiscard__]] std::size_t size() const noexcept {
+    return states_.size();
+  }
+
+  [[__nodiscard__]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  void reserve(std::size_t n) {
+    states_.reserve(n);
+    times_.reserve(n);
+  }
+
+  void clear() noexcept {
+    states_.clear();
+    times_.clear();
+  }
+
+  /** Appends a state.
+   *  @param time The timestamp of @p state.
+   *  @param state The state to append.
+   *  @throws std::invalid_argument if @p time is not greater than the last timestamp.
+   */
+  void push_back(double time, const TState& state) {
+    if (!times_.empty() && !(time > times_.back())) {
+      throw std::invalid_argument("timestamp " + std::to_string(time) +
+                                  " does not increase. Last timestamp is " +
+                                  std::to_string(times_.back()));
+    }
+    times_.push_back(time);
+    states_.push_back(state);
+  }
+
+  /** Changes a timestamp.
+   *  @param index The index of the state.
+   *  @param time The new timestamp of the state.
+   *  @throws std::out_of_range if @p index is out of range.
+   *  @throws std::invalid_argument if @p time is not between the neighboring timestamps.
+   */
+  void set_time(std::size_t index, double time) {
+    if (index >= size()) {
+      throw std::out_of_range("index " + std::to_string(index) + " is out of range");
+    }
+    const bool after_previous = index == 0 || time > times_[index - 1];
+    const bool before_next = index + 1 == size() || time < times_[index + 1];
+    if (!after_previous || !before_next) {
+      throw std::invalid_argument("timestamp " + std::to_string(time) + " of state " +
+                                  std::to_string(index) + " does not increase");
+    }
+    times_[index] = time;
+  }
+
+  /// @returns the timestamp column. Use @ref set_time to change it.
+  [[__nodiscard__]] span<const double> times() const noexcept {
+    return {times_.data(), times_.size()};
+  }
+
+  /// @returns the state column.
+  [[__nodiscard__]] span<TState> states() noexcept {
+    return states_.states();
+  }
+
+  [[__nodiscard__]] span<const TState> states() const noexcept {
+    return states_.states();
+  }
+
+  /// @returns the geometric part of the trajectory.
+  [[__nodiscard__]] const path<TState>& geometry() const noexcept {
+    return states_;
+  }
+
+  [[__nodiscard__]] double start_time() const {
+    assert(!empty());
+    return times_.front();
+  }
+
+  [[__nodiscard__]] double end_time() const {
+    assert(!empty());
+    return times_.back();
+  }
+
+  [[__nodiscard__]] double duration() const {
+    return empty() ? 0.0 : end_time() - start_time();
+  }
+
+  /** Looks up the state at an arbitrary time.
+   *
+   *  Times outside of [start_time(), end_time()] are clamped.
+   *
+   *  @param time The queried time.
+   *  @param hint In: a segment index that likely contains @p time, e.g. the one found by the
+   *         previous query. Out: the segment that contains @p time. Pass the same variable
+   *         to consecutive queries with increasing times to get O(1) lookups.
+   *  @param interpolator Interpolation functor, see @ref resample.
+   *  @returns the interpolated state.
+   */
+  template <typename TInterpolation = typename state_space<TState>::interpolation_type>
+  [[__nodiscard__]] TState state_at(double time, std::size_t& hint,
+                                    TInterpolation interpolator = TInterpolation{}) const {
+    assert(!empty());
+    if (size() == 1 || time <= times_.front()) {
+      hint = 0;
+      return states_.start();
+    }
+    if (time >= times_.back()) {
+      hint = size() - 2;
+      return states_.goal();
+    }
+    hint = detail::find_time_segment(times(), time, hint);
+    const double ratio = (time - times_[hint]) / (times_[hint + 1] - times_[hint]);
+    return interpolator(states_[hint], states_[hint + 1], ratio);
+  }
+
+  /// @see state_at(double, std::size_t&, TInterpolation) const
+  template <typename TInterpolation = typename state_space<TState>::interpolation_type>
+  [[__nodiscard__]] TState state_at(double time,
+                                    TInterpolation interpolator = TInterpolation{}) const {
+    std::size_t hint = 0;
+    return state_at(time, hint, interpolator);
+  }
+
+private:
+  friend struct detail::trajectory_access;
+
+  /// The states.
+  path<TState> states_;
+  /// The timestamp of each state.
+  std::vector<double> times_;
+};
+
+namespace detail {
+
+/// Unchecked access to the columns of a trajectory, for algorithms that fill them in place and
+/// restore the timestamp order before returning.
+struct trajectory_access {
+  template <typename TState>
+  static void resize(trajectory<TState>& target, std::size_t n) {
+    target.states_.resize(n);
+    target.times_.resize(n);
+  }
+
+  template <typename TState>
+  static span<double> times(trajectory<TState>& target) noexcept {
+    return {target.times_.data(), target.times_.size()};
+  }
+};
+
+} // namespace detail
+
+/** Resamples a trajectory at a fixed time step.
+ *
+ *  Samples are taken at @c start_time() + k * @p time_step for all k where that time does not
+ *  exceed @c end_time(). The end state is therefore only part of the result if the duration
+ *  is a multiple of @p time_step. Timestamps are computed from k directly, so they do not
+ *  accumulate rounding errors.
+ *
+ *  The output is allocated once. Consecutive samples are located with a monotonic walk over
+ *  the input segments, and all samples of one segment are interpolated together if the
+ *  interpolator supports batch calls (see @ref is_batch_interpolator_v).
+ *
+ *  @param input The trajectory to resample.
+ *  @param time_step The time between two samples. Must be > 0.
+ *  @param interpolator Interpolation functor, see @ref resample.
+ *  @returns the resampled trajectory.
+ *  @throws std::invalid_argument if @p time_step <= 0.
+ */
+template <typename TState,
+          typename TInterpolation = typename state_space<TState>::interpolation_type>
+trajectory<TState> resample_by_time(const trajectory<TState>& input, double time_step,
+                                    TInterpolation interpolator = TInterpolation{}) {
+  if (!(time_step > 0.0)) {
+    throw std::invalid_argument("time step must be greater than zero");
+  }
+  trajectory<TState> out;
+  if (input.empty()) {
+    return out;
+  }
+
+  // Small slack so that a duration that is a multiple of the time step keeps its end sample.
+  const double steps = input.duration() / time_step;
+  const auto count = static_cast<std::size_t>(std::floor(steps + 1e-9 * std::max(1.0, steps))) + 1;
+  detail::trajectory_access::resize(out, count);
+
+  const span<const double> in_times = input.times();
+  const span<const TState> in_states = input.states();
+  const span<double> out_times = detail::trajectory_access::times(out);
+  const span<TState> out_states = out.states();
+  const double start_time = input.start_time();
+
+  if (input.size() == 1) {
+    out_times[0] = start_time;
+    out_states[0] = in_states[0];
+    return out;
+  }
+
+  std::size_t sample = 0;
+  std::size_t segment = 0;
+  while (sample < count) {
+    const double time = start_time + static_cast<double>(sample) * time_step;
+    segment = detail::find_time_segment(in_times, time, segment);
+    const double segment_start = in_times[segment];
+    const double segment_end = in_times[segment + 1];
+    const double inverse_duration = 1.0 / (segment_end - segment_start);
+
+    // Collect all samples on this segment. Their ratios are staged in the timestamp column,
+    // which keeps the batch call free of extra allocations.
+    const std::size_t first = sample;
+    const bool last_segment = segment + 2 == in_times.size();
+    while (sample < count) {
+      const double sample_time = start_time + static_cast<double>(sample) * time_step;
+      if (!last_segment && sample_time >= segment_end) {
+        break;
+      }
+      out_times[sample] = std::min((sample_time - segment_start) * inverse_duration, 1.0);
+      ++sample;
+    }
+
+    const TState& a = in_states[segment];
+    const TState& b = in_states[segment + 1];
+    const std::size_t n = sample - first;
+    if constexpr (is_batch_interpolator_v<TInterpolation, TState>) {
+      interpolator(a, b, span<const double>(out_times.data() + first, n),
+                   span<TState>(out_states.data() + first, n));
+    } else {
+      for (std::size_t i = first; i < sample; ++i) {
+        out_states[i] = interpolator(a, b, out_times[i]);
+      }
+    }
+    for (std::size_t i = first; i < sample; ++i) {
+      out_times[i] = start_time + static_cast<double>(i) * time_step;
+    }
+  }
+  return out;
+}
+
+} // namespace trailblaze
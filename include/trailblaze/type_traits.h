@@ -14,4 +14,44 @@ namespace trailblaze {
 template <typename T>
 inline constexpr bool is_ostream_insertable_v = detail::is_ostream_insertable<T>::value;
 
+/** @brief Checks if an interpolator can interpolate many ratios on one segment at once.
+ *
+ *  Batch interpolators provide
+ *  @code
+ *   void operator()(const TState& a, const TState& b, span<const double> ratios,
+ *                   span<TState> out) const;
+ *  @endcode
+ *
+ *  @tparam TInterpolation The interpolator type.
+ *  @tparam TState The state type that is interpolated.
+ *  @returns @c true if the batch call operator is present, @c false otherwise.
+ */
+template <typename TInterpolation, typename TState>
+inline constexpr bool is_batch_interpolator_v =
+    detail::is_batch_interpolator<TInterpolation, TState>::value;
+
+/** @brief Checks if a parametric curve can be evaluated at many parameters at once.
+ *
+ *  Batch curves provide
+ *  @code
+ *   void operator()(span<const double> parameters, span<TState> out) const;
+ *  @endcode
+ *
+ *  @tparam Curve The curve type.
+ *  @tparam TState The state type that the curve produces.
+ *  @returns @c true if the batch call operator is present, @c false otherwise.
+ */
+template <typename Curve, typename TState>
+inline constexpr bool is_batch_curve_v = detail::is_batch_curve<Curve, TState>::value;
+
+/** @brief Checks if a type is a @ref span.
+ *
+ *  Used to tell span outputs apart from output iterators in overload sets.
+ *
+ *  @tparam T any type
+ *  @returns @c true if T is a span, @c false otherwise.
+ */
+template <typename T>
+inline constexpr bool is_span_v = detail::is_span<T>::value;
+
 } // namespace trailblaze
@@ -2,6 +2,11 @@
  * Copyright(c) 2024-present, Sebastian Klemm & contributors.
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
 // external
 #include <gtest/gtest.h>
 
@@ -17,6 +22,68 @@ TEST(Angle, DegToRadConversion) {
   EXPECT_DOUBLE_EQ(to_rad(180.), numbers::pi);
 }
 
+TEST(Angle, FastAtan2MaxError) {
+  double max_error = 0.0;
+  constexpr int steps = 20000;
+  for (int i = 0; i < steps; ++i) {
+    const double angle = -numbers::pi + numbers::two_pi * static_cast<double>(i) / steps;
+    for (const double radius : {1e-3, 1.0, 250.0}) {
+      const double y = radius * std::sin(angle);
+      const double x = radius * std::cos(angle);
+      max_error = std::max(max_error, std::fabs(fast_atan2(y, x) - std::atan2(y, x)));
+    }
+  }
+  EXPECT_LT(max_error, 1e-7);
+
+  EXPECT_EQ(fast_atan2(0.0, 0.0), 0.0);
+  EXPECT_EQ(fast_atan2(0.0, -1.0), -numbers::pi);
+  EXPECT_EQ(fast_atan2(-0.0, -1.0), -numbers::pi);
+  EXPECT_NEAR(fast_atan2(-1.0, 0.0), -numbers::pi_2, 1e-7);
+  EXPECT_NEAR(fast_atan2(1.0, 1.0), 0.25 * numbers::pi, 1e-7);
+}
+
+TEST(Angle, BatchSincosMatchesStd) {
+  std::vector<double> angles;
+  for (int i = -20000; i <= 20000; ++i) {
+    angles.push_back(0.37 * i);
+  }
+  angles.push_back(5e6); // beyond fast_sincos_range, falls back to std
+  std::vector<double> sines(angles.size());
+  std::vector<double> cosines(angles.size());
+  sincos(span<const double>(angles), span<double>(sines), span<double>(cosines));
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(sines[i], std::sin(angles[i]), 4e-16);
+    EXPECT_NEAR(cosines[i], std::cos(angles[i]), 4e-16);
+  }
+}
+
+TEST(Angle, BatchSincosOutOfRange) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<double> angles{1e12, -1e12, 1e300, inf, -inf, nan, 0.5};
+  std::vector<double> sines(angles.size());
+  std::vector<double> cosines(angles.size());
+  sincos(span<const double>(angles), span<double>(sines), span<double>(cosines));
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_DOUBLE_EQ(sines[i], std::sin(angles[i]));
+    EXPECT_DOUBLE_EQ(cosines[i], std::cos(angles[i]));
+  }
+  for (std::size_t i = 3; i < 6; ++i) {
+    EXPECT_TRUE(std::isnan(sines[i]));
+    EXPECT_TRUE(std::isnan(cosines[i]));
+  }
+  EXPECT_NEAR(sines[6], std::sin(0.5), 4e-16);
+
+  // The fast version is defined for these angles, its results are not specified.
+  double sine = 0.0;
+  double cosine = 0.0;
+  for (const double angle : angles) {
+    fast_sincos(angle, sine, cosine);
+  }
+  EXPECT_NEAR(sine, std::sin(0.5), 4e-16);
+  EXPECT_NEAR(cosine, std::cos(0.5), 4e-16);
+}
+
 // Fixture for parameterized normalization test
 class angle_normalization : public ::testing::TestWithParam<double> {};
 
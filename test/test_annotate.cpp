@@ -0,0 +1,191 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/algorithm/annotate.h"
+#include "trailblaze/math/numbers.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Input state with extra data that is not part of the annotation.
+struct test_state_point {
+  double x{0.};
+  double y{0.};
+  int label{0};
+};
+
+/// Output state that only stores an orientation.
+struct test_state_heading {
+  double yaw{0.};
+};
+
+/// State with position and yaw that is annotated in place.
+struct test_state_pose {
+  int id{0};
+  double x{0.};
+  double y{0.};
+  double yaw{0.};
+};
+
+std::vector<state_r2> random_walk(std::size_t n) {
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> step(-1.0, 1.0);
+  std::vector<state_r2> out(n);
+  for (std::size_t i = 1; i < n; ++i) {
+    out[i] = {out[i - 1].x + step(generator), out[i - 1].y + step(generator)};
+  }
+  return out;
+}
+
+} // namespace
+
+TEST(Annotate, YawChordIntoMatchesPathVariant) {
+  std::vector<state_r2> states = random_walk(1000);
+  // Heading of exactly Pi is reported as -Pi.
+  states[1] = {states[0].x - 1.0, states[0].y};
+  const path<state_se2> expected = annotate::yaw_chord(span<state_r2>(states));
+
+  std::vector<state_se2> exact(states.size());
+  std::vector<state_se2> fast(states.size());
+  annotate::yaw_chord(span<const state_r2>(states), span<state_se2>(exact));
+  annotate::yaw_chord(span<const state_r2>(states), span<state_se2>(fast),
+                      annotate::yaw_precision::fast);
+  EXPECT_EQ(exact[0].yaw, -numbers::pi);
+  EXPECT_EQ(fast[0].yaw, -numbers::pi);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    EXPECT_EQ(exact[i].x, states[i].x);
+    EXPECT_EQ(exact[i].y, states[i].y);
+    EXPECT_NEAR(exact[i].yaw, expected[i].yaw, 1e-15);
+    EXPECT_NEAR(fast[i].yaw, expected[i].yaw, 1e-7);
+    EXPECT_GE(fast[i].yaw, -numbers::pi);
+    EXPECT_LT(fast[i].yaw, numbers::pi);
+  }
+}
+
+TEST(Annotate, YawCenteredDiffIntoMatchesPathVariant) {
+  const std::vector<state_r2> states = random_walk(1000);
+  std::vector<state_r2> mutable_states = states;
+  const path<state_se2> expected = annotate::yaw_centered_diff(span<state_r2>(mutable_states));
+
+  std::vector<state_se2> exact(states.size());
+  std::vector<state_se2> fast(states.size());
+  annotate::yaw_centered_diff(span<const state_r2>(states), span<state_se2>(exact));
+  annotate::yaw_centered_diff(span<const state_r2>(states), span<state_se2>(fast),
+                              annotate::yaw_precision::fast);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    EXPECT_NEAR(exact[i].yaw, expected[i].yaw, 1e-15);
+    EXPECT_NEAR(fast[i].yaw, expected[i].yaw, 1e-7);
+  }
+}
+
+TEST(Annotate, YawIntoShortInputs) {
+  const std::vector<state_r2> single{{2.0, 3.0}};
+  std::vector<state_se2> out(1);
+  annotate::yaw_chord(span<const state_r2>(single), span<state_se2>(out));
+  EXPECT_EQ(out[0].x, 2.0);
+  EXPECT_EQ(out[0].yaw, 0.0);
+  annotate::yaw_centered_diff(span<const state_r2>(single), span<state_se2>(out));
+  EXPECT_EQ(out[0].yaw, 0.0);
+
+  const std::vector<state_r2> pair{{0.0, 0.0}, {0.0, 1.0}};
+  std::vector<state_se2> out_pair(2);
+  annotate::yaw_centered_diff(span<const state_r2>(pair), span<state_se2>(out_pair),
+                              annotate::yaw_precision::fast);
+  EXPECT_NEAR(out_pair[0].yaw, numbers::pi_2, 1e-7);
+  EXPECT_NEAR(out_pair[1].yaw, numbers::pi_2, 1e-7);
+}
+
+TEST(Annotate, GenericInputAndOutputTypes) {
+  const std::vector<state_r2> walk = random_walk(200);
+  std::vector<test_state_point> points(walk.size());
+  std::vector<test_state_pose> poses(walk.size());
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    points[i] = {walk[i].x, walk[i].y, static_cast<int>(i)};
+    poses[i] = {static_cast<int>(i), walk[i].x, walk[i].y, 100.0};
+  }
+  std::vector<state_r2> mutable_walk = walk;
+  const path<state_se2> chord = annotate::yaw_chord(span<state_r2>(mutable_walk));
+  const path<state_se2> centered = annotate::yaw_centered_diff(span<state_r2>(mutable_walk));
+
+  std::vector<test_state_heading> headings(points.size());
+  annotate::yaw_chord(span<const test_state_point>(points), span<test_state_heading>(headings));
+  std::vector<state_se2> se2(points.size());
+  annotate::yaw_centered_diff(span<test_state_point>(points), span<state_se2>(se2));
+
+  annotate::yaw_chord_in_place(span<test_state_pose>(poses));
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    EXPECT_EQ(headings[i].yaw, chord[i].yaw);
+    EXPECT_EQ(se2[i].x, walk[i].x);
+    EXPECT_EQ(se2[i].yaw, centered[i].yaw);
+    EXPECT_EQ(poses[i].id, static_cast<int>(i));
+    EXPECT_EQ(poses[i].x, walk[i].x);
+    EXPECT_EQ(poses[i].yaw, chord[i].yaw);
+  }
+
+  annotate::yaw_centered_diff_in_place(span<test_state_pose>(poses),
+                                       annotate::yaw_precision::fast);
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    EXPECT_NEAR(poses[i].yaw, centered[i].yaw, 1e-7);
+  }
+}
+
+TEST(Annotate, OutputIteratorVariants) {
+  std::vector<state_r2> walk = random_walk(100);
+  const path<state_se2> chord = annotate::yaw_chord(span<state_r2>(walk));
+  const path<state_se2> centered = annotate::yaw_centered_diff(span<state_r2>(walk));
+  const path<state_se2> lerp = annotate::yaw_lerp(span<state_r2>(walk), 3.0, -3.0);
+  const path<state_se2> constant = annotate::yaw_constant(span<state_r2>(walk), 7.0);
+
+  std::vector<state_se2> chord_out;
+  annotate::yaw_chord(span<const state_r2>(walk), std::back_inserter(chord_out));
+  std::vector<state_se2> centered_out;
+  annotate::yaw_centered_diff(span<const state_r2>(walk), std::back_inserter(centered_out));
+  std::vector<test_state_pose> lerp_out;
+  annotate::yaw_lerp<test_state_pose>(span<const state_r2>(walk), std::back_inserter(lerp_out),
+                                      3.0, -3.0);
+  std::vector<test_state_heading> constant_out;
+  annotate::yaw_constant<test_state_heading>(span<const state_r2>(walk),
+                                             std::back_inserter(constant_out), 7.0);
+
+  ASSERT_EQ(chord_out.size(), walk.size());
+  ASSERT_EQ(centered_out.size(), walk.size());
+  ASSERT_EQ(lerp_out.size(), walk.size());
+  ASSERT_EQ(constant_out.size(), walk.size());
+  for (std::size_t i = 0; i < walk.size(); ++i) {
+    EXPECT_EQ(chord_out[i].x, walk[i].x);
+    EXPECT_EQ(chord_out[i].yaw, chord[i].yaw);
+    EXPECT_EQ(centered_out[i].yaw, centered[i].yaw);
+    EXPECT_EQ(lerp_out[i].y, walk[i].y);
+    EXPECT_EQ(lerp_out[i].yaw, lerp[i].yaw);
+    EXPECT_EQ(constant_out[i].yaw, constant[i].yaw);
+  }
+}
+
+TEST(Annotate, LerpAndConstantInPlace) {
+  std::vector<state_se2> states(5);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    states[i] = {static_cast<double>(i), 0.0, 0.0};
+  }
+  annotate::yaw_lerp_in_place(span<state_se2>(states), 0.0, 2.0);
+  EXPECT_DOUBLE_EQ(states[0].yaw, 0.0);
+  EXPECT_DOUBLE_EQ(states[2].yaw, 1.0);
+  EXPECT_DOUBLE_EQ(states[4].yaw, 2.0);
+  EXPECT_EQ(states[3].x, 3.0);
+
+  annotate::yaw_constant_in_place(span<state_se2>(states), numbers::pi + 0.5);
+  for (const auto& state : states) {
+    EXPECT_NEAR(state.yaw, -numbers::pi + 0.5, 1e-12);
+  }
+}
+
+} // namespace trailblaze
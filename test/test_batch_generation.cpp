@@ -0,0 +1,138 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/generate/batch.h"
+#include "trailblaze/ragged_buffer.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Quadratic Bezier curve from the origin to @c end with a control point.
+struct bezier {
+  state_r2 control;
+  state_r2 end;
+
+  state_r2 operator()(double t) const {
+    const double u = 1.0 - t;
+    return {2.0 * u * t * control.x + t * t * end.x, 2.0 * u * t * control.y + t * t * end.y};
+  }
+};
+
+std::vector<gen::parametric_candidate<bezier>> make_candidates(std::size_t count) {
+  std::vector<gen::parametric_candidate<bezier>> candidates;
+  for (std::size_t i = 0; i < count; ++i) {
+    const double d = static_cast<double>(i);
+    candidates.push_back({bezier{{1.0, 0.1 * d}, {2.0, 0.2 * d}},
+                          interval<double>{0.0, 1.0},
+                          sampling::by_count{2 + i % 7}});
+  }
+  return candidates;
+}
+
+} // namespace
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+  for (const std::size_t thread_count : {std::size_t(1), std::size_t(4)}) {
+    thread_pool pool(thread_count);
+    EXPECT_EQ(pool.size(), thread_count);
+    for (const std::size_t count : {std::size_t(0), std::size_t(5), std::size_t(1003)}) {
+      std::vector<std::atomic<int>> visits(count);
+      pool.parallel_for(count, 8, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          visits[i].fetch_add(1);
+        }
+      });
+      for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(visits[i].load(), 1) << "index " << i;
+      }
+    }
+  }
+}
+
+TEST(ThreadPool, ParallelForRethrowsExceptions) {
+  thread_pool pool(3);
+  EXPECT_THROW(pool.parallel_for(100, 1,
+                                 [](std::size_t begin, std::size_t) {
+                                   if (begin == 42) {
+                                     throw std::runtime_error("failure");
+                                   }
+                                 }),
+               std::runtime_error);
+  // The pool stays usable.
+  std::atomic<std::size_t> sum{0};
+  pool.parallel_for(100, 1, [&](std::size_t begin, std::size_t) { sum += begin; });
+  EXPECT_EQ(sum.load(), 4950u);
+}
+
+TEST(RaggedBuffer, ReshapeAndPushBack) {
+  ragged_buffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+  buffer.reshape(3, [](std::size_t i) { return i + 1; });
+  ASSERT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer.element_count(), 6u);
+  EXPECT_EQ(buffer[2].size(), 3u);
+  buffer[1][1] = 7;
+  EXPECT_EQ(buffer.data()[2], 7);
+
+  const std::vector<int> row{1, 2};
+  buffer.push_back(span<const int>(row));
+  ASSERT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(buffer.offsets()[4], 8u);
+  EXPECT_EQ(buffer[3][1], 2);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.element_count(), 0u);
+}
+
+TEST(GenerateBatch, MatchesSingleCandidateGeneration) {
+  const auto candidates = make_candidates(500);
+  const span<const gen::parametric_candidate<bezier>> params(candidates);
+
+  ragged_buffer<state_r2> serial;
+  gen::generate_batch(gen::parametric_generator{}, params, serial);
+  thread_pool pool(4);
+  ragged_buffer<state_r2> parallel;
+  gen::generate_batch(pool, gen::parametric_generator{}, params, parallel, 7);
+
+  ASSERT_EQ(serial.size(), candidates.size());
+  ASSERT_EQ(parallel.size(), candidates.size());
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    const auto expected = gen::sample_parametric_curve_r2(candidates[i].curve, candidates[i].range,
+                                                          1.0, candidates[i].sampling);
+    ASSERT_EQ(serial[i].size(), expected.size());
+    ASSERT_EQ(parallel[i].size(), expected.size());
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+      EXPECT_EQ(serial[i][k].x, expected[k].x);
+      EXPECT_EQ(serial[i][k].y, expected[k].y);
+      EXPECT_EQ(parallel[i][k].x, expected[k].x);
+      EXPECT_EQ(parallel[i][k].y, expected[k].y);
+    }
+  }
+}
+
+TEST(GenerateBatch, ReusedBufferKeepsItsStorage) {
+  const auto candidates = make_candidates(200);
+  thread_pool pool(2);
+  ragged_buffer<state_r2> out;
+  gen::generate_batch(pool, gen::parametric_generator{},
+                      span<const gen::parametric_candidate<bezier>>(candidates), out);
+  const state_r2* storage = out.data().data();
+  gen::generate_batch(pool, gen::parametric_generator{},
+                      span<const gen::parametric_candidate<bezier>>(candidates.data(), 100), out);
+  EXPECT_EQ(out.size(), 100u);
+  EXPECT_EQ(out.data().data(), storage);
+}
+
+} // namespace trailblaze
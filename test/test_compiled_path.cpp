@@ -0,0 +1,139 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/compiled_path.h"
+#include "trailblaze/math/interpolation.h"
+#include "trailblaze/path.h"
+#include "trailblaze/quaternion.h"
+#include "trailblaze/state_space.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// A state with a quaternion rotation and an extra component that is not interpolated.
+struct test_state_pose {
+  double x{0.};
+  double y{0.};
+  double z{0.};
+  quaternion rotation;
+  int label{0};
+};
+
+/// A state whose state space eases in along y.
+struct test_state_ease {
+  double x{0.};
+  double y{0.};
+};
+
+struct interpolate_ease {
+  test_state_ease operator()(const test_state_ease& a, const test_state_ease& b,
+                             double ratio) const {
+    return {a.x + ratio * (b.x - a.x), a.y + ratio * ratio * (b.y - a.y)};
+  }
+};
+
+} // namespace
+
+template <>
+struct state_space<test_state_ease> {
+  using interpolation_type = interpolate_ease;
+};
+
+TEST(CompiledPath, MatchesStateSpaceInterpolation) {
+  path<state_se2> input;
+  input.push_back({0., 0., 3.});
+  input.push_back({1., 2., -3.});
+  input.push_back({4., 2., 1.});
+  input.push_back({4., -1., 30.});
+  const compiled_path<state_se2> compiled(input);
+  ASSERT_EQ(compiled.segment_count(), 3u);
+
+  typename state_space<state_se2>::interpolation_type interpolation;
+  std::vector<double> params;
+  for (double s = -0.5; s <= 3.5; s += 0.125) {
+    params.push_back(s);
+  }
+  std::vector<state_se2> batch(params.size());
+  compiled.evaluate(span<const double>(params), span<state_se2>(batch));
+
+  for (std::size_t k = 0; k < params.size(); ++k) {
+    const double s = params[k];
+    const std::size_t segment = s < 0.0 ? 0 : (s >= 3.0 ? 2 : static_cast<std::size_t>(s));
+    const double t = s - static_cast<double>(segment);
+    const state_se2 expected = interpolation(input[segment], input[segment + 1], t);
+    for (const state_se2& result : {compiled.evaluate(s), batch[k]}) {
+      EXPECT_NEAR(result.x, expected.x, 1e-12);
+      EXPECT_NEAR(result.y, expected.y, 1e-12);
+      EXPECT_NEAR(result.yaw, expected.yaw, 1e-12);
+    }
+  }
+}
+
+TEST(CompiledPath, InterpolatesQuaternionAndKeepsOtherComponents) {
+  std::vector<test_state_pose> input(2);
+  input[0] = {0., 0., 0., normalized(quaternion{0.1, 0.2, 0.3, 0.9}), 1};
+  input[1] = {2., 4., 6., normalized(quaternion{-0.4, 0.1, 0.8, 0.2}), 2};
+  const compiled_path<test_state_pose> compiled{span<const test_state_pose>(input)};
+
+  const test_state_pose result = compiled.evaluate(0, 0.25);
+  EXPECT_DOUBLE_EQ(result.z, 1.5);
+  EXPECT_EQ(result.label, 2);
+  const quaternion expected = interpolate_quaternion(input[0].rotation, input[1].rotation, 0.25);
+  EXPECT_NEAR(result.rotation.x, expected.x, 1e-12);
+  EXPECT_NEAR(result.rotation.w, expected.w, 1e-12);
+}
+
+TEST(CompiledPath, UsesOtherStateSpaceInterpolation) {
+  const std::vector<test_state_ease> input{{0., 0.}, {1., 2.}, {3., 4.}};
+  const compiled_path<test_state_ease> compiled{span<const test_state_ease>(input)};
+  ASSERT_EQ(compiled.segment_count(), 2u);
+
+  const std::vector<double> params{0.5, 1.25, 2.0};
+  std::vector<test_state_ease> batch(params.size());
+  compiled.evaluate(span<const double>(params), span<test_state_ease>(batch));
+  for (std::size_t k = 0; k < params.size(); ++k) {
+    const std::size_t segment = params[k] < 2.0 ? static_cast<std::size_t>(params[k]) : 1;
+    const double t = params[k] - static_cast<double>(segment);
+    const test_state_ease expected = interpolate_ease{}(input[segment], input[segment + 1], t);
+    for (const test_state_ease& result : {compiled.evaluate(params[k]), batch[k]}) {
+      EXPECT_DOUBLE_EQ(result.x, expected.x);
+      EXPECT_DOUBLE_EQ(result.y, expected.y);
+    }
+  }
+  EXPECT_DOUBLE_EQ(compiled.evaluate(0, 0.5).y, 0.5);
+}
+
+TEST(CompiledPath, NotANumberParameter) {
+  path<state_se2> input;
+  input.push_back({0., 0., 0.});
+  input.push_back({1., 2., 1.});
+  input.push_back({4., 2., 2.});
+  const compiled_path<state_se2> compiled(input);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const state_se2 state = compiled.evaluate(nan);
+  EXPECT_TRUE(std::isnan(state.x));
+  EXPECT_TRUE(std::isnan(state.yaw));
+
+  const std::vector<double> params{nan, 1.5};
+  std::vector<state_se2> batch(params.size());
+  compiled.evaluate(span<const double>(params), span<state_se2>(batch));
+  EXPECT_TRUE(std::isnan(batch[0].y));
+  EXPECT_DOUBLE_EQ(batch[1].x, 2.5);
+
+  const std::vector<test_state_ease> eased{{0., 0.}, {1., 2.}};
+  const compiled_path<test_state_ease> other{span<const test_state_ease>(eased)};
+  EXPECT_TRUE(std::isnan(other.evaluate(nan).x));
+}
+
+} // namespace trailblaze
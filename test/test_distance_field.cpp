@@ -0,0 +1,116 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/path.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze {
+
+namespace {
+
+env::bit_occupancy_grid random_grid(std::size_t width, std::size_t height, double density,
+                                    unsigned seed) {
+  env::bit_occupancy_grid grid(width, height, 0.5, {-3.0, 1.0});
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution occupied(density);
+  for (std::size_t y = 0; y < height; ++y) {
+    for (std::size_t x = 0; x < width; ++x) {
+      if (occupied(rng)) {
+        grid.set({static_cast<std::int64_t>(x), static_cast<std::int64_t>(y)}, true);
+      }
+    }
+  }
+  return grid;
+}
+
+double brute_force_distance(const env::bit_occupancy_grid& grid, std::int64_t x,
+                            std::int64_t y) {
+  double best = std::numeric_limits<double>::infinity();
+  for (std::int64_t oy = 0; oy < static_cast<std::int64_t>(grid.height()); ++oy) {
+    for (std::int64_t ox = 0; ox < static_cast<std::int64_t>(grid.width()); ++ox) {
+      if (grid.value({ox, oy})) {
+        best = std::min(best, std::hypot(double(ox - x), double(oy - y)) * grid.resolution());
+      }
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+TEST(DistanceField, MatchesBruteForce) {
+  thread_pool pool(3);
+  for (const double density : {0.002, 0.05, 0.4}) {
+    const auto grid = random_grid(97, 41, density, 11);
+    const env::distance_field serial(grid);
+    const env::distance_field parallel(grid, pool);
+    for (std::int64_t y = 0; y < 41; ++y) {
+      for (std::int64_t x = 0; x < 97; ++x) {
+        const double expected = brute_force_distance(grid, x, y);
+        ASSERT_NEAR(serial.distance({x, y}), expected, 1e-4) << x << ", " << y;
+        ASSERT_EQ(parallel.distance({x, y}), serial.distance({x, y}));
+      }
+    }
+  }
+}
+
+TEST(DistanceField, BilinearClearance) {
+  env::bit_occupancy_grid grid(10, 10, 0.5, {-3.0, 1.0});
+  grid.set({2, 5}, true);
+  const env::distance_field field(grid);
+  EXPECT_EQ(field.distance({2, 5}), 0.0);
+  EXPECT_DOUBLE_EQ(field.distance({5, 5}), 1.5);
+
+  // Cell centers reproduce the cell distances.
+  const state_r2 center = grid.cell_center({5, 5});
+  EXPECT_NEAR(field.clearance(center.x, center.y), 1.5, 1e-6);
+  // Halfway between two centers along x.
+  EXPECT_NEAR(field.clearance(center.x + 0.25, center.y),
+              0.5 * (field.distance({5, 5}) + field.distance({6, 5})), 1e-6);
+  // Outside of the grid.
+  EXPECT_EQ(field.clearance(-3.1, 2.0), 0.0);
+  EXPECT_EQ(field.distance({10, 0}), 0.0);
+
+  path<state_r2> states;
+  states.push_back(center);
+  states.push_back(grid.cell_center({2, 5}));
+  std::vector<double> clearances(states.size());
+  field.clearance(states, span<double>(clearances));
+  EXPECT_NEAR(clearances[0], 1.5, 1e-6);
+  EXPECT_NEAR(clearances[1], 0.0, 1e-6);
+}
+
+TEST(DistanceField, MinClearanceStopsEarly) {
+  env::bit_occupancy_grid grid(20, 20, 1.0);
+  grid.set({10, 10}, true);
+  const env::distance_field field(grid);
+
+  path<state_r2> states;
+  for (int i = 0; i < 10; ++i) {
+    states.push_back({0.5 + i, 10.5});
+  }
+  EXPECT_NEAR(env::min_clearance(field, states), 1.0, 1e-9);
+  // Stops at the first state with clearance <= 5 (state 5, clearance 5).
+  EXPECT_NEAR(env::min_clearance(field, states, 5.0), 5.0, 1e-9);
+  EXPECT_EQ(env::min_clearance(field, path<state_r2>{}), std::numeric_limits<double>::infinity());
+}
+
+TEST(DistanceField, EmptyGridIsInfinitelyFar) {
+  const env::byte_occupancy_grid grid(16, 8, 0.1);
+  const env::distance_field field(grid);
+  EXPECT_EQ(field.distance({3, 3}), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(field.clearance(0.55, 0.35), std::numeric_limits<double>::infinity());
+}
+
+} // namespace trailblaze
@@ -0,0 +1,133 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/environment/dynamic_distance_field.h"
+
+namespace trailblaze {
+
+namespace {
+
+void expect_same_distances(const env::dynamic_distance_field& dynamic,
+                           const env::bit_occupancy_grid& grid) {
+  const env::distance_field expected(grid);
+  for (std::int64_t y = 0; y < static_cast<std::int64_t>(grid.height()); ++y) {
+    for (std::int64_t x = 0; x < static_cast<std::int64_t>(grid.width()); ++x) {
+      ASSERT_FLOAT_EQ(static_cast<float>(dynamic.distance({x, y})),
+                      static_cast<float>(expected.distance({x, y})))
+          << x << ", " << y;
+    }
+  }
+}
+
+} // namespace
+
+TEST(DynamicDistanceField, RandomUpdatesMatchFullRecompute) {
+  constexpr std::int64_t width = 61;
+  constexpr std::int64_t height = 47;
+  env::bit_occupancy_grid grid(width, height, 0.1, {2.0, -1.0});
+  env::dynamic_distance_field dynamic(width, height, 0.1, {2.0, -1.0});
+  EXPECT_EQ(dynamic.distance({3, 3}), std::numeric_limits<double>::infinity());
+
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<std::int64_t> column(0, width - 1);
+  std::uniform_int_distribution<std::int64_t> row(0, height - 1);
+  for (int step = 0; step < 40; ++step) {
+    std::vector<env::cell_index> set;
+    std::vector<env::cell_index> cleared;
+    for (int i = 0; i < 12; ++i) {
+      const env::cell_index cell{column(rng), row(rng)};
+      // Mostly adds obstacles early and mostly removes them later.
+      if ((step < 20) == (i % 4 != 0)) {
+        set.push_back(cell);
+      } else {
+        cleared.push_back(cell);
+      }
+    }
+    for (const auto& cell : set) {
+      grid.set(cell, true);
+    }
+    for (const auto& cell : cleared) {
+      grid.set(cell, false);
+    }
+    dynamic.update(span<const env::cell_index>(set), span<const env::cell_index>(cleared));
+    expect_same_distances(dynamic, grid);
+    if (HasFatalFailure()) {
+      return;
+    }
+  }
+}
+
+TEST(DynamicDistanceField, InitialGridAndClearingAll) {
+  env::bit_occupancy_grid grid(30, 20, 0.5);
+  std::vector<env::cell_index> obstacles{{3, 4}, {17, 11}, {29, 0}, {10, 19}};
+  for (const auto& cell : obstacles) {
+    grid.set(cell, true);
+  }
+  env::dynamic_distance_field dynamic(grid);
+  expect_same_distances(dynamic, grid);
+  EXPECT_TRUE(dynamic.is_occupied({3, 4}));
+  EXPECT_FALSE(dynamic.is_occupied({4, 4}));
+  EXPECT_TRUE(dynamic.is_occupied({-1, 4}));
+
+  dynamic.update({}, span<const env::cell_index>(obstacles));
+  EXPECT_EQ(dynamic.distance({3, 4}), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(dynamic.clearance(5.0, 5.0), std::numeric_limits<double>::infinity());
+}
+
+TEST(DynamicDistanceField, ThinObstacleRegions) {
+  // The region of one obstacle narrows to a sliver that none of the 8 neighbors of some cell
+  // belongs to, so handing on obstacles only to neighbors that get closer misses that cell.
+  const std::vector<std::vector<env::cell_index>> obstacle_sets{
+      {{71, 69}, {44, 76}, {77, 65}}, {{20, 64}, {42, 60}, {7, 27}, {11, 34}, {6, 23}}};
+  for (const auto& obstacles : obstacle_sets) {
+    env::bit_occupancy_grid grid(80, 80, 0.1);
+    for (const auto& cell : obstacles) {
+      grid.set(cell, true);
+    }
+    env::dynamic_distance_field dynamic(80, 80, 0.1);
+    dynamic.update(span<const env::cell_index>(obstacles), {});
+    expect_same_distances(dynamic, grid);
+    expect_same_distances(env::dynamic_distance_field(grid), grid);
+
+    // Clearing the obstacles one after the other has to find the next closest ones again.
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+      const std::vector<env::cell_index> cleared{obstacles[i]};
+      grid.set(cleared[0], false);
+      dynamic.update({}, span<const env::cell_index>(cleared));
+      expect_same_distances(dynamic, grid);
+    }
+  }
+}
+
+TEST(DynamicDistanceField, UpdateCostIsLocal) {
+  // Obstacles every 10 cells in both directions.
+  env::bit_occupancy_grid grid(400, 400, 0.05);
+  for (std::int64_t y = 5; y < 400; y += 10) {
+    for (std::int64_t x = 5; x < 400; x += 10) {
+      grid.set({x, y}, true);
+    }
+  }
+  env::dynamic_distance_field dynamic(grid);
+
+  // Moving one obstacle only touches the cells around it, not the 160000 cells of the map.
+  const std::vector<env::cell_index> set{{206, 206}};
+  const std::vector<env::cell_index> cleared{{205, 205}};
+  const std::size_t processed =
+      dynamic.update(span<const env::cell_index>(set), span<const env::cell_index>(cleared));
+  EXPECT_LT(processed, 500u);
+  grid.set({205, 205}, false);
+  grid.set({206, 206}, true);
+  expect_same_distances(dynamic, grid);
+}
+
+} // namespace trailblaze
@@ -0,0 +1,144 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/kinematics/feasibility.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// A straight line along x, then a left turn with @p radius, with the yaw along the path.
+path<state_se2> straight_then_arc(std::size_t straight_count, std::size_t arc_count,
+                                  double radius, double step) {
+  path<state_se2> states;
+  for (std::size_t i = 0; i < straight_count; ++i) {
+    states.push_back({static_cast<double>(i) * step, 0.0, 0.0});
+  }
+  const double x0 = static_cast<double>(straight_count - 1) * step;
+  for (std::size_t i = 1; i <= arc_count; ++i) {
+    const double angle = static_cast<double>(i) * step / radius;
+    states.push_back({x0 + radius * std::sin(angle), radius * (1.0 - std::cos(angle)), angle});
+  }
+  return states;
+}
+
+} // namespace
+
+TEST(Feasibility, Models) {
+  const kinematic_model car = ackermann_model(2.0, numbers::pi / 4.0, 0.5, false);
+  EXPECT_NEAR(car.max_curvature, 0.5, 1e-12);
+  EXPECT_DOUBLE_EQ(car.max_curvature_rate, 0.25);
+  EXPECT_FALSE(car.reverse);
+  EXPECT_FALSE(car.turn_in_place);
+  const kinematic_model robot = differential_drive_model();
+  EXPECT_TRUE(robot.turn_in_place);
+  EXPECT_TRUE(std::isinf(robot.max_curvature));
+  EXPECT_THROW(static_cast<void>(ackermann_model(0.0, 0.5)), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(ackermann_model(2.0, numbers::pi_2)), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(ackermann_model(2.0, 0.5, -1.0)), std::invalid_argument);
+}
+
+TEST(Feasibility, CurvatureAndCurvatureRate) {
+  // 600 states cross two blocks, the arc starts at index 300.
+  const path<state_se2> states = straight_then_arc(300, 300, 5.0, 0.05);
+  kinematic_model model;
+  model.max_curvature = 0.2;
+  EXPECT_TRUE(is_feasible(states, model));
+
+  model.max_curvature = 0.19;
+  feasibility_report report = check_feasibility(states, model);
+  EXPECT_FALSE(report.feasible());
+  EXPECT_EQ(report.violation, feasibility_violation::curvature);
+  EXPECT_EQ(report.index, 300U);
+  EXPECT_NEAR(report.value, 0.2, 1e-9);
+
+  // The curvature rises from 0 to 0.2 within two states 0.05 apart.
+  model.max_curvature = 0.2;
+  model.max_curvature_rate = 1.0;
+  report = check_feasibility(states, model);
+  EXPECT_EQ(report.violation, feasibility_violation::curvature_rate);
+  EXPECT_EQ(report.index, 299U);
+  EXPECT_NEAR(report.value, 0.1 / 0.05, 1e-4);
+  model.max_curvature_rate = 4.1;
+  EXPECT_TRUE(check_feasibility(states, model).feasible());
+
+  // Same result for coordinate arrays, with and without yaw.
+  model.max_curvature = 0.19;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> yaw;
+  for (const state_se2& s : states.states()) {
+    x.push_back(s.x);
+    y.push_back(s.y);
+    yaw.push_back(s.yaw);
+  }
+  const span<const double> xs(x);
+  const span<const double> ys(y);
+  EXPECT_EQ(check_feasibility(xs, ys, model).index, 300U);
+  EXPECT_EQ(check_feasibility(xs, ys, span<const double>(yaw), model).index, 300U);
+  EXPECT_EQ(check_feasibility(span<const state_se2>(), model).index, 0U);
+}
+
+TEST(Feasibility, HeadingCuspsAndRepeatedStates) {
+  path<state_se2> states = straight_then_arc(10, 10, 5.0, 0.1);
+  kinematic_model model = differential_drive_model(0.05);
+  EXPECT_TRUE(is_feasible(states, model));
+
+  // Sideways motion.
+  states[13].yaw += 0.2;
+  feasibility_report report = check_feasibility(states, model);
+  EXPECT_EQ(report.violation, feasibility_violation::heading);
+  EXPECT_EQ(report.index, 13U);
+  EXPECT_NEAR(report.value, 0.21, 0.01);
+
+  // Turning on the spot.
+  path<state_se2> turn;
+  turn.push_back({0.0, 0.0, 0.0});
+  turn.push_back({1.0, 0.0, 0.0});
+  turn.push_back({1.0, 0.0, numbers::pi_2});
+  turn.push_back({1.0, 1.0, numbers::pi_2});
+  EXPECT_TRUE(is_feasible(turn, model));
+  report = check_feasibility(turn, ackermann_model(2.0, 0.5));
+  EXPECT_EQ(report.violation, feasibility_violation::repeated_state);
+  EXPECT_EQ(report.index, 2U);
+
+  // Driving forwards and backwards on a line, the yaw stays.
+  path<state_r2> cusp;
+  cusp.push_back({0.0, 0.0});
+  cusp.push_back({1.0, 0.0});
+  cusp.push_back({2.0, 0.0});
+  cusp.push_back({1.5, 0.01});
+  cusp.push_back({1.0, 0.02});
+  model = ackermann_model(2.0, 0.5);
+  EXPECT_TRUE(is_feasible(cusp, model));
+  model.reverse = false;
+  report = check_feasibility(cusp, model);
+  EXPECT_EQ(report.violation, feasibility_violation::curvature);
+  EXPECT_EQ(report.index, 2U);
+  EXPECT_TRUE(std::isinf(report.value));
+
+  path<state_se2> reversing;
+  reversing.push_back({0.0, 0.0, 0.0});
+  reversing.push_back({1.0, 0.0, 0.0});
+  reversing.push_back({0.0, 0.0, 0.0});
+  model.reverse = true;
+  EXPECT_TRUE(is_feasible(reversing, model));
+  // The yaw must not follow the reversed direction of motion.
+  reversing[2].yaw = numbers::pi;
+  EXPECT_EQ(check_feasibility(reversing, model).violation, feasibility_violation::heading);
+}
+
+} // namespace trailblaze
@@ -0,0 +1,213 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/collision/footprint_checker.h"
+#include "trailblaze/environment/distance_field.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+const std::vector<state_r2> rectangle{{-0.3, -0.2}, {0.5, -0.2}, {0.5, 0.2}, {-0.3, 0.2}};
+
+env::bit_occupancy_grid random_boxes(std::uint32_t seed) {
+  env::bit_occupancy_grid grid(80, 60, 0.05, {1.0, -2.0});
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<std::int64_t> x(0, 75);
+  std::uniform_int_distribution<std::int64_t> y(0, 55);
+  for (int i = 0; i < 12; ++i) {
+    const std::int64_t x0 = x(rng);
+    const std::int64_t y0 = y(rng);
+    for (std::int64_t dy = 0; dy < 4; ++dy) {
+      for (std::int64_t dx = 0; dx < 4; ++dx) {
+        grid.set({x0 + dx, y0 + dy}, true);
+      }
+    }
+  }
+  return grid;
+}
+
+std::vector<state_se2> random_states(const env::bit_occupancy_grid& grid, std::size_t count) {
+  std::mt19937 rng(11);
+  const double width = static_cast<double>(grid.width()) * grid.resolution();
+  const double height = static_cast<double>(grid.height()) * grid.resolution();
+  std::uniform_real_distribution<double> x(grid.origin().x - 0.2, grid.origin().x + width);
+  std::uniform_real_distribution<double> y(grid.origin().y - 0.2, grid.origin().y + height);
+  std::uniform_real_distribution<double> yaw(-4.0, 4.0);
+  std::vector<state_se2> states(count);
+  for (auto& state : states) {
+    state = {x(rng), y(rng), yaw(rng)};
+  }
+  return states;
+}
+
+} // namespace
+
+TEST(FootprintChecker, Radii) {
+  const env::bit_occupancy_grid grid(10, 10, 0.1);
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field);
+  EXPECT_DOUBLE_EQ(checker.inscribed_radius(), 0.2);
+  EXPECT_DOUBLE_EQ(checker.circumscribed_radius(), std::hypot(0.5, 0.2));
+  EXPECT_EQ(checker.yaw_bin_count(), 64U);
+
+  // The reference point lies outside of this footprint.
+  const std::vector<state_r2> shifted{{0.1, -0.2}, {0.5, -0.2}, {0.5, 0.2}, {0.1, 0.2}};
+  const collision::footprint_checker outside(span<const state_r2>(shifted), grid, field);
+  EXPECT_DOUBLE_EQ(outside.inscribed_radius(), 0.0);
+}
+
+TEST(FootprintChecker, InvalidArguments) {
+  const env::bit_occupancy_grid grid(10, 10, 0.1);
+  const env::distance_field field(grid);
+  const env::bit_occupancy_grid other(10, 11, 0.1);
+  const env::distance_field other_field(other);
+  const span<const state_r2> footprint(rectangle);
+  using checker = collision::footprint_checker<bool>;
+  EXPECT_THROW(checker(footprint.subspan(0, 2), grid, field), std::invalid_argument);
+  EXPECT_THROW(checker(footprint, grid, field, 0), std::invalid_argument);
+  EXPECT_THROW(checker(footprint, grid, other_field), std::invalid_argument);
+}
+
+TEST(FootprintChecker, YawBins) {
+  const env::bit_occupancy_grid grid(10, 10, 0.1);
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field, 8);
+  const double bin_width = numbers::two_pi / 8.0;
+  EXPECT_EQ(checker.yaw_bin(0.0), 0U);
+  EXPECT_EQ(checker.yaw_bin(-0.4 * bin_width), 0U);
+  EXPECT_EQ(checker.yaw_bin(0.4 * bin_width), 0U);
+  EXPECT_EQ(checker.yaw_bin(0.6 * bin_width), 1U);
+  EXPECT_EQ(checker.yaw_bin(-bin_width), 7U);
+  EXPECT_EQ(checker.yaw_bin(numbers::pi), 4U);
+  EXPECT_EQ(checker.yaw_bin(3.0 * bin_width + numbers::two_pi), 3U);
+}
+
+TEST(FootprintChecker, MatchesMaskScan) {
+  const env::bit_occupancy_grid grid = random_boxes(3);
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field, 32);
+
+  std::size_t collisions = 0;
+  for (const state_se2& state : random_states(grid, 4000)) {
+    const env::cell_index cell = grid.cell_of(state.x, state.y);
+    bool expected = !grid.contains(cell);
+    if (!expected) {
+      for (const auto& offset : checker.mask(checker.yaw_bin(state.yaw))) {
+        expected = expected || grid.value({cell.x + offset.dx, cell.y + offset.dy});
+      }
+    }
+    ASSERT_EQ(checker.collides(state), expected) << state.x << ", " << state.y;
+    collisions += expected ? 1 : 0;
+  }
+  // Both outcomes are covered.
+  EXPECT_GT(collisions, 400U);
+  EXPECT_LT(collisions, 3600U);
+}
+
+TEST(FootprintChecker, NoMissedCollisions) {
+  const env::bit_occupancy_grid grid = random_boxes(7);
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field, 16);
+
+  const double resolution = grid.resolution();
+  const auto reach = static_cast<std::int64_t>(std::ceil(checker.circumscribed_radius() /
+                                                         resolution)) + 1;
+  std::vector<state_r2> polygon(rectangle.size());
+  for (const state_se2& state : random_states(grid, 2000)) {
+    const double c = std::cos(state.yaw);
+    const double s = std::sin(state.yaw);
+    for (std::size_t i = 0; i < rectangle.size(); ++i) {
+      polygon[i] = {state.x + c * rectangle[i].x - s * rectangle[i].y,
+                    state.y + s * rectangle[i].x + c * rectangle[i].y};
+    }
+    // Exact test of the footprint against the squares of all occupied cells nearby, cells
+    // outside of the grid count as occupied.
+    const env::cell_index cell = grid.cell_of(state.x, state.y);
+    bool exact = false;
+    for (std::int64_t y = cell.y - reach; y <= cell.y + reach && !exact; ++y) {
+      for (std::int64_t x = cell.x - reach; x <= cell.x + reach && !exact; ++x) {
+        if (!grid.value({x, y})) {
+          continue;
+        }
+        const double min_x = grid.origin().x + static_cast<double>(x) * resolution;
+        const double min_y = grid.origin().y + static_cast<double>(y) * resolution;
+        exact = polygon_intersects_box(span<const state_r2>(polygon),
+                                       {min_x, min_y, min_x + resolution, min_y + resolution});
+      }
+    }
+    if (exact) {
+      ASSERT_TRUE(checker.collides(state)) << state.x << ", " << state.y << ", " << state.yaw;
+    }
+  }
+}
+
+TEST(FootprintChecker, FirstCollision) {
+  env::bit_occupancy_grid grid(100, 40, 0.05);
+  for (std::int64_t y = 0; y < 40; ++y) {
+    grid.set({70, y}, true);
+  }
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field);
+
+  // Drives towards the wall at x = 3.5, the front of the footprint reaches it at x = 3.0.
+  path<state_se2> states;
+  for (int i = 0; i < 40; ++i) {
+    states.push_back({0.5 + 0.1 * i, 1.0, 0.0});
+  }
+  const std::size_t first = checker.first_collision(states);
+  ASSERT_LT(first, states.size());
+  EXPECT_NEAR(states.states()[first].x, 3.0, 0.1 + 1e-9);
+  for (std::size_t i = 0; i < first; ++i) {
+    EXPECT_FALSE(checker.collides(states.states()[i]));
+  }
+
+  EXPECT_EQ(checker.first_collision(span<const state_se2>()), 0U);
+  const span<const state_se2> free = states.states().subspan(0, first);
+  EXPECT_EQ(checker.first_collision(free), first);
+}
+
+TEST(FootprintChecker, SweptMotion) {
+  env::bit_occupancy_grid grid(100, 40, 0.05);
+  // A short wall of one cell width at x = 2.5.
+  for (std::int64_t y = 18; y < 23; ++y) {
+    grid.set({50, y}, true);
+  }
+  const env::distance_field field(grid);
+  const collision::footprint_checker checker(span<const state_r2>(rectangle), grid, field);
+
+  // Both states are free, but the motion between them crosses the wall.
+  const std::vector<state_se2> jump{{1.5, 1.0, 0.0}, {4.0, 1.0, 0.0}};
+  EXPECT_FALSE(checker.collides(jump[0]));
+  EXPECT_FALSE(checker.collides(jump[1]));
+  EXPECT_TRUE(checker.motion_collides(jump[0], jump[1]));
+  EXPECT_EQ(checker.first_collision(span<const state_se2>(jump)), 1U);
+
+  // Turning on the spot sweeps the front of the footprint over the wall.
+  const std::vector<state_se2> turn{{2.025, 1.025, -1.2}, {2.025, 1.025, 1.2}};
+  EXPECT_FALSE(checker.collides(turn[0]));
+  EXPECT_FALSE(checker.collides(turn[1]));
+  EXPECT_TRUE(checker.collides(state_se2{2.025, 1.025, 0.0}));
+  EXPECT_EQ(checker.first_collision(span<const state_se2>(turn)), 1U);
+
+  // Passing next to the wall does not collide.
+  const std::vector<state_se2> pass{{1.5, 0.4, 0.0}, {4.0, 0.4, 0.0}};
+  EXPECT_FALSE(checker.motion_collides(pass[0], pass[1]));
+  EXPECT_EQ(checker.first_collision(span<const state_se2>(pass)), 2U);
+}
+
+} // namespace trailblaze
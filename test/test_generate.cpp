@@ -0,0 +1,98 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <array>
+#include <cmath>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/generate.h"
+#include "trailblaze/math/angle.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Ellipse that can be evaluated one parameter at a time.
+struct test_ellipse {
+  double a{3.0};
+  double b{1.5};
+
+  state_r2 operator()(double t) const {
+    return {a * std::cos(t), b * std::sin(t)};
+  }
+};
+
+/// The same ellipse with an additional batch call operator.
+struct test_batch_ellipse : test_ellipse {
+  using test_ellipse::operator();
+
+  void operator()(span<const double> parameters, span<state_r2> out) const {
+    // sample_parametric_curve_r2 passes at most parametric_batch_size parameters.
+    std::array<double, gen::parametric_batch_size> sines{};
+    std::array<double, gen::parametric_batch_size> cosines{};
+    sincos(parameters, span<double>(sines.data(), parameters.size()),
+           span<double>(cosines.data(), parameters.size()));
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+      out[i] = {a * cosines[i], b * sines[i]};
+    }
+  }
+};
+
+} // namespace
+
+TEST(Generate, CircleArcRecurrenceStaysCloseToExact) {
+  const state_r2 center{4.0, -2.0};
+  for (const double radius : {0.5, 10.0}) {
+    for (const std::size_t anchor_interval : {std::size_t(1), std::size_t(7), std::size_t(32),
+                                              std::size_t(1000)}) {
+      const auto exact =
+          gen::generate_circle_arc_r2(center, radius, 0.3, -5.0, sampling::by_count{1001});
+      const auto fast = gen::generate_circle_arc_r2(center, radius, 0.3, -5.0,
+                                                    sampling::by_count{1001},
+                                                    gen::trig_mode::recurrence, anchor_interval);
+      ASSERT_EQ(fast.size(), exact.size());
+      const double bound = static_cast<double>(anchor_interval) * 5e-16 * (radius + 1.0);
+      for (std::size_t i = 0; i < exact.size(); ++i) {
+        EXPECT_NEAR(fast[i].x, exact[i].x, bound);
+        EXPECT_NEAR(fast[i].y, exact[i].y, bound);
+      }
+      EXPECT_EQ(fast.front().x, exact.front().x);
+      EXPECT_EQ(fast.back().x, exact.back().x);
+      EXPECT_EQ(fast.back().y, exact.back().y);
+    }
+  }
+}
+
+TEST(Generate, CircleArcRecurrenceShortInputs) {
+  EXPECT_TRUE(gen::generate_circle_arc_r2({0.0, 0.0}, 1.0, 0.0, 1.0, sampling::by_count{0},
+                                          gen::trig_mode::recurrence)
+                  .empty());
+  const auto single =
+      gen::generate_circle_arc_r2({1.0, 0.0}, 2.0, numbers::pi_2, 1.0, sampling::by_count{1},
+                                  gen::trig_mode::recurrence, 0);
+  ASSERT_EQ(single.size(), 1u);
+  EXPECT_NEAR(single[0].x, 1.0, 1e-15);
+  EXPECT_NEAR(single[0].y, 2.0, 1e-15);
+}
+
+TEST(Generate, ParametricCurveUsesBatchEvaluation) {
+  static_assert(!is_batch_curve_v<test_ellipse, state_r2>);
+  static_assert(is_batch_curve_v<test_batch_ellipse, state_r2>);
+
+  const interval<double> range{-1.0, 7.0};
+  const auto scalar =
+      gen::sample_parametric_curve_r2(test_ellipse{}, range, 7.0, sampling::by_count{500});
+  const auto batch =
+      gen::sample_parametric_curve_r2(test_batch_ellipse{}, range, 7.0, sampling::by_count{500});
+  ASSERT_EQ(batch.size(), scalar.size());
+  for (std::size_t i = 0; i < scalar.size(); ++i) {
+    EXPECT_NEAR(batch[i].x, scalar[i].x, 3.0 * 4e-16);
+    EXPECT_NEAR(batch[i].y, scalar[i].y, 1.5 * 4e-16);
+  }
+}
+
+} // namespace trailblaze
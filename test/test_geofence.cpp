@@ -0,0 +1,155 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/geofence.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Star shaped zones with a strongly varying radius, so they are very concave.
+ragged_buffer<state_r2> random_zones(std::size_t count, std::size_t vertex_count) {
+  std::mt19937 rng(4);
+  std::uniform_real_distribution<double> center(10.0, 90.0);
+  std::uniform_real_distribution<double> radius(2.0, 20.0);
+  ragged_buffer<state_r2> zones;
+  std::vector<state_r2> vertices;
+  for (std::size_t z = 0; z < count; ++z) {
+    const state_r2 c{center(rng), center(rng)};
+    vertices.clear();
+    for (std::size_t i = 0; i < vertex_count; ++i) {
+      const double angle =
+          numbers::two_pi * static_cast<double>(i) / static_cast<double>(vertex_count);
+      const double r = radius(rng);
+      vertices.push_back({c.x + r * std::cos(angle), c.y + r * std::sin(angle)});
+    }
+    zones.push_back(span<const state_r2>(vertices));
+  }
+  return zones;
+}
+
+/// A random walk through the area of the zones.
+std::vector<state_r2> random_walk(std::size_t count) {
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<double> step(-0.5, 0.5);
+  std::vector<state_r2> states;
+  state_r2 state{50.0, 50.0};
+  for (std::size_t i = 0; i < count; ++i) {
+    state.x = std::clamp(state.x + step(rng), -5.0, 105.0);
+    state.y = std::clamp(state.y + step(rng), -5.0, 105.0);
+    states.push_back(state);
+  }
+  return states;
+}
+
+} // namespace
+
+TEST(Geofence, InvalidArguments) {
+  ragged_buffer<state_r2> zones = random_zones(2, 10);
+  EXPECT_THROW(env::geofence(zones, 0.0), std::invalid_argument);
+  const std::vector<state_r2> segment{{0.0, 0.0}, {1.0, 0.0}};
+  zones.push_back(span<const state_r2>(segment));
+  EXPECT_THROW(env::geofence{zones}, std::invalid_argument);
+}
+
+TEST(Geofence, MatchesPolygonContains) {
+  const ragged_buffer<state_r2> zones = random_zones(4, 500);
+  for (const double cells_per_edge : {0.05, 2.0, 10.0}) {
+    const env::geofence fence(zones, cells_per_edge);
+    ASSERT_EQ(fence.zone_count(), 4U);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coordinate(-5.0, 105.0);
+    std::size_t inside = 0;
+    for (int i = 0; i < 5000; ++i) {
+      const state_r2 point{coordinate(rng), coordinate(rng)};
+      for (std::size_t z = 0; z < fence.zone_count(); ++z) {
+        const bool expected = polygon_contains(fence.zone(z), point);
+        ASSERT_EQ(fence.contains(z, point), expected) << point.x << ", " << point.y;
+        inside += expected ? 1 : 0;
+      }
+    }
+    EXPECT_GT(inside, 500U);
+  }
+}
+
+TEST(Geofence, AxisAlignedZone) {
+  // Vertices, edges and cell boundaries coincide, and points lie on cell centers.
+  ragged_buffer<state_r2> zones;
+  const std::vector<state_r2> u_shape{{0, 0}, {3, 0}, {3, 3}, {2, 3}, {2, 1}, {1, 1}, {1, 3},
+                                      {0, 3}};
+  zones.push_back(span<const state_r2>(u_shape));
+  const env::geofence fence(zones, 1.0);
+  for (double y = 0.25; y < 3.0; y += 0.5) {
+    for (double x = 0.25; x < 3.0; x += 0.5) {
+      EXPECT_EQ(fence.contains(0, {x, y}), polygon_contains(fence.zone(0), {x, y}))
+          << x << ", " << y;
+    }
+  }
+  EXPECT_FALSE(fence.contains(0, {-1.0, 1.0}));
+  EXPECT_FALSE(fence.contains(0, {std::nan(""), 1.0}));
+}
+
+TEST(Geofence, ClassifyAndTransitions) {
+  const env::geofence fence(random_zones(6, 300));
+  const std::vector<state_r2> walk = random_walk(20000);
+  const span<const state_r2> states(walk);
+  thread_pool pool(3);
+
+  std::vector<std::uint8_t> serial(walk.size());
+  std::vector<std::uint8_t> parallel(walk.size());
+  std::vector<env::zone_transition> expected;
+  for (std::size_t z = 0; z < fence.zone_count(); ++z) {
+    fence.classify(z, states, span<std::uint8_t>(serial));
+    fence.classify(pool, z, states, span<std::uint8_t>(parallel), 1000);
+    for (std::size_t i = 0; i < walk.size(); ++i) {
+      ASSERT_EQ(serial[i] != 0, fence.contains(z, walk[i]));
+      ASSERT_EQ(parallel[i], serial[i]);
+    }
+  }
+  for (std::size_t i = 1; i < walk.size(); ++i) {
+    for (std::size_t z = 0; z < fence.zone_count(); ++z) {
+      const bool previous = fence.contains(z, walk[i - 1]);
+      const bool current = fence.contains(z, walk[i]);
+      if (previous != current) {
+        expected.push_back({i, z, current});
+      }
+    }
+  }
+  ASSERT_GT(expected.size(), 20U);
+
+  const auto expect_same = [&](const std::vector<env::zone_transition>& actual) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_EQ(actual[i].index, expected[i].index);
+      EXPECT_EQ(actual[i].zone, expected[i].zone);
+      EXPECT_EQ(actual[i].entering, expected[i].entering);
+    }
+  };
+  std::vector<env::zone_transition> transitions{{1, 2, true}};
+  fence.transitions(states, transitions);
+  expect_same(transitions);
+  fence.transitions(pool, states, transitions, 777);
+  expect_same(transitions);
+
+  path<state_r2> short_path;
+  short_path.push_back(walk[0]);
+  fence.transitions(short_path, transitions);
+  EXPECT_TRUE(transitions.empty());
+}
+
+} // namespace trailblaze
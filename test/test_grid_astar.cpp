@@ -0,0 +1,174 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/path.h"
+#include "trailblaze/planning/grid_astar.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Reference: Dijkstra with the same moves, returns the cost from @p start to @p goal.
+double dijkstra_cost(const env::bit_occupancy_grid& grid, env::cell_index start,
+                     env::cell_index goal) {
+  const auto width = static_cast<std::int64_t>(grid.width());
+  std::vector<double> cost(grid.width() * grid.height(), std::numeric_limits<double>::infinity());
+  using entry = std::pair<double, std::int64_t>;
+  std::priority_queue<entry, std::vector<entry>, std::greater<>> open;
+  const auto free = [&](std::int64_t x, std::int64_t y) { return !grid.value({x, y}); };
+  cost[static_cast<std::size_t>(start.y * width + start.x)] = 0.0;
+  open.push({0.0, start.y * width + start.x});
+  while (!open.empty()) {
+    const auto [c, index] = open.top();
+    open.pop();
+    if (c > cost[static_cast<std::size_t>(index)]) {
+      continue;
+    }
+    const std::int64_t x = index % width;
+    const std::int64_t y = index / width;
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+      for (std::int64_t dx = -1; dx <= 1; ++dx) {
+        if ((dx == 0 && dy == 0) || !free(x + dx, y + dy) || !free(x + dx, y) ||
+            !free(x, y + dy)) {
+          continue;
+        }
+        const double step = std::sqrt(static_cast<double>(dx * dx + dy * dy));
+        const double next = c + grid.resolution() * step;
+        const auto neighbor = static_cast<std::size_t>((y + dy) * width + x + dx);
+        if (next < cost[neighbor]) {
+          cost[neighbor] = next;
+          open.push({next, (y + dy) * width + x + dx});
+        }
+      }
+    }
+  }
+  return cost[static_cast<std::size_t>(goal.y * width + goal.x)];
+}
+
+} // namespace
+
+TEST(GridAStar, OpenGrid) {
+  const env::bit_occupancy_grid grid(20, 20, 0.5, {-1.0, -1.0});
+  planning::search_workspace workspace(grid);
+  const state_r2 start = grid.cell_center({0, 0});
+  const state_r2 goal = grid.cell_center({10, 5});
+  const path<state_r2> result = planning::grid_astar(grid, start, goal, workspace);
+  ASSERT_EQ(result.size(), 11U);
+  EXPECT_DOUBLE_EQ(result.start().x, start.x);
+  EXPECT_DOUBLE_EQ(result.goal().y, goal.y);
+  EXPECT_NEAR(workspace.path_cost(), 0.5 * (5.0 * std::sqrt(2.0) + 5.0), 1e-12);
+  // The tie breaking heads straight for the goal.
+  EXPECT_EQ(workspace.expanded_count(), 10U);
+
+  planning::grid_search_options options;
+  options.diagonal = false;
+  path<state_r2> out;
+  EXPECT_TRUE(planning::grid_astar(grid, start, goal, workspace, out, options));
+  EXPECT_EQ(out.size(), 16U);
+  EXPECT_NEAR(workspace.path_cost(), 0.5 * 15.0, 1e-12);
+
+  EXPECT_EQ(planning::grid_astar(grid, start, start, workspace).size(), 1U);
+  planning::search_workspace wrong(10, 10);
+  EXPECT_THROW(static_cast<void>(planning::grid_astar(grid, start, goal, wrong)),
+               std::invalid_argument);
+}
+
+TEST(GridAStar, MatchesDijkstraOnRandomGrids) {
+  env::bit_occupancy_grid grid(64, 48, 0.1);
+  std::mt19937 rng(7);
+  std::bernoulli_distribution occupied(0.3);
+  for (std::int64_t y = 0; y < 48; ++y) {
+    for (std::int64_t x = 0; x < 64; ++x) {
+      grid.set({x, y}, occupied(rng));
+    }
+  }
+  // One workspace for all queries.
+  planning::search_workspace workspace(grid);
+  std::uniform_int_distribution<std::int64_t> column(0, 63);
+  std::uniform_int_distribution<std::int64_t> row(0, 47);
+  path<state_r2> out;
+  int found = 0;
+  for (int query = 0; query < 50; ++query) {
+    const env::cell_index start{column(rng), row(rng)};
+    const env::cell_index goal{column(rng), row(rng)};
+    grid.set(start, false);
+    grid.set(goal, false);
+    const double expected = dijkstra_cost(grid, start, goal);
+    const bool success = planning::grid_astar(grid, grid.cell_center(start),
+                                              grid.cell_center(goal), workspace, out);
+    ASSERT_EQ(success, expected < std::numeric_limits<double>::infinity());
+    if (!success) {
+      EXPECT_TRUE(out.empty());
+      EXPECT_TRUE(std::isinf(workspace.path_cost()));
+      continue;
+    }
+    ++found;
+    EXPECT_NEAR(workspace.path_cost(), expected, 1e-9);
+    // Consecutive cells are neighbors, free, and diagonal moves do not cut corners.
+    double length = 0.0;
+    for (std::size_t i = 1; i < out.size(); ++i) {
+      const env::cell_index a = grid.cell_of(out[i - 1].x, out[i - 1].y);
+      const env::cell_index b = grid.cell_of(out[i].x, out[i].y);
+      ASSERT_LE(std::abs(b.x - a.x), 1);
+      ASSERT_LE(std::abs(b.y - a.y), 1);
+      EXPECT_FALSE(grid.value(b));
+      EXPECT_FALSE(grid.value({b.x, a.y}));
+      EXPECT_FALSE(grid.value({a.x, b.y}));
+      length += std::hypot(out[i].x - out[i - 1].x, out[i].y - out[i - 1].y);
+    }
+    EXPECT_NEAR(length, expected, 1e-9);
+  }
+  EXPECT_GT(found, 10);
+
+  // A weighted heuristic bounds the cost.
+  const env::cell_index start{0, 0};
+  const env::cell_index goal{63, 47};
+  grid.set(start, false);
+  grid.set(goal, false);
+  const double optimum = dijkstra_cost(grid, start, goal);
+  if (optimum < std::numeric_limits<double>::infinity()) {
+    planning::grid_search_options options;
+    options.heuristic_weight = 2.0;
+    EXPECT_TRUE(planning::grid_astar(grid, grid.cell_center(start), grid.cell_center(goal),
+                                     workspace, out, options));
+    EXPECT_LE(workspace.path_cost(), 2.0 * optimum + 1e-9);
+  }
+}
+
+TEST(GridAStar, NoPath) {
+  env::bit_occupancy_grid grid(10, 10, 1.0);
+  // Enclose the cell (5, 5), diagonal gaps do not let the search through.
+  grid.set({5, 4}, true);
+  grid.set({5, 6}, true);
+  grid.set({4, 5}, true);
+  grid.set({6, 5}, true);
+  planning::search_workspace workspace(grid);
+  path<state_r2> out;
+  out.push_back({1.0, 1.0});
+  EXPECT_FALSE(planning::grid_astar(grid, {0.5, 0.5}, {5.5, 5.5}, workspace, out));
+  EXPECT_TRUE(out.empty());
+  EXPECT_TRUE(std::isinf(workspace.path_cost()));
+  // Occupied or outside start and goal.
+  EXPECT_TRUE(planning::grid_astar(grid, {0.5, 0.5}, {9.5, 9.5}, workspace).size() > 0);
+  EXPECT_TRUE(planning::grid_astar(grid, {5.5, 4.5}, {9.5, 9.5}, workspace).empty());
+  EXPECT_TRUE(planning::grid_astar(grid, {0.5, 0.5}, {10.5, 9.5}, workspace).empty());
+  EXPECT_EQ(workspace.expanded_count(), 0U);
+}
+
+} // namespace trailblaze
@@ -2,12 +2,17 @@
  * Copyright(c) 2024-present, Sebastian Klemm & contributors.
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <utility>
+#include <vector>
 // external
 #include <gtest/gtest.h>
 
 #include "trailblaze/math/numbers.h"
 #include "trailblaze/math/angle.h"
 #include "trailblaze/math/interpolation.h"
+#include "trailblaze/quaternion.h"
 // related to testing
 #include "common.h"
 
@@ -38,4 +43,51 @@ TEST(Interpolation, LinearAngleInterpolation) {
               linear_interpolation_accuracy);
 }
 
+TEST(Interpolation, PrecomputedSlerpMatchesQuaternionInterpolation) {
+  const std::vector<std::pair<quaternion, quaternion>> segments = {
+      {normalized(quaternion{0.1, 0.2, 0.3, 0.9}), normalized(quaternion{-0.4, 0.1, 0.8, 0.2})},
+      // opposite signs take the shorter arc
+      {normalized(quaternion{0.0, 0.0, 0.1, 1.0}), normalized(quaternion{0.0, 0.0, 0.3, -1.0})},
+      // nearly identical quaternions blend linearly
+      {quaternion{0.0, 0.0, 0.0, 1.0}, normalized(quaternion{1e-5, 0.0, 0.0, 1.0})},
+      // 180 degree rotation apart
+      {quaternion{0.0, 0.0, 0.0, 1.0}, quaternion{1.0, 0.0, 0.0, 0.0}}};
+
+  std::vector<double> ratios;
+  for (int i = 0; i <= 20; ++i) {
+    ratios.push_back(0.05 * i);
+  }
+
+  for (const auto& [a, b] : segments) {
+    const quaternion_slerp slerp(a, b);
+    std::vector<quaternion> batch(ratios.size());
+    slerp(span<const double>(ratios), span<quaternion>(batch));
+
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      const quaternion expected = interpolate_quaternion(a, b, ratios[i]);
+      const quaternion single = slerp(ratios[i]);
+      for (const auto& result : {single, batch[i]}) {
+        EXPECT_NEAR(result.x, expected.x, 1e-11);
+        EXPECT_NEAR(result.y, expected.y, 1e-11);
+        EXPECT_NEAR(result.z, expected.z, 1e-11);
+        EXPECT_NEAR(result.w, expected.w, 1e-11);
+      }
+    }
+  }
+}
+
+TEST(Interpolation, PrecomputedSlerpExtrapolates) {
+  const quaternion a = normalized(quaternion{0.1, 0.2, 0.3, 0.9});
+  const quaternion b = normalized(quaternion{-0.4, 0.1, 0.8, 0.2});
+  const quaternion_slerp slerp(a, b);
+  const std::vector<double> ratios = {-0.5, 0.5, 1.5};
+  std::vector<quaternion> batch(ratios.size());
+  slerp(span<const double>(ratios), span<quaternion>(batch));
+  for (std::size_t i = 0; i < ratios.size(); ++i) {
+    const quaternion expected = interpolate_quaternion(a, b, ratios[i]);
+    EXPECT_NEAR(batch[i].x, expected.x, 1e-12);
+    EXPECT_NEAR(batch[i].w, expected.w, 1e-12);
+  }
+}
+
 } // namespace trailblaze
@@ -0,0 +1,194 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/linear_quadtree.h"
+#include "trailblaze/environment/ray_caster.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Scattered cells and a few filled rectangles, with a size that is not a power of two.
+env::bit_occupancy_grid random_grid() {
+  env::bit_occupancy_grid grid(90, 61, 0.1, {-1.0, 2.0});
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<std::int64_t> x(0, 89);
+  std::uniform_int_distribution<std::int64_t> y(0, 60);
+  for (int i = 0; i < 80; ++i) {
+    grid.set({x(rng), y(rng)}, true);
+  }
+  for (int i = 0; i < 4; ++i) {
+    const std::int64_t min_x = x(rng);
+    const std::int64_t min_y = y(rng);
+    for (std::int64_t cy = min_y; cy < std::min<std::int64_t>(min_y + 12, 61); ++cy) {
+      for (std::int64_t cx = min_x; cx < std::min<std::int64_t>(min_x + 15, 90); ++cx) {
+        grid.set({cx, cy}, true);
+      }
+    }
+  }
+  return grid;
+}
+
+/// Distance from a point to the closest occupied cell area, by checking all cells.
+double brute_force_clearance(const env::bit_occupancy_grid& grid, double x, double y) {
+  const double fx = (x - grid.origin().x) / grid.resolution();
+  const double fy = (y - grid.origin().y) / grid.resolution();
+  double best = std::numeric_limits<double>::infinity();
+  for (std::int64_t cy = 0; cy < static_cast<std::int64_t>(grid.height()); ++cy) {
+    for (std::int64_t cx = 0; cx < static_cast<std::int64_t>(grid.width()); ++cx) {
+      if (grid.value({cx, cy})) {
+        const auto min_x = static_cast<double>(cx);
+        const auto min_y = static_cast<double>(cy);
+        const double dx = std::max({min_x - fx, 0.0, fx - min_x - 1.0});
+        const double dy = std::max({min_y - fy, 0.0, fy - min_y - 1.0});
+        best = std::min(best, std::hypot(dx, dy));
+      }
+    }
+  }
+  return best * grid.resolution();
+}
+
+} // namespace
+
+TEST(LinearQuadtree, InvalidArguments) {
+  const std::vector<env::cell_index> cells{{1, 1}};
+  const span<const env::cell_index> inside(cells);
+  EXPECT_THROW(env::linear_quadtree(10, 10, 0.0, {}, inside), std::invalid_argument);
+  EXPECT_THROW(env::linear_quadtree(0, 10, 1.0, {}, inside), std::invalid_argument);
+  const std::vector<env::cell_index> outside{{10, 1}};
+  EXPECT_THROW(env::linear_quadtree(10, 10, 1.0, {}, span<const env::cell_index>(outside)),
+               std::out_of_range);
+}
+
+TEST(LinearQuadtree, MemoryFollowsBoundary) {
+  // A filled square of 256 x 256 cells, aligned and shifted by one cell.
+  for (const std::int64_t offset : {0, 1}) {
+    std::vector<env::cell_index> cells;
+    for (std::int64_t y = 0; y < 256; ++y) {
+      for (std::int64_t x = 0; x < 256; ++x) {
+        cells.push_back({x + 256 + offset, y + 256 + offset});
+      }
+    }
+    // The duplicates are merged.
+    cells.push_back(cells.front());
+    const env::linear_quadtree tree(4096, 4096, 1.0, {}, span<const env::cell_index>(cells));
+    if (offset == 0) {
+      EXPECT_EQ(tree.leaf_count(), 1U);
+    } else {
+      EXPECT_LT(tree.leaf_count(), 4U * 256U * 2U);
+    }
+    EXPECT_TRUE(tree.is_occupied({256 + offset, 256 + offset}));
+    EXPECT_TRUE(tree.is_occupied({511 + offset, 511 + offset}));
+    EXPECT_FALSE(tree.is_occupied({255 + offset, 300}));
+    EXPECT_FALSE(tree.is_occupied({4095, 4095}));
+    EXPECT_TRUE(tree.is_occupied({4096, 0}));
+    EXPECT_DOUBLE_EQ(tree.clearance(2000.5, 300.5),
+                     2000.5 - 512.0 - static_cast<double>(offset));
+  }
+}
+
+TEST(LinearQuadtree, MatchesDenseGrid) {
+  const env::bit_occupancy_grid grid = random_grid();
+  const env::linear_quadtree tree(grid);
+  ASSERT_EQ(tree.width(), grid.width());
+  ASSERT_EQ(tree.height(), grid.height());
+  for (std::int64_t y = -1; y <= 61; ++y) {
+    for (std::int64_t x = -1; x <= 90; ++x) {
+      ASSERT_EQ(tree.is_occupied({x, y}), grid.value({x, y})) << x << ", " << y;
+    }
+  }
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> x(-1.5, 8.5);
+  std::uniform_real_distribution<double> y(1.5, 8.5);
+  path<state_r2> states;
+  for (int i = 0; i < 2000; ++i) {
+    states.push_back({x(rng), y(rng)});
+  }
+  std::vector<std::uint8_t> occupied(states.size());
+  std::vector<double> clearance(states.size());
+  tree.occupied(states, span<std::uint8_t>(occupied));
+  tree.clearance(states, span<double>(clearance));
+  std::size_t first = states.size();
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    const state_r2& s = states.states()[i];
+    const bool expected = grid.value(grid.cell_of(s.x, s.y));
+    ASSERT_EQ(occupied[i] != 0, expected) << i;
+    if (expected && first == states.size()) {
+      first = i;
+    }
+    const bool inside = grid.contains(grid.cell_of(s.x, s.y));
+    ASSERT_NEAR(clearance[i], inside ? brute_force_clearance(grid, s.x, s.y) : 0.0, 1e-9) << i;
+  }
+  EXPECT_EQ(tree.first_occupied(states), first);
+  EXPECT_FALSE(tree.is_free(states));
+  // A bound caps the result.
+  for (std::size_t i = 0; i < 100; ++i) {
+    const state_r2& s = states.states()[i];
+    EXPECT_DOUBLE_EQ(tree.clearance(s.x, s.y, 0.15), std::min(0.15, clearance[i]));
+  }
+}
+
+TEST(LinearQuadtree, RaysMatchDenseGrid) {
+  const env::bit_occupancy_grid grid = random_grid();
+  const env::linear_quadtree tree(grid);
+  const env::ray_caster caster(grid);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> x(-1.2, 8.2);
+  std::uniform_real_distribution<double> y(1.8, 8.3);
+  std::uniform_real_distribution<double> angle(-numbers::pi, numbers::pi);
+  std::size_t hits = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const state_r2 origin{x(rng), y(rng)};
+    const double direction = angle(rng);
+    const env::ray_hit expected = caster.cast(origin, direction, 4.0);
+    const env::ray_hit hit = tree.cast(origin, direction, 4.0);
+    ASSERT_EQ(hit.hit, expected.hit) << i;
+    ASSERT_NEAR(hit.distance, expected.distance, 1e-9) << i;
+    if (hit.hit) {
+      EXPECT_EQ(hit.cell.x, expected.cell.x);
+      EXPECT_EQ(hit.cell.y, expected.cell.y);
+      ++hits;
+    }
+  }
+  EXPECT_GT(hits, 500U);
+  for (const double direction : {0.0, numbers::pi_2, numbers::pi, -numbers::pi_2}) {
+    const env::ray_hit expected = caster.cast({3.05, 5.05}, direction, 10.0);
+    const env::ray_hit hit = tree.cast({3.05, 5.05}, direction, 10.0);
+    EXPECT_EQ(hit.hit, expected.hit);
+    EXPECT_NEAR(hit.distance, expected.distance, 1e-9);
+  }
+  EXPECT_TRUE(tree.cast({std::nan(""), 3.0}, 0.0, 1.0).hit);
+  EXPECT_TRUE(tree.cast({1e300, 3.0}, 0.0, 1.0).hit);
+  EXPECT_TRUE(tree.cast({3.05, -1e300}, 0.0, 1.0).hit);
+  EXPECT_FALSE(grid.contains(tree.cell_of(-1e300, 3.0)));
+  const env::ray_hit undirected = tree.cast({3.05, 5.05}, std::nan(""), 10.0);
+  EXPECT_EQ(undirected.hit, caster.cast({3.05, 5.05}, std::nan(""), 10.0).hit);
+
+  std::vector<state_r2> polyline;
+  for (int i = 0; i < 50; ++i) {
+    polyline.push_back({x(rng), y(rng)});
+  }
+  const span<const state_r2> vertices(polyline);
+  EXPECT_EQ(tree.first_intersection(vertices), caster.first_intersection(vertices));
+  for (std::size_t i = 1; i < polyline.size(); ++i) {
+    EXPECT_EQ(tree.segment_free(polyline[i - 1], polyline[i]),
+              caster.segment_free(polyline[i - 1], polyline[i]));
+  }
+}
+
+} // namespace trailblaze
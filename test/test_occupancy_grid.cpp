@@ -0,0 +1,126 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/occupancy_grid.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+template <typename TCell>
+class OccupancyGrid : public ::testing::Test {};
+
+using cell_types = ::testing::Types<bool, std::uint8_t, float>;
+TYPED_TEST_SUITE(OccupancyGrid, cell_types);
+
+} // namespace
+
+TYPED_TEST(OccupancyGrid, SetAndReadAcrossTiles) {
+  using traits = env::cell_traits<TypeParam>;
+  // 19 x 13 cells do not fill the last tiles completely.
+  env::occupancy_grid<TypeParam> grid(19, 13, 0.5, {-1.0, 2.0});
+  EXPECT_EQ(grid.width(), 19u);
+  EXPECT_EQ(grid.height(), 13u);
+
+  for (std::int64_t y = 0; y < 13; ++y) {
+    for (std::int64_t x = 0; x < 19; ++x) {
+      if ((x * 7 + y * 3) % 5 == 0) {
+        grid.set({x, y}, traits::occupied);
+      }
+    }
+  }
+  for (std::int64_t y = 0; y < 13; ++y) {
+    for (std::int64_t x = 0; x < 19; ++x) {
+      const bool expected = (x * 7 + y * 3) % 5 == 0;
+      EXPECT_EQ(grid.is_occupied_value(grid.value({x, y})), expected) << x << ", " << y;
+    }
+  }
+  grid.set({0, 0}, traits::free);
+  EXPECT_FALSE(grid.is_occupied_value(grid.value({0, 0})));
+
+  EXPECT_EQ(grid.value({-1, 0}), traits::occupied);
+  EXPECT_EQ(grid.value({19, 0}), traits::occupied);
+  EXPECT_EQ(grid.value({0, 13}), traits::occupied);
+  EXPECT_THROW(grid.set({19, 0}, traits::free), std::out_of_range);
+
+  grid.fill(traits::occupied);
+  EXPECT_EQ(grid.value({18, 12}), traits::occupied);
+}
+
+TYPED_TEST(OccupancyGrid, BatchQueries) {
+  using traits = env::cell_traits<TypeParam>;
+  env::occupancy_grid<TypeParam> grid(16, 16, 0.25, {1.0, 1.0});
+  grid.set({6, 4}, traits::occupied);
+
+  path<state_se2> states;
+  // From cell (0, 4) through (15, 4) and then out of the grid.
+  for (int i = 0; i < 18; ++i) {
+    states.push_back({1.0 + 0.125 + 0.25 * i, 1.0 + 4.1 * 0.25, 0.0});
+  }
+  // Not a std::vector, which has no data() for bool.
+  const auto values = std::make_unique<TypeParam[]>(states.size());
+  grid.values(states, span<TypeParam>(values.get(), states.size()));
+  std::vector<std::uint8_t> occupied(states.size());
+  grid.occupied(states, span<std::uint8_t>(occupied));
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    const bool expected = i == 6 || i >= 16;
+    EXPECT_EQ(grid.is_occupied_value(values[i]), expected) << i;
+    EXPECT_EQ(occupied[i], expected ? 1 : 0) << i;
+  }
+  EXPECT_EQ(grid.first_occupied(states), 6u);
+  EXPECT_FALSE(grid.is_free(states));
+  const span<const state_se2> all = states.states();
+  EXPECT_TRUE(grid.is_free(all.subspan(0, 6)));
+  EXPECT_EQ(grid.first_occupied(all.subspan(7, 9)), 9u);
+}
+
+TEST(OccupancyGrid, WorldToCellMapping) {
+  const env::byte_occupancy_grid grid(10, 10, 0.5, {-2.0, 3.0});
+  const env::cell_index cell = grid.cell_of(-1.1, 4.9);
+  EXPECT_EQ(cell.x, 1);
+  EXPECT_EQ(cell.y, 3);
+  EXPECT_EQ(grid.cell_of(-2.1, 3.0).x, -1);
+  const state_r2 center = grid.cell_center(cell);
+  EXPECT_DOUBLE_EQ(center.x, -1.25);
+  EXPECT_DOUBLE_EQ(center.y, 4.75);
+
+  // NaN and coordinates beyond the range of cell_index map to cells far outside.
+  for (const double x : {std::numeric_limits<double>::quiet_NaN(), 1e300, -1e300,
+                         std::numeric_limits<double>::infinity()}) {
+    const env::cell_index far = grid.cell_of(x, 4.9);
+    EXPECT_FALSE(grid.contains(far));
+    EXPECT_EQ(far.y, 3);
+    EXPECT_TRUE(grid.value(far) == env::cell_traits<std::uint8_t>::occupied);
+  }
+
+  const std::vector<state_r2> outside{{std::numeric_limits<double>::quiet_NaN(), 4.0}};
+  EXPECT_EQ(grid.first_occupied(span<const state_r2>(outside)), 0u);
+  EXPECT_THROW(env::byte_occupancy_grid(1, 1, 0.0), std::invalid_argument);
+}
+
+TEST(OccupancyGrid, ThresholdDefinesOccupancy) {
+  env::byte_occupancy_grid grid(8, 8, 1.0);
+  grid.set({2, 2}, 100);
+  EXPECT_FALSE(grid.is_occupied_value(grid.value({2, 2})));
+  grid.set_occupied_threshold(100);
+  EXPECT_TRUE(grid.is_occupied_value(grid.value({2, 2})));
+
+  env::float_occupancy_grid probabilities(8, 8, 1.0);
+  probabilities.set({1, 1}, 0.7F);
+  const std::vector<state_r2> states{{1.5, 1.5}, {0.5, 0.5}};
+  EXPECT_EQ(probabilities.first_occupied(span<const state_r2>(states)), 0u);
+}
+
+} // namespace trailblaze
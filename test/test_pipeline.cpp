@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <iterator>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/algorithm/annotate.h"
+#include "trailblaze/algorithm/geometry.h"
+#include "trailblaze/algorithm/resample.h"
+#include "trailblaze/path.h"
+#include "trailblaze/pipeline.h"
+
+namespace trailblaze {
+
+namespace {
+
+path<state_r2> zigzag() {
+  path<state_r2> out;
+  out.push_back({0.0, 0.0});
+  out.push_back({1.0, 0.5});
+  out.push_back({1.0, 0.5}); // zero length segment
+  out.push_back({2.5, -1.0});
+  out.push_back({2.6, -1.0});
+  out.push_back({4.0, 3.0});
+  return out;
+}
+
+state_se2 shifted(const state_se2& state) {
+  return {state.x + 10.0, state.y - 5.0, state.yaw};
+}
+
+} // namespace
+
+TEST(Pipeline, MatchesEagerStages) {
+  using namespace pipeline;
+  const path<state_r2> input = zigzag();
+
+  for (const double density : {0.05, 0.3, 1.0, 100.0, 0.0}) {
+    std::vector<state_r2> resampled_states;
+    resample(input.states(), density, std::back_inserter(resampled_states));
+    const path<state_se2> annotated =
+        annotate::yaw_chord(span<state_r2>(resampled_states));
+    std::vector<state_se2> expected;
+    for (const auto& state : annotated.states()) {
+      expected.push_back(shifted(state));
+    }
+
+    const path<state_se2> lazy =
+        collect(states(input) | resampled(density) | yaw_from_chord() | transformed(shifted));
+    ASSERT_EQ(lazy.size(), expected.size()) << "density " << density;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(lazy[i].x, expected[i].x, 1e-12);
+      EXPECT_NEAR(lazy[i].y, expected[i].y, 1e-12);
+      EXPECT_NEAR(lazy[i].yaw, expected[i].yaw, 1e-12);
+    }
+
+    const double length =
+        length_xy(states(input) | resampled(density) | yaw_from_chord() | transformed(shifted));
+    EXPECT_NEAR(length, trailblaze::length_xy(span<const state_se2>(expected)), 1e-9);
+  }
+}
+
+TEST(Pipeline, ShortInputs) {
+  using namespace pipeline;
+  const path<state_r2> empty;
+  EXPECT_EQ(collect(states(empty) | resampled(0.1) | yaw_from_chord()).size(), 0u);
+
+  path<state_r2> single;
+  single.push_back({1.0, 2.0});
+  const path<state_se2> out = collect(states(single) | resampled(0.1) | yaw_from_chord());
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_EQ(out[0].x, 1.0);
+  EXPECT_EQ(out[0].yaw, 0.0);
+}
+
+TEST(Pipeline, KeepsStateTypeWithYaw) {
+  using namespace pipeline;
+  std::vector<state_se2> input{{0.0, 0.0, 2.0}, {0.0, 1.0, 2.0}, {-1.0, 1.0, 2.0}};
+  std::vector<double> yaws;
+  const std::size_t count =
+      for_each(states(span<state_se2>(input)) | yaw_from_chord(annotate::yaw_precision::fast),
+               [&yaws](const state_se2& state) { yaws.push_back(state.yaw); });
+  ASSERT_EQ(count, 3u);
+  EXPECT_NEAR(yaws[0], numbers::pi_2, 1e-7);
+  EXPECT_NEAR(yaws[1], -numbers::pi, 1e-7);
+  EXPECT_NEAR(yaws[2], -numbers::pi, 1e-7);
+}
+
+TEST(Pipeline, CustomResampleFunctors) {
+  using namespace pipeline;
+  const path<state_r2> input = zigzag();
+  const auto metric = [](const state_r2& a, const state_r2& b) {
+    return std::fabs(b.x - a.x) + std::fabs(b.y - a.y);
+  };
+  const auto interpolate = [](const state_r2& a, const state_r2& b, double t) {
+    return state_r2{a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)};
+  };
+  std::vector<state_r2> expected;
+  resample(input.states(), 0.25, std::back_inserter(expected), metric, interpolate);
+  const path<state_r2> lazy = collect(states(input) | resampled(0.25, metric, interpolate));
+  ASSERT_EQ(lazy.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(lazy[i].x, expected[i].x, 1e-12);
+    EXPECT_NEAR(lazy[i].y, expected[i].y, 1e-12);
+  }
+}
+
+} // namespace trailblaze
@@ -0,0 +1,164 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/environment/polygon_map.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/math/polygon.h"
+#include "trailblaze/path.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Random star shaped polygons, many of them concave.
+ragged_buffer<state_r2> random_polygons(std::size_t count, std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> center(0.0, 100.0);
+  std::uniform_real_distribution<double> radius(0.3, 2.0);
+  std::uniform_int_distribution<int> vertex_count(3, 9);
+  ragged_buffer<state_r2> polygons;
+  std::vector<state_r2> vertices;
+  for (std::size_t p = 0; p < count; ++p) {
+    const state_r2 c{center(rng), center(rng)};
+    const int n = vertex_count(rng);
+    vertices.clear();
+    for (int i = 0; i < n; ++i) {
+      const double angle = numbers::two_pi * i / n;
+      const double r = radius(rng);
+      vertices.push_back({c.x + r * std::cos(angle), c.y + r * std::sin(angle)});
+    }
+    polygons.push_back(span<const state_r2>(vertices));
+  }
+  return polygons;
+}
+
+std::vector<state_r2> random_points(std::size_t count) {
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> coordinate(-5.0, 105.0);
+  std::vector<state_r2> points(count);
+  for (auto& point : points) {
+    point = {coordinate(rng), coordinate(rng)};
+  }
+  return points;
+}
+
+} // namespace
+
+TEST(Polygon, Predicates) {
+  // An L shaped, concave polygon.
+  const std::vector<state_r2> l_shape{{0, 0}, {2, 0}, {2, 1}, {1, 1}, {1, 2}, {0, 2}};
+  const span<const state_r2> polygon(l_shape);
+  EXPECT_TRUE(polygon_contains(polygon, {0.5, 1.5}));
+  EXPECT_TRUE(polygon_contains(polygon, {1.5, 0.5}));
+  EXPECT_FALSE(polygon_contains(polygon, {1.5, 1.5}));
+  EXPECT_DOUBLE_EQ(polygon_distance(polygon, {1.5, 1.5}), 0.5);
+  EXPECT_DOUBLE_EQ(polygon_distance(polygon, {0.5, 0.5}), 0.0);
+  EXPECT_DOUBLE_EQ(polygon_distance(polygon, {3.0, 0.5}), 1.0);
+
+  EXPECT_TRUE(segments_intersect({0, 0}, {1, 1}, {0, 1}, {1, 0}));
+  EXPECT_FALSE(segments_intersect({0, 0}, {1, 1}, {1, 0}, {2, 0}));
+  // Touching endpoints and collinear overlaps count.
+  EXPECT_TRUE(segments_intersect({0, 0}, {1, 0}, {1, 0}, {1, 1}));
+  EXPECT_TRUE(segments_intersect({0, 0}, {2, 0}, {1, 0}, {3, 0}));
+  EXPECT_FALSE(segments_intersect({0, 0}, {1, 0}, {2, 0}, {3, 0}));
+
+  // Crosses the notch of the L without touching it.
+  EXPECT_FALSE(polygon_intersects_segment(polygon, {1.2, 2.5}, {2.5, 1.2}));
+  EXPECT_TRUE(polygon_intersects_segment(polygon, {1.5, 1.5}, {1.5, 0.5}));
+  // Completely inside.
+  EXPECT_TRUE(polygon_intersects_segment(polygon, {0.2, 0.2}, {0.4, 1.6}));
+}
+
+TEST(PolygonMap, Empty) {
+  const env::polygon_map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains({0.0, 0.0}));
+  EXPECT_FALSE(map.intersects({0.0, 0.0}, {1.0, 1.0}));
+  EXPECT_EQ(map.distance({0.0, 0.0}), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(map.distance({0.0, 0.0}, 3.0), 3.0);
+}
+
+TEST(PolygonMap, InvalidPolygon) {
+  ragged_buffer<state_r2> polygons = random_polygons(3, 1);
+  const std::vector<state_r2> segment{{0.0, 0.0}, {1.0, 0.0}};
+  polygons.push_back(span<const state_r2>(segment));
+  EXPECT_THROW(env::polygon_map{polygons}, std::invalid_argument);
+}
+
+TEST(PolygonMap, MatchesBruteForce) {
+  const ragged_buffer<state_r2> polygons = random_polygons(700, 2);
+  const env::polygon_map map(polygons);
+  ASSERT_EQ(map.size(), polygons.size());
+  EXPECT_EQ(map.polygon(5).size(), polygons[5].size());
+
+  const std::vector<state_r2> points = random_points(1500);
+  std::size_t inside = 0;
+  std::size_t crossing = 0;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const state_r2& a = points[i];
+    const state_r2& b = points[(i * 7 + 1) % points.size()];
+    // Short segments only, most long ones hit something.
+    const state_r2 end{a.x + 0.05 * (b.x - a.x), a.y + 0.05 * (b.y - a.y)};
+    bool contains = false;
+    bool intersects = false;
+    double distance = std::numeric_limits<double>::infinity();
+    for (std::size_t p = 0; p < polygons.size(); ++p) {
+      contains = contains || polygon_contains(polygons[p], a);
+      intersects = intersects || polygon_intersects_segment(polygons[p], a, end);
+      distance = std::min(distance, polygon_distance(polygons[p], a));
+    }
+    ASSERT_EQ(map.contains(a), contains) << i;
+    ASSERT_EQ(map.intersects(a, end), intersects) << i;
+    ASSERT_NEAR(map.distance(a), distance, 1e-12) << i;
+    ASSERT_NEAR(map.distance(a, 0.5), std::min(distance, 0.5), 1e-12) << i;
+    inside += contains ? 1 : 0;
+    crossing += intersects ? 1 : 0;
+  }
+  EXPECT_GT(inside, 50U);
+  EXPECT_GT(crossing, inside);
+}
+
+TEST(PolygonMap, Sequences) {
+  const env::polygon_map map(random_polygons(300, 3));
+  const std::vector<state_r2> points = random_points(200);
+  const span<const state_r2> all(points);
+
+  std::vector<std::uint8_t> inside(points.size());
+  std::vector<double> distances(points.size());
+  map.contains(all, span<std::uint8_t>(inside));
+  map.distance(all, span<double>(distances), 4.0);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(inside[i] != 0, map.contains(points[i]));
+    EXPECT_EQ(distances[i], map.distance(points[i], 4.0));
+  }
+
+  // A polyline through the map, its first colliding segment is the first one that intersects.
+  path<state_r2> line;
+  for (int i = 0; i <= 200; ++i) {
+    line.push_back({-2.0 + 0.5 * i, 0.3 * i});
+  }
+  const span<const state_r2> vertices = line.states();
+  const std::size_t first = map.first_intersection(line);
+  ASSERT_LT(first, vertices.size());
+  ASSERT_GT(first, 0U);
+  EXPECT_TRUE(map.intersects(vertices[first - 1], vertices[first]));
+  for (std::size_t i = 1; i < first; ++i) {
+    EXPECT_FALSE(map.intersects(vertices[i - 1], vertices[i]));
+  }
+  EXPECT_EQ(map.first_intersection(vertices.subspan(0, first)), first);
+  EXPECT_EQ(map.first_intersection(span<const state_r2>()), 0U);
+}
+
+} // namespace trailblaze
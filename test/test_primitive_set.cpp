@@ -0,0 +1,176 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/lattice/primitive_set.h"
+#include "trailblaze/math/angle.h"
+
+namespace trailblaze {
+
+namespace {
+
+lattice::primitive_set_config test_config(std::size_t heading_count) {
+  lattice::primitive_set_config config;
+  config.heading_count = heading_count;
+  config.cell_size = 0.5;
+  config.turning_radius = 2.0;
+  config.lengths = {1.0, 2.5};
+  config.sample_step = 0.05;
+  return config;
+}
+
+void expect_equal_sets(const lattice::primitive_set& a, const lattice::primitive_set& b) {
+  ASSERT_EQ(a.heading_count(), b.heading_count());
+  ASSERT_EQ(a.size(), b.size());
+  ASSERT_EQ(a.sample_count(), b.sample_count());
+  EXPECT_EQ(a.cell_size(), b.cell_size());
+  for (std::size_t h = 0; h <= a.heading_count(); ++h) {
+    EXPECT_EQ(a.first_primitive(h), b.first_primitive(h));
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const auto pa = a.primitive(i);
+    const auto pb = b.primitive(i);
+    ASSERT_EQ(pa.size(), pb.size());
+    EXPECT_EQ(pa.end_heading, pb.end_heading);
+    EXPECT_EQ(pa.end_dx, pb.end_dx);
+    EXPECT_EQ(pa.length, pb.length);
+    for (std::size_t k = 0; k < pa.size(); ++k) {
+      EXPECT_EQ(pa.x[k], pb.x[k]);
+      EXPECT_EQ(pa.yaw[k], pb.yaw[k]);
+    }
+  }
+}
+
+} // namespace
+
+TEST(PrimitiveSet, PrimitivesConnectLatticeStates) {
+  for (const std::size_t heading_count : {std::size_t(16), std::size_t(72)}) {
+    const lattice::primitive_set set(test_config(heading_count));
+    EXPECT_EQ(set.first_primitive(0), 0u);
+    EXPECT_EQ(set.first_primitive(heading_count), set.size());
+    for (std::size_t h = 0; h < heading_count; ++h) {
+      ASSERT_GT(set.primitive_count(h), 0u) << "heading " << h;
+      for (std::size_t i = 0; i < set.primitive_count(h); ++i) {
+        const lattice::primitive_view p = set.primitive(h, i);
+        EXPECT_EQ(p.start_heading, h);
+        ASSERT_GE(p.size(), 2u);
+        EXPECT_NEAR(p.x[0], 0.0, 1e-12);
+        EXPECT_NEAR(p.y[0], 0.0, 1e-12);
+        EXPECT_NEAR(normalized(p.yaw[0] - set.heading_yaw(h)), 0.0, 1e-12);
+        EXPECT_EQ(p.x[p.size() - 1], p.end_dx * set.cell_size());
+        EXPECT_EQ(p.y[p.size() - 1], p.end_dy * set.cell_size());
+        EXPECT_EQ(p.yaw[p.size() - 1], set.heading_yaw(p.end_heading));
+        for (std::size_t k = 1; k < p.size(); ++k) {
+          EXPECT_LE(std::hypot(p.x[k] - p.x[k - 1], p.y[k] - p.y[k - 1]), 0.05 + 1e-9);
+        }
+      }
+    }
+  }
+}
+
+TEST(PrimitiveSet, TranslateToStartCell) {
+  const lattice::primitive_set set(test_config(16));
+  const std::size_t index = set.first_primitive(3) + 1;
+  const lattice::primitive_view p = set.primitive(index);
+  std::vector<state_se2> out(p.size());
+  set.translate(index, -4, 7, span<state_se2>(out));
+  for (std::size_t k = 0; k < p.size(); ++k) {
+    EXPECT_DOUBLE_EQ(out[k].x, p.x[k] - 4 * 0.5);
+    EXPECT_DOUBLE_EQ(out[k].y, p.y[k] + 7 * 0.5);
+    EXPECT_EQ(out[k].yaw, p.yaw[k]);
+  }
+}
+
+TEST(PrimitiveSet, InvalidConfigThrows) {
+  auto config = test_config(16);
+  config.heading_count = 0;
+  EXPECT_THROW(lattice::primitive_set{config}, std::invalid_argument);
+  config = test_config(16);
+  config.lengths = {1.0, -1.0};
+  EXPECT_THROW(lattice::primitive_set{config}, std::invalid_argument);
+}
+
+TEST(PrimitiveSet, SerializationRoundTrip) {
+  const lattice::primitive_set set(test_config(72));
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  set.save(stream);
+  const lattice::primitive_set loaded = lattice::primitive_set::load(stream);
+  expect_equal_sets(set, loaded);
+
+  const std::string filename = ::testing::TempDir() + "primitive_set_test.bin";
+  set.save(filename);
+  expect_equal_sets(set, lattice::primitive_set::load(filename));
+}
+
+TEST(PrimitiveSet, LoadRejectsInvalidData) {
+  std::stringstream wrong_magic("XXXX1234");
+  EXPECT_THROW(lattice::primitive_set::load(wrong_magic), std::runtime_error);
+
+  const lattice::primitive_set set(test_config(16));
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  set.save(stream);
+  const std::string data = stream.str();
+  std::stringstream truncated(data.substr(0, data.size() / 2));
+  EXPECT_THROW(lattice::primitive_set::load(truncated), std::runtime_error);
+
+  std::string wrong_version = data;
+  wrong_version[4] = 42;
+  std::stringstream versioned(wrong_version);
+  EXPECT_THROW(lattice::primitive_set::load(versioned), std::runtime_error);
+
+  EXPECT_THROW(lattice::primitive_set::load(std::string("/nonexistent/dir/table.bin")),
+               std::runtime_error);
+}
+
+TEST(PrimitiveSet, LoadRejectsCorruptedSizes) {
+  const lattice::primitive_set set(test_config(16));
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  set.save(stream);
+  const std::string data = stream.str();
+  // Overwrites a value of the header, which starts after the magic and the version.
+  const auto corrupted = [&data](std::size_t offset, auto value) {
+    std::string result = data;
+    std::memcpy(&result[offset], &value, sizeof(value));
+    return result;
+  };
+  const auto load = [](const std::string& bytes) {
+    std::stringstream in(bytes);
+    return lattice::primitive_set::load(in);
+  };
+  constexpr std::size_t header_size = 8 + 3 * sizeof(std::uint64_t) + 2 * sizeof(double);
+  const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+
+  // Sizes that wrap around when adding 1, or that exceed the data.
+  for (const std::size_t offset : {8U, 16U, 24U}) {
+    EXPECT_THROW(static_cast<void>(load(corrupted(offset, max))), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(load(corrupted(offset, std::uint64_t(1) << 39))),
+                 std::runtime_error);
+  }
+  EXPECT_THROW(static_cast<void>(load(corrupted(16, std::uint64_t(1) << 41))),
+               std::runtime_error);
+
+  // A primitive that is stored in the range of another start heading.
+  const std::size_t start_heading_offset =
+      header_size + (set.heading_count() + 1 + set.size() + 1) * sizeof(std::uint64_t);
+  std::uint32_t start_heading = 0;
+  std::memcpy(&start_heading, &data[start_heading_offset], sizeof(start_heading));
+  ASSERT_EQ(start_heading, 0U);
+  EXPECT_THROW(static_cast<void>(load(corrupted(start_heading_offset, std::uint32_t{1}))),
+               std::runtime_error);
+  EXPECT_NO_THROW(static_cast<void>(load(corrupted(start_heading_offset, std::uint32_t{0}))));
+}
+
+} // namespace trailblaze
@@ -0,0 +1,187 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/algorithm/simplify.h"
+#include "trailblaze/environment/ray_caster.h"
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/thread_pool.h"
+
+namespace trailblaze {
+
+namespace {
+
+env::bit_occupancy_grid random_grid() {
+  env::bit_occupancy_grid grid(70, 50, 0.1, {-1.0, 2.0});
+  std::mt19937 rng(6);
+  std::uniform_int_distribution<std::int64_t> x(0, 69);
+  std::uniform_int_distribution<std::int64_t> y(0, 49);
+  for (int i = 0; i < 120; ++i) {
+    grid.set({x(rng), y(rng)}, true);
+  }
+  return grid;
+}
+
+/// Walks along the ray in tiny steps, the distance to the first occupied cell is exact up to
+/// the step length.
+double sampled_range(const env::bit_occupancy_grid& grid, const state_r2& origin, double angle,
+                     double max_range) {
+  constexpr double step = 1e-4;
+  for (double t = 0.0; t <= max_range; t += step) {
+    if (grid.value(grid.cell_of(origin.x + t * std::cos(angle), origin.y + t * std::sin(angle)))) {
+      return t;
+    }
+  }
+  return max_range;
+}
+
+} // namespace
+
+TEST(RayCaster, MatchesSampling) {
+  const env::bit_occupancy_grid grid = random_grid();
+  const env::ray_caster caster(grid);
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<double> x(-0.9, 5.9);
+  std::uniform_real_distribution<double> y(2.1, 6.9);
+  std::uniform_real_distribution<double> angle(-numbers::pi, numbers::pi);
+  std::size_t hits = 0;
+  for (int i = 0; i < 300; ++i) {
+    const state_r2 origin{x(rng), y(rng)};
+    const double direction = angle(rng);
+    const env::ray_hit hit = caster.cast(origin, direction, 2.0);
+    const double expected = sampled_range(grid, origin, direction, 2.0);
+    ASSERT_NEAR(hit.distance, expected, 2e-4) << i;
+    EXPECT_EQ(hit.hit, expected < 2.0);
+    if (hit.hit) {
+      EXPECT_TRUE(grid.value(hit.cell));
+      ++hits;
+    }
+  }
+  EXPECT_GT(hits, 30U);
+}
+
+TEST(RayCaster, AxisAlignedRaysAndBorder) {
+  env::bit_occupancy_grid grid(10, 10, 1.0);
+  grid.set({7, 3}, true);
+  const env::ray_caster caster(grid);
+
+  env::ray_hit hit = caster.cast({2.5, 3.5}, 0.0, 20.0);
+  EXPECT_TRUE(hit.hit);
+  EXPECT_DOUBLE_EQ(hit.distance, 4.5);
+  EXPECT_EQ(hit.cell.x, 7);
+  EXPECT_EQ(hit.cell.y, 3);
+
+  // Out of range.
+  hit = caster.cast({2.5, 3.5}, 0.0, 4.0);
+  EXPECT_FALSE(hit.hit);
+  EXPECT_DOUBLE_EQ(hit.distance, 4.0);
+
+  // Leaving the grid counts as a hit.
+  hit = caster.cast({2.5, 3.5}, numbers::pi_2, 20.0);
+  EXPECT_TRUE(hit.hit);
+  EXPECT_NEAR(hit.distance, 6.5, 1e-12);
+  EXPECT_EQ(hit.cell.y, 10);
+
+  // Starting in an occupied cell or outside.
+  EXPECT_DOUBLE_EQ(caster.cast({7.5, 3.5}, 1.0, 5.0).distance, 0.0);
+  EXPECT_TRUE(caster.cast({-1.0, 3.5}, 0.0, 5.0).hit);
+  EXPECT_TRUE(caster.cast({std::nan(""), 3.5}, 0.0, 5.0).hit);
+  EXPECT_TRUE(caster.cast({1e300, 3.5}, 0.0, 5.0).hit);
+  EXPECT_DOUBLE_EQ(caster.cast({2.5, -1e300}, 1.0, 5.0).distance, 0.0);
+}
+
+TEST(RayCaster, BatchesMatchSingleCasts) {
+  const env::bit_occupancy_grid grid = random_grid();
+  const env::ray_caster caster(grid);
+  thread_pool pool(3);
+
+  std::vector<double> angles(1000);
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    angles[i] = numbers::two_pi * static_cast<double>(i) / static_cast<double>(angles.size());
+  }
+  const state_r2 origin{2.05, 4.55};
+  std::vector<double> serial(angles.size());
+  std::vector<double> parallel(angles.size());
+  caster.cast(origin, span<const double>(angles), 3.0, span<double>(serial));
+  caster.cast(pool, origin, span<const double>(angles), 3.0, span<double>(parallel), 64);
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_EQ(serial[i], caster.cast(origin, angles[i], 3.0).distance);
+    EXPECT_EQ(parallel[i], serial[i]);
+  }
+
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<double> x(-0.9, 5.9);
+  std::uniform_real_distribution<double> y(2.1, 6.9);
+  std::vector<state_r2> from(500);
+  std::vector<state_r2> to(500);
+  for (std::size_t i = 0; i < from.size(); ++i) {
+    from[i] = {x(rng), y(rng)};
+    to[i] = {x(rng), y(rng)};
+  }
+  std::vector<std::uint8_t> free(from.size());
+  std::vector<std::uint8_t> free_parallel(from.size());
+  caster.segments_free(span<const state_r2>(from), span<const state_r2>(to),
+                       span<std::uint8_t>(free));
+  caster.segments_free(pool, span<const state_r2>(from), span<const state_r2>(to),
+                       span<std::uint8_t>(free_parallel), 32);
+  std::size_t free_count = 0;
+  for (std::size_t i = 0; i < from.size(); ++i) {
+    const double length = std::hypot(to[i].x - from[i].x, to[i].y - from[i].y);
+    const double direction = std::atan2(to[i].y - from[i].y, to[i].x - from[i].x);
+    const bool expected = !caster.cast(from[i], direction, length).hit;
+    EXPECT_EQ(free[i] != 0, expected) << i;
+    EXPECT_EQ(free_parallel[i], free[i]);
+    free_count += free[i];
+  }
+  EXPECT_GT(free_count, 10U);
+  EXPECT_LT(free_count, 490U);
+}
+
+TEST(RayCaster, PolylinesAndShortcuts) {
+  // A wall with a gap at the top.
+  env::bit_occupancy_grid grid(40, 40, 0.25);
+  for (std::int64_t y = 0; y < 30; ++y) {
+    grid.set({20, y}, true);
+  }
+  const env::ray_caster caster(grid);
+
+  // Dense path up, over the wall through the gap and down again.
+  path<state_r2> states;
+  for (int i = 0; i <= 40; ++i) {
+    states.push_back({2.0, 1.0 + 0.2 * i});
+  }
+  for (int i = 1; i <= 40; ++i) {
+    states.push_back({2.0 + 0.15 * i, 9.0});
+  }
+  for (int i = 1; i <= 40; ++i) {
+    states.push_back({8.0, 9.0 - 0.2 * i});
+  }
+  ASSERT_EQ(caster.first_intersection(states), states.size());
+
+  std::vector<state_r2> shortened;
+  simplify::shortcut(
+      states.states(),
+      [&](const state_r2& a, const state_r2& b) { return caster.segment_free(a, b); },
+      std::back_inserter(shortened));
+  EXPECT_LT(shortened.size(), 6U);
+  EXPECT_EQ(caster.first_intersection(span<const state_r2>(shortened)), shortened.size());
+
+  // Straight through the wall.
+  const std::vector<state_r2> blocked{{2.0, 1.0}, {3.0, 1.0}, {8.0, 1.0}};
+  EXPECT_EQ(caster.first_intersection(span<const state_r2>(blocked)), 2U);
+  const std::vector<state_r2> inside{{5.1, 1.0}, {6.0, 1.0}};
+  EXPECT_EQ(caster.first_intersection(span<const state_r2>(inside)), 0U);
+  EXPECT_EQ(caster.first_intersection(span<const state_r2>()), 0U);
+}
+
+} // namespace trailblaze
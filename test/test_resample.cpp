@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/algorithm/resample.h"
+#include "trailblaze/path.h"
+#include "trailblaze/sampling.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+path<state_se2> make_test_path() {
+  path<state_se2> p;
+  p.push_back({0., 0., 0.});
+  p.push_back({1., 0., 3.});
+  p.push_back({1., 0., 3.}); // zero-length segment
+  p.push_back({3., 2., -3.});
+  p.push_back({3.05, 2., -2.9});
+  return p;
+}
+
+} // namespace
+
+TEST(Resample, BySpacingKeepsEndpoints) {
+  const path<state_se2> input = make_test_path();
+  std::vector<state_se2> out;
+  const std::size_t count = resample(input.states(), 0.1, std::back_inserter(out));
+
+  ASSERT_EQ(count, out.size());
+  ASSERT_GE(out.size(), 2u);
+  EXPECT_DOUBLE_EQ(out.front().x, input.start().x);
+  EXPECT_DOUBLE_EQ(out.back().x, input.goal().x);
+  EXPECT_DOUBLE_EQ(out.back().y, input.goal().y);
+}
+
+TEST(Resample, BatchInterpolationMatchesSingleInterpolation) {
+  const path<state_se2> input = make_test_path();
+  using space = state_space<state_se2>;
+  const auto single = [](const state_se2& a, const state_se2& b, double t) {
+    return space::interpolation_type{}(a, b, t);
+  };
+  static_assert(!is_batch_interpolator_v<decltype(single), state_se2>);
+  static_assert(is_batch_interpolator_v<space::interpolation_type, state_se2>);
+
+  std::vector<state_se2> batched;
+  std::vector<state_se2> reference;
+  resample(input.states(), 0.07, std::back_inserter(batched), space::metric_type{},
+           space::interpolation_type{});
+  resample(input.states(), 0.07, std::back_inserter(reference), space::metric_type{}, single);
+
+  ASSERT_EQ(batched.size(), reference.size());
+  for (std::size_t i = 0; i < batched.size(); ++i) {
+    EXPECT_NEAR(batched[i].x, reference[i].x, 1e-12);
+    EXPECT_NEAR(batched[i].y, reference[i].y, 1e-12);
+    EXPECT_NEAR(batched[i].yaw, reference[i].yaw, 1e-12);
+  }
+}
+
+TEST(Resample, ByCountPlacesEvenlySpacedSamples) {
+  path<state_r2> input;
+  input.push_back({0., 0.});
+  input.push_back({1., 0.});
+  input.push_back({1., 0.}); // zero-length segment
+  input.push_back({1., 2.});
+  input.push_back({1., 3.});
+
+  for (const std::size_t n : {2u, 3u, 5u, 7u, 101u}) {
+    std::vector<state_r2> out;
+    const std::size_t count =
+        resample(input.states(), sampling::by_count{n}, std::back_inserter(out));
+    ASSERT_EQ(count, n);
+    ASSERT_EQ(out.size(), n);
+    EXPECT_EQ(out.front().x, input.start().x);
+    EXPECT_EQ(out.back().y, input.goal().y);
+
+    // Total length is 4, so consecutive samples are 4 / (n - 1) apart along the path.
+    const double spacing = 4.0 / static_cast<double>(n - 1);
+    for (std::size_t k = 0; k < n; ++k) {
+      const double arc_length = static_cast<double>(k) * spacing;
+      const double expected_x = std::min(arc_length, 1.0);
+      const double expected_y = std::max(arc_length - 1.0, 0.0);
+      EXPECT_NEAR(out[k].x, expected_x, 1e-12);
+      EXPECT_NEAR(out[k].y, expected_y, 1e-12);
+    }
+  }
+}
+
+TEST(Resample, ByCountHandlesDegenerateInputs) {
+  path<state_se2> input;
+  std::vector<state_se2> out;
+  EXPECT_EQ(resample(input.states(), sampling::by_count{5}, std::back_inserter(out)), 0u);
+
+  input.push_back({1., 1., 0.5});
+  input.push_back({1., 1., 0.7});
+  EXPECT_EQ(resample(input.states(), sampling::by_count{0}, std::back_inserter(out)), 0u);
+  EXPECT_EQ(resample(input.states(), sampling::by_count{4}, std::back_inserter(out)), 4u);
+  ASSERT_EQ(out.size(), 4u);
+  EXPECT_DOUBLE_EQ(out[2].yaw, 0.5);
+  EXPECT_DOUBLE_EQ(out[3].yaw, 0.7);
+}
+
+} // namespace trailblaze
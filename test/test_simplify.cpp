@@ -0,0 +1,128 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/algorithm/simplify.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// Dense samples of a straight line, a right angle turn and another straight line.
+path<state_se2> make_corner_path() {
+  path<state_se2> p;
+  for (int i = 0; i <= 100; ++i) {
+    p.push_back({0.01 * i, 0.0, 0.0});
+  }
+  for (int i = 1; i <= 100; ++i) {
+    p.push_back({1.0, 0.01 * i, 1.5});
+  }
+  return p;
+}
+
+} // namespace
+
+TEST(Simplify, DouglasPeuckerKeepsCornersOnly) {
+  const path<state_se2> input = make_corner_path();
+  std::vector<std::size_t> indices;
+  const std::size_t count =
+      simplify::douglas_peucker_indices(input.states(), 1e-6, std::back_inserter(indices));
+
+  ASSERT_EQ(count, 3u);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{0, 100, 200}));
+
+  std::vector<state_se2> states;
+  simplify::douglas_peucker(input.states(), 1e-6, std::back_inserter(states));
+  ASSERT_EQ(states.size(), 3u);
+  // All components of retained states are preserved.
+  EXPECT_DOUBLE_EQ(states[1].x, 1.0);
+  EXPECT_DOUBLE_EQ(states[1].yaw, 0.0);
+  EXPECT_DOUBLE_EQ(states[2].yaw, 1.5);
+}
+
+TEST(Simplify, DouglasPeuckerRespectsTolerance) {
+  path<state_se2> input;
+  for (int i = 0; i <= 2000; ++i) {
+    const double t = 0.005 * i;
+    input.push_back({t, std::sin(t), 0.0});
+  }
+  const double tolerance = 0.01;
+  std::vector<std::size_t> indices;
+  simplify::douglas_peucker_indices(input.states(), tolerance, std::back_inserter(indices));
+  EXPECT_LT(indices.size(), input.size() / 10);
+
+  // Every dropped state lies within the tolerance of the simplified polyline.
+  for (std::size_t k = 1; k < indices.size(); ++k) {
+    const state_se2& a = input[indices[k - 1]];
+    const state_se2& b = input[indices[k]];
+    for (std::size_t i = indices[k - 1] + 1; i < indices[k]; ++i) {
+      const double distance_sq = simplify::detail::squared_segment_distance(
+          input[i].x, input[i].y, a.x, a.y, b.x, b.y);
+      EXPECT_LE(std::sqrt(distance_sq), tolerance);
+    }
+  }
+}
+
+TEST(Simplify, VisvalingamWhyattDropsSmallTriangles) {
+  const path<state_se2> input = make_corner_path();
+  std::vector<std::size_t> indices;
+  simplify::visvalingam_whyatt_indices(input.states(), 1e-6, std::back_inserter(indices));
+  EXPECT_EQ(indices, (std::vector<std::size_t>{0, 100, 200}));
+
+  // A large threshold removes the corner as well.
+  std::vector<state_se2> states;
+  simplify::visvalingam_whyatt(input.states(), 1.0, std::back_inserter(states));
+  ASSERT_EQ(states.size(), 2u);
+  EXPECT_DOUBLE_EQ(states.back().yaw, 1.5);
+}
+
+TEST(Simplify, SmallInputsAreKept) {
+  path<state_se2> input;
+  std::vector<std::size_t> indices;
+  EXPECT_EQ(simplify::douglas_peucker_indices(input.states(), 1.0, std::back_inserter(indices)),
+            0u);
+  input.push_back({0., 0., 0.});
+  input.push_back({1., 1., 0.});
+  EXPECT_EQ(
+      simplify::visvalingam_whyatt_indices(input.states(), 10.0, std::back_inserter(indices)),
+      2u);
+}
+
+TEST(Simplify, ShortcutKeepsLastReachableStates) {
+  const path<state_se2> input = make_corner_path();
+  // Segments may not cut the corner, i.e. both ends have to lie on the same leg.
+  std::size_t checks = 0;
+  const auto same_leg = [&](const state_se2& a, const state_se2& b) {
+    ++checks;
+    return (a.y == 0.0 && b.y == 0.0) || (a.x == 1.0 && b.x == 1.0);
+  };
+  std::vector<std::size_t> indices;
+  EXPECT_EQ(simplify::shortcut_indices(input.states(), same_leg, std::back_inserter(indices)),
+            3u);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{0, 100, 200}));
+  EXPECT_EQ(checks, input.size() - 2);
+
+  std::vector<state_se2> states;
+  simplify::shortcut(input.states(), same_leg, std::back_inserter(states));
+  ASSERT_EQ(states.size(), 3u);
+  EXPECT_DOUBLE_EQ(states[2].yaw, 1.5);
+
+  // Everything is reachable directly.
+  indices.clear();
+  simplify::shortcut_indices(
+      input.states(), [](const state_se2&, const state_se2&) { return true; },
+      std::back_inserter(indices));
+  EXPECT_EQ(indices, (std::vector<std::size_t>{0, 200}));
+}
+
+} // namespace trailblaze
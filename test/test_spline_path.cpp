@@ -0,0 +1,136 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/math/numbers.h"
+#include "trailblaze/path.h"
+#include "trailblaze/spline_path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+
+namespace trailblaze {
+
+namespace {
+
+path<state_r2> make_zigzag() {
+  path<state_r2> p;
+  p.push_back({0., 0.});
+  p.push_back({1., 1.});
+  p.push_back({2., 0.5});
+  p.push_back({4., 2.});
+  p.push_back({5., 0.});
+  return p;
+}
+
+/// Samples of a circle with radius @p radius, counterclockwise, with tangent yaw.
+path<state_se2> make_circle_arc(double radius, std::size_t n) {
+  path<state_se2> p;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double angle = numbers::pi * static_cast<double>(i) / static_cast<double>(n - 1);
+    p.push_back({radius * std::cos(angle), radius * std::sin(angle), angle + numbers::pi_2});
+  }
+  return p;
+}
+
+} // namespace
+
+TEST(SplinePath, InterpolatesAllStates) {
+  const path<state_r2> input = make_zigzag();
+  for (const spline_type type : {spline_type::natural, spline_type::clamped,
+                                 spline_type::catmull_rom, spline_type::centripetal}) {
+    const spline_path spline(input, type);
+    ASSERT_EQ(spline.segment_count(), input.size() - 1);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      const state_r2 position = spline.position(static_cast<double>(i));
+      EXPECT_NEAR(position.x, input[i].x, 1e-12);
+      EXPECT_NEAR(position.y, input[i].y, 1e-12);
+    }
+  }
+}
+
+TEST(SplinePath, NaturalSplineHasZeroEndCurvature) {
+  const spline_path spline(make_zigzag(), spline_type::natural);
+  EXPECT_NEAR(spline.curvature(0.0), 0.0, 1e-12);
+  EXPECT_NEAR(spline.curvature(static_cast<double>(spline.segment_count())), 0.0, 1e-12);
+}
+
+TEST(SplinePath, InterpolatingSplinesAreC2) {
+  for (const spline_type type : {spline_type::natural, spline_type::clamped}) {
+    const spline_path spline(make_zigzag(), type);
+    for (std::size_t i = 1; i < spline.segment_count(); ++i) {
+      const double knot = static_cast<double>(i);
+      EXPECT_NEAR(spline.state(knot - 1e-9).yaw, spline.state(knot).yaw, 1e-6);
+      EXPECT_NEAR(spline.curvature(knot - 1e-9), spline.curvature(knot), 1e-6);
+    }
+  }
+}
+
+TEST(SplinePath, ClampedSplineUsesEndYaw) {
+  const path<state_se2> arc = make_circle_arc(2.0, 9);
+  const spline_path spline(arc, spline_type::clamped);
+  EXPECT_NEAR(spline.state(0.0).yaw, arc.start().yaw, 1e-12);
+  EXPECT_NEAR(spline.state(8.0).yaw, arc.goal().yaw - 2.0 * numbers::pi, 1e-12);
+}
+
+TEST(SplinePath, BatchEvaluationFollowsCircle) {
+  const double radius = 2.0;
+  const path<state_se2> arc = make_circle_arc(radius, 33);
+  const spline_path spline(arc, spline_type::clamped);
+
+  std::vector<double> params;
+  for (double s = 0.5; s < 31.5; s += 0.25) {
+    params.push_back(s);
+  }
+  std::vector<state_se2> states(params.size());
+  std::vector<double> curvatures(params.size());
+  spline.states(span<const double>(params), span<state_se2>(states));
+  spline.curvatures(span<const double>(params), span<double>(curvatures));
+
+  for (std::size_t k = 0; k < params.size(); ++k) {
+    EXPECT_NEAR(std::hypot(states[k].x, states[k].y), radius, 1e-5);
+    const double expected_yaw = std::atan2(states[k].x, -states[k].y);
+    EXPECT_NEAR(std::remainder(states[k].yaw - expected_yaw, 2.0 * numbers::pi), 0.0, 1e-4);
+    EXPECT_NEAR(curvatures[k], 1.0 / radius, 1e-2);
+    EXPECT_DOUBLE_EQ(spline.state(params[k]).x, states[k].x);
+  }
+}
+
+TEST(SplinePath, RejectsTooFewStates) {
+  path<state_r2> input;
+  input.push_back({0., 0.});
+  EXPECT_THROW(spline_path(input, spline_type::natural), std::invalid_argument);
+}
+
+TEST(SplinePath, RejectsRepeatedStates) {
+  path<state_r2> input = make_zigzag();
+  input.push_back(input.goal());
+  for (const spline_type type : {spline_type::natural, spline_type::clamped,
+                                 spline_type::catmull_rom, spline_type::centripetal}) {
+    EXPECT_THROW(spline_path(input, type), std::invalid_argument);
+  }
+}
+
+TEST(SplinePath, NotANumberParameter) {
+  const spline_path spline(make_zigzag(), spline_type::natural);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const state_r2 position = spline.position(nan);
+  EXPECT_TRUE(std::isnan(position.x));
+  EXPECT_TRUE(std::isnan(position.y));
+  EXPECT_TRUE(std::isnan(spline.curvature(nan)));
+
+  const std::vector<double> params{nan, 1.0};
+  std::vector<state_se2> states(params.size());
+  spline.states(span<const double>(params), span<state_se2>(states));
+  EXPECT_TRUE(std::isnan(states[0].x));
+  EXPECT_DOUBLE_EQ(states[1].x, 1.0);
+}
+
+} // namespace trailblaze
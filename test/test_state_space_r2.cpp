@@ -2,6 +2,8 @@
  * Copyright(c) 2024-present, Sebastian Klemm & contributors.
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "trailblaze/component_access.h"
@@ -53,4 +55,20 @@ TEST(StateSpaces, SpaceR2LinearInterpolation) {
   EXPECT_NEAR(comp::y(result), 10., linear_interpolation_accuracy);
 }
 
+TEST(StateSpaces, SpaceR2BatchInterpolationMatchesSingle) {
+  typename state_space<state_r2>::interpolation_type interpolator;
+
+  const state_r2 start{-1., 2.};
+  const state_r2 goal{3., -5.};
+  const std::vector<double> ratios = {0., 0.1, 0.25, 0.5, 0.9, 1., 1.5};
+  std::vector<state_r2> batch(ratios.size());
+  interpolator(start, goal, span<const double>(ratios), span<state_r2>(batch));
+
+  for (std::size_t i = 0; i < ratios.size(); ++i) {
+    const state_r2 single = interpolator(start, goal, ratios[i]);
+    EXPECT_DOUBLE_EQ(batch[i].x, single.x);
+    EXPECT_DOUBLE_EQ(batch[i].y, single.y);
+  }
+}
+
 } // namespace trailblaze
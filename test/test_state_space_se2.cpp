@@ -2,6 +2,8 @@
  * Copyright(c) 2024-present, Sebastian Klemm & contributors.
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  * ------------------------------------------------------------------------- */
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "trailblaze/component_access.h"
@@ -59,4 +61,24 @@ TEST(StateSpaces, SpaceSE2LinearInterpolation) {
   EXPECT_NEAR(comp::yaw(result), .5, linear_interpolation_accuracy);
 }
 
+TEST(StateSpaces, SpaceSE2BatchInterpolationMatchesSingle) {
+  typename state_space<state_se2>::interpolation_type interpolation;
+
+  // The yaw interpolation wraps around +-Pi.
+  const state_se2 start{0., 0., 3.};
+  const state_se2 goal{10., -4., -3.};
+  for (const std::vector<double>& ratios :
+       {std::vector<double>{0., 0.2, 0.4, 0.5, 0.6, 0.8, 1.}, std::vector<double>{-0.5, 0.5, 2.}}) {
+    std::vector<state_se2> batch(ratios.size());
+    interpolation(start, goal, span<const double>(ratios), span<state_se2>(batch));
+
+    for (std::size_t i = 0; i < ratios.size(); ++i) {
+      const state_se2 single = interpolation(start, goal, ratios[i]);
+      EXPECT_NEAR(batch[i].x, single.x, 1e-12);
+      EXPECT_NEAR(batch[i].y, single.y, 1e-12);
+      EXPECT_NEAR(batch[i].yaw, single.yaw, 1e-12);
+    }
+  }
+}
+
 } // namespace trailblaze
@@ -0,0 +1,115 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <stdexcept>
+#include <type_traits>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/span.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+#include "trailblaze/state_spaces/state_space_se2.h"
+#include "trailblaze/trajectory.h"
+
+namespace trailblaze {
+
+namespace {
+
+trajectory<state_r2> make_test_trajectory() {
+  trajectory<state_r2> traj;
+  traj.push_back(1.0, {0., 0.});
+  traj.push_back(2.0, {1., 0.});
+  traj.push_back(2.5, {1., 2.});
+  traj.push_back(4.0, {-2., 2.});
+  return traj;
+}
+
+} // namespace
+
+TEST(Trajectory, RejectsNonIncreasingTimestamps) {
+  trajectory<state_r2> traj;
+  traj.push_back(0.0, {0., 0.});
+  EXPECT_THROW(traj.push_back(0.0, {1., 0.}), std::invalid_argument);
+  EXPECT_THROW(traj.push_back(-1.0, {1., 0.}), std::invalid_argument);
+  EXPECT_EQ(traj.size(), 1u);
+}
+
+TEST(Trajectory, SetTimeKeepsTimestampsIncreasing) {
+  trajectory<state_r2> traj = make_test_trajectory();
+  static_assert(std::is_same_v<decltype(traj.times()), span<const double>>,
+                "timestamps are only changed through set_time");
+  traj.set_time(1, 1.5);
+  traj.set_time(0, -1.0);
+  traj.set_time(3, 10.0);
+  EXPECT_DOUBLE_EQ(traj.times()[1], 1.5);
+  EXPECT_DOUBLE_EQ(traj.duration(), 11.0);
+  EXPECT_THROW(traj.set_time(1, 2.5), std::invalid_argument);
+  EXPECT_THROW(traj.set_time(2, 1.5), std::invalid_argument);
+  EXPECT_THROW(traj.set_time(3, 2.0), std::invalid_argument);
+  EXPECT_THROW(traj.set_time(4, 20.0), std::out_of_range);
+  EXPECT_DOUBLE_EQ(traj.times()[2], 2.5);
+}
+
+TEST(Trajectory, StateLookupInterpolatesAndClamps) {
+  const trajectory<state_r2> traj = make_test_trajectory();
+  EXPECT_DOUBLE_EQ(traj.duration(), 3.0);
+
+  std::size_t hint = 0;
+  state_r2 state = traj.state_at(1.5, hint);
+  EXPECT_DOUBLE_EQ(state.x, 0.5);
+  EXPECT_EQ(hint, 0u);
+
+  state = traj.state_at(2.25, hint);
+  EXPECT_DOUBLE_EQ(state.x, 1.0);
+  EXPECT_DOUBLE_EQ(state.y, 1.0);
+  EXPECT_EQ(hint, 1u);
+
+  // Jumping backwards with a stale hint still finds the segment.
+  state = traj.state_at(1.25, hint);
+  EXPECT_DOUBLE_EQ(state.x, 0.25);
+  EXPECT_EQ(hint, 0u);
+
+  state = traj.state_at(3.25, hint);
+  EXPECT_DOUBLE_EQ(state.x, -0.5);
+  EXPECT_EQ(hint, 2u);
+
+  EXPECT_DOUBLE_EQ(traj.state_at(-5.0).x, 0.0);
+  EXPECT_DOUBLE_EQ(traj.state_at(10.0).x, -2.0);
+}
+
+TEST(Trajectory, ResampleByTimeUsesFixedRate) {
+  const trajectory<state_r2> traj = make_test_trajectory();
+  const trajectory<state_r2> resampled = resample_by_time(traj, 0.01);
+
+  ASSERT_EQ(resampled.size(), 301u);
+  std::size_t hint = 0;
+  for (std::size_t i = 0; i < resampled.size(); ++i) {
+    const double time = 1.0 + static_cast<double>(i) * 0.01;
+    EXPECT_DOUBLE_EQ(resampled.times()[i], time);
+    const state_r2 expected = traj.state_at(time, hint);
+    EXPECT_NEAR(resampled.states()[i].x, expected.x, 1e-12);
+    EXPECT_NEAR(resampled.states()[i].y, expected.y, 1e-12);
+  }
+  EXPECT_NEAR(resampled.states()[300].x, -2.0, 1e-12);
+
+  // The end state is dropped if the duration is not a multiple of the step.
+  EXPECT_EQ(resample_by_time(traj, 0.7).size(), 5u);
+  EXPECT_THROW(resample_by_time(traj, 0.0), std::invalid_argument);
+}
+
+TEST(Trajectory, ResampleByTimeInterpolatesYaw) {
+  trajectory<state_se2> traj;
+  traj.push_back(0.0, {0., 0., 3.});
+  traj.push_back(1.0, {1., 0., -3.});
+  const trajectory<state_se2> resampled = resample_by_time(traj, 0.25);
+
+  ASSERT_EQ(resampled.size(), 5u);
+  for (std::size_t i = 0; i < resampled.size(); ++i) {
+    const state_se2 expected = traj.state_at(resampled.times()[i]);
+    EXPECT_NEAR(resampled.states()[i].yaw, expected.yaw, 1e-12);
+  }
+}
+
+} // namespace trailblaze
@@ -0,0 +1,114 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/generate/dubins.h"
+#include "trailblaze/generate/reeds_shepp.h"
+#include "trailblaze/math/angle.h"
+#include "trailblaze/math/numbers.h"
+
+namespace trailblaze {
+
+namespace {
+
+std::vector<state_se2> random_goals(std::size_t n) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> yaw(-numbers::pi, numbers::pi);
+  std::vector<state_se2> out(n);
+  for (auto& goal : out) {
+    goal = {position(generator), position(generator), yaw(generator)};
+  }
+  return out;
+}
+
+void expect_reaches(const state_se2& reached, const state_se2& goal) {
+  EXPECT_NEAR(reached.x, goal.x, 1e-6);
+  EXPECT_NEAR(reached.y, goal.y, 1e-6);
+  EXPECT_NEAR(normalized(reached.yaw - goal.yaw), 0.0, 1e-6);
+}
+
+} // namespace
+
+TEST(TurningCurves, DubinsReachesGoal) {
+  const state_se2 start{1.0, -2.0, 0.3};
+  for (const state_se2& goal : random_goals(500)) {
+    const gen::turning_curve curve = gen::dubins_curve(start, goal, 1.5);
+    expect_reaches(curve.state_at(start, curve.length()), goal);
+    for (std::size_t i = 0; i < curve.segment_count; ++i) {
+      EXPECT_GE(curve.segments[i].length, 0.0);
+    }
+    EXPECT_NEAR(gen::dubins_distance(start, goal, 1.5), curve.length(), 1e-9);
+  }
+}
+
+TEST(TurningCurves, ReedsSheppReachesGoal) {
+  const state_se2 start{1.0, -2.0, 0.3};
+  for (const state_se2& goal : random_goals(500)) {
+    const gen::turning_curve curve = gen::reeds_shepp_curve(start, goal, 1.5);
+    expect_reaches(curve.state_at(start, curve.length()), goal);
+    EXPECT_NEAR(gen::reeds_shepp_distance(start, goal, 1.5), curve.length(), 1e-9);
+  }
+}
+
+TEST(TurningCurves, ReedsSheppIsNeverLongerThanDubins) {
+  const state_se2 start{0.0, 0.0, 0.0};
+  for (const state_se2& goal : random_goals(500)) {
+    EXPECT_LE(gen::reeds_shepp_distance(start, goal, 2.0),
+              gen::dubins_distance(start, goal, 2.0) + 1e-9);
+  }
+}
+
+TEST(TurningCurves, KnownDistances) {
+  const state_se2 start{0.0, 0.0, 0.0};
+  // Straight ahead.
+  EXPECT_NEAR(gen::dubins_distance(start, {5.0, 0.0, 0.0}, 1.0), 5.0, 1e-9);
+  EXPECT_NEAR(gen::reeds_shepp_distance(start, {5.0, 0.0, 0.0}, 1.0), 5.0, 1e-9);
+  // Straight back: Reeds-Shepp reverses, Dubins has to turn around.
+  EXPECT_NEAR(gen::reeds_shepp_distance(start, {-5.0, 0.0, 0.0}, 1.0), 5.0, 1e-9);
+  EXPECT_GT(gen::dubins_distance(start, {-5.0, 0.0, 0.0}, 1.0), 5.0 + numbers::pi);
+  // Quarter circle to the left.
+  EXPECT_NEAR(gen::dubins_distance(start, {2.0, 2.0, numbers::pi_2}, 2.0), numbers::pi, 1e-9);
+}
+
+TEST(TurningCurves, BatchDistancesMatchSingleCalls) {
+  const state_se2 start{-1.0, 3.0, 2.0};
+  const std::vector<state_se2> goals = random_goals(100);
+  std::vector<double> dubins(goals.size());
+  std::vector<double> reeds_shepp(goals.size());
+  gen::dubins_distance(start, span<const state_se2>(goals), 0.8, span<double>(dubins));
+  gen::reeds_shepp_distance(start, span<const state_se2>(goals), 0.8, span<double>(reeds_shepp));
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    EXPECT_EQ(dubins[i], gen::dubins_distance(start, goals[i], 0.8));
+    EXPECT_EQ(reeds_shepp[i], gen::reeds_shepp_distance(start, goals[i], 0.8));
+  }
+}
+
+TEST(TurningCurves, SamplingPolicies) {
+  const state_se2 start{0.0, 0.0, 0.0};
+  const state_se2 goal{3.0, 4.0, -1.0};
+
+  const path<state_se2> by_count = gen::dubins(start, goal, 1.0, sampling::by_count{25});
+  ASSERT_EQ(by_count.size(), 25u);
+  expect_reaches(by_count[0], start);
+  expect_reaches(by_count[24], goal);
+
+  const double length = gen::reeds_shepp_distance(start, goal, 1.0);
+  const path<state_se2> by_step = gen::reeds_shepp(start, goal, 1.0, sampling::by_step{0.1});
+  ASSERT_EQ(by_step.size(), static_cast<std::size_t>(std::ceil(length / 0.1)) + 1);
+  expect_reaches(by_step[0], start);
+  expect_reaches(by_step[by_step.size() - 1], goal);
+  for (std::size_t i = 1; i + 1 < by_step.size(); ++i) {
+    EXPECT_LE(std::hypot(by_step[i].x - by_step[i - 1].x, by_step[i].y - by_step[i - 1].y),
+              0.1 + 1e-9);
+  }
+}
+
+} // namespace trailblaze
@@ -0,0 +1,187 @@
+/* ------------------------------------------------------------------------
+ * Copyright(c) 2024-present, Sebastian Klemm & contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ * ------------------------------------------------------------------------- */
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+// external
+#include <gtest/gtest.h>
+
+#include "trailblaze/kinematics/velocity_profile.h"
+#include "trailblaze/path.h"
+#include "trailblaze/state_spaces/state_space_r2.h"
+
+namespace trailblaze {
+
+namespace {
+
+/// A straight line along x with @p count states @p step apart.
+path<state_r2> straight(std::size_t count, double step) {
+  path<state_r2> states;
+  for (std::size_t i = 0; i < count; ++i) {
+    states.push_back({static_cast<double>(i) * step, 0.0});
+  }
+  return states;
+}
+
+} // namespace
+
+TEST(VelocityProfile, StraightLine) {
+  velocity_limits limits;
+  limits.max_speed = 2.0;
+  limits.max_acceleration = 1.0;
+  limits.max_deceleration = 0.5;
+  velocity_profile profile(limits);
+  // 100 m: accelerate over 2 m, cruise, brake over the last 4 m.
+  const path<state_r2> states = straight(1001, 0.1);
+  profile.compute(states);
+  ASSERT_EQ(profile.size(), states.size());
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    const double s = states[i].x;
+    const double expected = std::min({std::sqrt(2.0 * s), 2.0, std::sqrt(100.0 - s)});
+    EXPECT_NEAR(profile.speeds()[i], expected, 1e-9);
+  }
+  EXPECT_NEAR(profile.duration(), 2.0 + 47.0 + 4.0, 1e-6);
+  EXPECT_EQ(profile.times()[0], 0.0);
+
+  profile.compute(straight(1, 0.1));
+  EXPECT_EQ(profile.size(), 1U);
+  EXPECT_EQ(profile.duration(), 0.0);
+
+  limits.max_acceleration = 0.0;
+  EXPECT_THROW(velocity_profile{limits}, std::invalid_argument);
+  limits.max_acceleration = 1.0;
+  limits.start_speed = -1.0;
+  EXPECT_THROW(velocity_profile{limits}, std::invalid_argument);
+}
+
+TEST(VelocityProfile, CurvatureAndCusps) {
+  velocity_limits limits;
+  limits.max_speed = 3.0;
+  limits.max_acceleration = 10.0;
+  limits.max_deceleration = 10.0;
+  limits.max_lateral_acceleration = 0.8;
+  limits.start_speed = 3.0;
+  limits.end_speed = 3.0;
+  // A straight line, then a quarter circle with radius 5, which allows sqrt(0.8 * 5) = 2 m/s.
+  path<state_r2> states = straight(100, 0.1);
+  const double x0 = states.goal().x;
+  for (std::size_t i = 1; i <= 78; ++i) {
+    const double angle = static_cast<double>(i) * 0.02;
+    states.push_back({x0 + 5.0 * std::sin(angle), 5.0 * (1.0 - std::cos(angle))});
+  }
+  velocity_profile profile(limits);
+  profile.compute(states);
+  EXPECT_NEAR(profile.speeds()[0], 3.0, 1e-12);
+  EXPECT_NEAR(profile.speeds()[120], 2.0, 1e-9);
+  // The end speed is an upper bound, the last state is reached by accelerating from the arc.
+  EXPECT_NEAR(profile.speeds()[states.size() - 1], std::sqrt(4.0 + 2.0 * 10.0 * 0.1), 1e-4);
+  EXPECT_LT(profile.speeds()[99], 3.0);
+  EXPECT_GT(profile.speeds()[99], 2.0);
+
+  // Driving back along the line stops at the cusp.
+  path<state_r2> cusp = straight(50, 0.1);
+  cusp.push_back({4.8, 0.0});
+  cusp.push_back({4.7, 0.0});
+  profile.compute(cusp);
+  EXPECT_EQ(profile.speeds()[49], 0.0);
+  EXPECT_GT(profile.times()[50], profile.times()[49]);
+
+  // From rest to rest: accelerate over half of the segment, brake over the other half.
+  limits.max_speed = 5.0;
+  limits.max_acceleration = 1.0;
+  limits.max_deceleration = 1.0;
+  limits.start_speed = 0.0;
+  limits.end_speed = 0.0;
+  velocity_profile stops(limits);
+  path<state_r2> segment = straight(2, 1.0);
+  stops.compute(segment);
+  EXPECT_EQ(stops.speeds()[0], 0.0);
+  EXPECT_EQ(stops.speeds()[1], 0.0);
+  EXPECT_NEAR(stops.duration(), 2.0, 1e-12);
+  segment.push_back({0.0, 0.0});
+  stops.compute(segment);
+  EXPECT_EQ(stops.speeds()[1], 0.0);
+  EXPECT_NEAR(stops.times()[1], 2.0, 1e-12);
+  EXPECT_NEAR(stops.duration(), 4.0, 1e-12);
+  // Different limits: 1 m at a = 1, d = 3 takes sqrt(2 * (1 + 1/3)).
+  limits.max_deceleration = 3.0;
+  velocity_profile asymmetric(limits);
+  asymmetric.compute(straight(2, 1.0));
+  EXPECT_NEAR(asymmetric.duration(), std::sqrt(2.0 * (1.0 + 1.0 / 3.0)), 1e-12);
+}
+
+TEST(VelocityProfile, LongSegments) {
+  // 100 m in one segment at a = d = 1 and v_max = 1: 1 s to accelerate over 0.5 m, 99 s at
+  // the maximum speed, 1 s to brake over 0.5 m.
+  velocity_limits limits;
+  limits.max_speed = 1.0;
+  velocity_profile stops(limits);
+  stops.compute(straight(2, 100.0));
+  EXPECT_NEAR(stops.duration(), 101.0, 1e-9);
+
+  // Almost stopping at both ends takes the same time, not the length over the mean speed.
+  limits.start_speed = 1e-3;
+  limits.end_speed = 1e-3;
+  velocity_profile slow(limits);
+  slow.compute(straight(2, 100.0));
+  EXPECT_NEAR(slow.speeds()[0], 1e-3, 1e-12);
+  EXPECT_NEAR(slow.speeds()[1], 1e-3, 1e-12);
+  EXPECT_NEAR(slow.duration(), 2.0 * 0.999 + 100.0 - (1.0 - 1e-6), 1e-9);
+
+  // Without reaching the maximum speed: 2 m between stops peak at 1.4 m/s.
+  limits.max_speed = 5.0;
+  limits.start_speed = 0.0;
+  limits.end_speed = 0.0;
+  velocity_profile short_segment(limits);
+  short_segment.compute(straight(2, 2.0));
+  EXPECT_NEAR(short_segment.duration(), 2.0 * std::sqrt(2.0), 1e-12);
+}
+
+TEST(VelocityProfile, IncrementalUpdateMatchesFullComputation) {
+  velocity_limits limits;
+  limits.max_speed = 5.0;
+  limits.max_acceleration = 1.0;
+  limits.max_deceleration = 2.0;
+  limits.max_lateral_acceleration = 1.0;
+  path<state_r2> states = straight(2000, 0.1);
+  velocity_profile incremental(limits);
+  incremental.compute(states);
+
+  // Replace the tail from state 1500 on by a longer curve.
+  path<state_r2> replanned;
+  for (std::size_t i = 0; i < 1500; ++i) {
+    replanned.push_back(states[i]);
+  }
+  const double x0 = states[1499].x;
+  for (std::size_t i = 1; i <= 700; ++i) {
+    const double angle = static_cast<double>(i) * 0.01;
+    replanned.push_back({x0 + 10.0 * std::sin(angle), 10.0 * (1.0 - std::cos(angle))});
+  }
+  const std::size_t first = incremental.update(replanned, 1500);
+  // Only the braking distance before the curve changes.
+  EXPECT_GT(first, 1400U);
+  EXPECT_LT(first, 1500U);
+
+  velocity_profile full(limits);
+  full.compute(replanned);
+  ASSERT_EQ(incremental.size(), full.size());
+  for (std::size_t i = 0; i < full.size(); ++i) {
+    EXPECT_EQ(incremental.speeds()[i], full.speeds()[i]);
+    EXPECT_EQ(incremental.times()[i], full.times()[i]);
+  }
+
+  // Back to the shorter straight line.
+  static_cast<void>(incremental.update(states, 1500));
+  full.compute(states);
+  for (std::size_t i = 0; i < full.size(); ++i) {
+    EXPECT_EQ(incremental.speeds()[i], full.speeds()[i]);
+    EXPECT_EQ(incremental.times()[i], full.times()[i]);
+  }
+  EXPECT_THROW(static_cast<void>(incremental.update(states, 2001)), std::out_of_range);
+}
+
+} // namespace trailblaze
@@ -3,4 +3,5 @@ include(CMakeFindDependencyMacro)
 # You can add additional dependencies here that are needed by the consumer of our project.
 # See https://cmake.org/cmake/help/latest/module/CMakeFindDependencyMacro.html
 # find_dependency(Boost)
+find_dependency(Threads)
 include(${CMAKE_CURRENT_LIST_DIR}/trailblazeTargets.cmake)